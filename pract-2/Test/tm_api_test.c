@@ -0,0 +1,150 @@
+/*
+ * Prueba de la API C de la biblioteca (include/tm_api.h), escrita en C puro.
+ *
+ * Simula el mismo lote con cada motor que se elige al cargar (normal,
+ * optimizado, compacto, perezoso, con fusión de cadenas y desde memoria) y
+ * comprueba que todos dan el mismo veredicto, pasos y cintas; después prueba
+ * los errores (fichero inexistente, opciones incompatibles, cinta fuera de
+ * rango, operaciones nativas con el modelo compacto).
+ *
+ * Uso (desde pract-2/): make api-test && ./tm-api-test
+ * Devuelve 0 si todo coincide y 1 si alguna comprobación falla.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tm_api.h"
+
+#define MACHINE "Test/MT/BinaryReverse_2Tapes_MT.txt"
+#define BUILTIN_MACHINE "Test/MT/Palindrome_Builtin_2Tapes_MT.txt"
+#define MAX_STEPS 1000
+#define BATCH 8
+
+static const char* const inputs[BATCH] = {"0", "1", "10", "0110", "1010", "11100", "", "0101010101"};
+
+static int checks = 0;
+static int failures = 0;
+
+static void check(int ok, const char* what) {
+  checks++;
+  if (!ok) {
+    failures++;
+    printf("FALLO: %s (%s)\n", what, tm_last_error());
+  }
+}
+
+/* Resultado de referencia de una cadena (output copiado, porque el de tm_result caduca). */
+typedef struct {
+  int status;
+  long long steps;
+  char* output;
+  size_t output_size;
+} expected;
+
+static int simulate_batch(tm_machine* machine, tm_result* results) {
+  size_t sizes[BATCH];
+  size_t i;
+  for (i = 0; i < BATCH; ++i) sizes[i] = strlen(inputs[i]);
+  return tm_simulate_batch(machine, inputs, sizes, BATCH, MAX_STEPS, results);
+}
+
+static void compare(tm_machine* machine, const expected* reference, const char* engine) {
+  tm_result results[BATCH];
+  size_t i;
+  char what[128];
+  snprintf(what, sizeof what, "carga con %s", engine);
+  check(machine != NULL, what);
+  if (machine == NULL) return;
+  snprintf(what, sizeof what, "lote con %s", engine);
+  check(simulate_batch(machine, results) == 0, what);
+  for (i = 0; i < BATCH; ++i) {
+    snprintf(what, sizeof what, "cadena \"%s\" con %s", inputs[i], engine);
+    check(results[i].status == reference[i].status && results[i].steps == reference[i].steps &&
+          results[i].output_size == reference[i].output_size &&
+          memcmp(results[i].output, reference[i].output, reference[i].output_size) == 0, what);
+  }
+  tm_free(machine);
+}
+
+static char* read_file(const char* path, size_t* size) {
+  FILE* file = fopen(path, "rb");
+  char* text;
+  if (file == NULL) return NULL;
+  fseek(file, 0, SEEK_END);
+  *size = (size_t)ftell(file);
+  fseek(file, 0, SEEK_SET);
+  text = malloc(*size + 1);
+  if (fread(text, 1, *size, file) != *size) *size = 0;
+  fclose(file);
+  return text;
+}
+
+int main(void) {
+  expected reference[BATCH];
+  tm_result results[BATCH];
+  tm_result result;
+  tm_machine* machine;
+  size_t size = 0;
+  char* text;
+  int tapes[2] = {0, 1};
+  int missing = 7;
+  size_t i;
+
+  check(tm_api_version() == TM_API_VERSION, "versión de la API");
+
+  machine = tm_load_file(MACHINE, 0);
+  check(machine != NULL, "carga de " MACHINE);
+  if (machine == NULL) return 1;
+  check(tm_tape_count(machine) == 2, "número de cintas");
+  check(tm_set_output(machine, tapes, 2, "trim", 0) == 0, "tm_set_output con las cintas 0 y 1");
+  check(simulate_batch(machine, results) == 0, "lote de referencia");
+  for (i = 0; i < BATCH; ++i) {
+    reference[i].status = results[i].status;
+    reference[i].steps = results[i].steps;
+    reference[i].output_size = results[i].output_size;
+    reference[i].output = malloc(results[i].output_size + 1);
+    memcpy(reference[i].output, results[i].output, results[i].output_size);
+  }
+  check(reference[3].status == TM_ACCEPTED && reference[3].output_size > 0, "BinaryReverse acepta 0110");
+  check(tm_set_output(machine, &missing, 1, "full", 0) == -1, "tm_set_output rechaza una cinta que no existe");
+  check(tm_set_output(machine, NULL, 0, "full", 1) == 0 && tm_simulate(machine, "0110", 4, MAX_STEPS, &result) == 0 &&
+        result.output_size == 0 && result.steps == reference[3].steps, "solo veredicto");
+  check(tm_simulate(machine, "0110", 4, 3, &result) == 0 && result.status == TM_STEP_LIMIT, "límite de pasos");
+  tm_free(machine);
+
+  {
+    const unsigned engines[] = {TM_LOAD_OPTIMIZE, TM_LOAD_COMPACT, TM_LOAD_OPTIMIZE | TM_LOAD_COMPACT, TM_LOAD_LAZY,
+                                TM_LOAD_FUSE_CHAINS, TM_LOAD_OPTIMIZE | TM_LOAD_FUSE_CHAINS};
+    const char* const names[] = {"TM_LOAD_OPTIMIZE", "TM_LOAD_COMPACT", "TM_LOAD_OPTIMIZE | TM_LOAD_COMPACT",
+                                 "TM_LOAD_LAZY", "TM_LOAD_FUSE_CHAINS", "TM_LOAD_OPTIMIZE | TM_LOAD_FUSE_CHAINS"};
+    for (i = 0; i < sizeof engines / sizeof engines[0]; ++i) {
+      machine = tm_load_file(MACHINE, engines[i]);
+      if (machine != NULL) tm_set_output(machine, tapes, 2, "trim", 0);
+      compare(machine, reference, names[i]);
+    }
+  }
+
+  text = read_file(MACHINE, &size);
+  check(text != NULL && size > 0, "lectura de " MACHINE);
+  machine = tm_load_buffer(text, size, 0);
+  if (machine != NULL) tm_set_output(machine, tapes, 2, "trim", 0);
+  compare(machine, reference, "tm_load_buffer");
+  machine = tm_load_buffer(text, size, TM_LOAD_COMPACT | TM_LOAD_OPTIMIZE);
+  if (machine != NULL) tm_set_output(machine, tapes, 2, "trim", 0);
+  compare(machine, reference, "tm_load_buffer y TM_LOAD_COMPACT");
+  check(tm_load_buffer(text, size, TM_LOAD_LAZY) == NULL && strlen(tm_last_error()) > 0,
+        "TM_LOAD_LAZY necesita un fichero");
+  free(text);
+
+  check(tm_load_file("Test/MT/NoExiste_MT.txt", 0) == NULL && strlen(tm_last_error()) > 0, "fichero inexistente");
+  check(tm_load_file(MACHINE, TM_LOAD_LAZY | TM_LOAD_COMPACT) == NULL, "TM_LOAD_LAZY con TM_LOAD_COMPACT");
+  check(tm_load_file(BUILTIN_MACHINE, TM_LOAD_COMPACT) == NULL, "operaciones nativas con TM_LOAD_COMPACT");
+  machine = tm_load_file(BUILTIN_MACHINE, 0);
+  check(machine != NULL && tm_simulate(machine, "abba", 4, MAX_STEPS, &result) == 0 && result.status == TM_ACCEPTED,
+        "operaciones nativas con el motor normal");
+  tm_free(machine);
+
+  for (i = 0; i < BATCH; ++i) free(reference[i].output);
+  printf("API C: %d comprobaciones, %d fallos\n", checks, failures);
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,690 @@
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include "block_simulator.h"
+#include "chain_fusion.h"
+#include "compact_model.h"
+#include "compact_simulator.h"
+#include "execution.h"
+#include "file_parser.h"
+#include "machine_optimizer.h"
+#include "mapped_tape.h"
+#include "prefix_sharing.h"
+#include "result_projection.h"
+#include "stream_tape.h"
+#include "turing_machine_model.h"
+#include "turing_machine_simulator.h"
+
+/**
+ * Fuzzer diferencial entre los motores del simulador.
+ *
+ * Genera MT aleatorias bien formadas (número de estados, cintas, alfabetos y
+ * comodines variables) y cadenas aleatorias, y compara el simulador de
+ * referencia (TuringMachineSimulator::run) con:
+ * - CompactSimulator sobre CompactModel::fromModel (veredicto, pasos y cintas),
+ * - CompactSimulator sobre FileParser::parseCompactFile (veredicto, pasos y cintas),
+ * - el modelo de FileParser::parseLazyFile, que carga los estados al visitarlos
+ *   (veredicto, pasos, cintas y, tras cargarlo entero, huella),
+ * - computeOnMappedTape con la cadena en un fichero (veredicto, pasos y cinta 0),
+ * - runOnStream con la cadena en un fichero leído de 1 a 3 bytes por lectura y
+ *   cuantos de 1, 3 y sin límite (veredicto, pasos y cintas, completando la
+ *   cinta 0 con lo que quedó sin leer),
+ * - BlockSimulator con bloques de 1 a 4 celdas, en MT de una cinta (veredicto,
+ *   pasos y cinta),
+ * - Execution::step con cuantos de 1, 3 y 7 pasos (veredicto, pasos y cintas),
+ *   que comprueba que trocear la ejecución no cambia el resultado,
+ * - el simulador con ChainFusion, de corrido y por cuantos de 1, 3 y 7 pasos
+ *   (veredicto, pasos y cintas), que comprueba que las superinstrucciones
+ *   respetan el límite de pasos y el quantum,
+ * - el modelo optimizado por MachineOptimizer (solo veredicto),
+ * - la misma MT con los comodines expandidos a símbolos concretos (veredicto,
+ *   pasos y cintas), que comprueba la semántica de '*' del TransitionMatcher,
+ * - la misma MT con sus operaciones nativas expandidas a transiciones q -> q
+ *   concretas (veredicto, pasos y cintas), que comprueba que Builtin::run()
+ *   cuenta los mismos pasos que las transiciones a mano.
+ *
+ * Un tercio de las máquinas tienen operaciones nativas (@copy, @compare...);
+ * con ellas no se prueban los motores que no las admiten (compacto,
+ * --mmap-tape y bloques).
+ *
+ * Cada fallo se minimiza (quitando transiciones, estados y símbolos de la
+ * cadena mientras el mismo motor siga discrepando) y se guarda como un par de
+ * ficheros al estilo de Test/MT y Test/Strings.
+ *
+ * Uso: fuzz-engines [iteraciones] [semilla] [directorio_salida]
+ */
+
+namespace {
+
+const long long kMaxSteps = 200;
+const char kMoves[] = {'L', 'R', 'S'};
+
+struct FuzzTransition {
+  int from;
+  int to;
+  std::string read;
+  std::string write;
+  std::string moves;
+};
+
+struct FuzzBuiltin {
+  int state;
+  std::string name;
+  int first;
+  int second;
+  std::string moves;
+};
+
+struct FuzzMachine {
+  int stateCount;
+  int tapeCount;
+  std::string inputAlphabet;
+  std::string tapeAlphabet;
+  std::vector<bool> accept;
+  std::vector<FuzzTransition> transitions;
+  std::vector<FuzzBuiltin> builtins;
+};
+
+struct Failure {
+  std::string engine;
+  std::string detail;
+  bool failed() const { return !engine.empty(); }
+};
+
+/**
+ * @brief Resultado de una ejecución: motivo de parada, pasos y cintas finales.
+ */
+struct Outcome {
+  RunStatus status;
+  long long steps;
+  std::string tapes;
+};
+
+std::string statusName(RunStatus status) {
+  switch (status) {
+    case RunStatus::ACCEPTED: return "ACEPTADA";
+    case RunStatus::REJECTED: return "RECHAZADA";
+    case RunStatus::STEP_LIMIT: return "LIMITE_PASOS";
+    case RunStatus::SUSPENDED: return "SUSPENDIDA";
+    default: return "EN_CURSO";
+  }
+}
+
+std::string describe(const Outcome& outcome) {
+  std::ostringstream os;
+  os << statusName(outcome.status) << ", " << outcome.steps << " pasos, cintas [" << outcome.tapes << "]";
+  return os.str();
+}
+
+/**
+ * @brief Escribe la MT en el formato de fichero de Test/MT.
+ */
+std::string toText(const FuzzMachine& machine, const std::string& header) {
+  std::ostringstream os;
+  os << header;
+  os << "# Estados\n";
+  for (int s = 0; s < machine.stateCount; ++s) os << (s ? " " : "") << "q" << s;
+  os << "\n\n# Alfabeto de entrada\n";
+  for (size_t i = 0; i < machine.inputAlphabet.size(); ++i) os << (i ? " " : "") << machine.inputAlphabet[i];
+  os << "\n\n# Alfabeto de cinta\n";
+  for (size_t i = 0; i < machine.tapeAlphabet.size(); ++i) os << (i ? " " : "") << machine.tapeAlphabet[i];
+  os << "\n\n# Estado inicial\nq0\n\n# Símbolo blanco\n.\n\n# Estados de aceptación\n";
+  bool first = true;
+  for (int s = 0; s < machine.stateCount; ++s) {
+    if (!machine.accept[s]) continue;
+    os << (first ? "" : " ") << "q" << s;
+    first = false;
+  }
+  os << "\n\n# Transiciones\n";
+  for (const auto& builtin : machine.builtins) {
+    os << "q" << builtin.state << " " << builtin.name << " " << builtin.first;
+    if (builtin.second >= 0) os << " " << builtin.second;
+    for (char move : builtin.moves) os << " " << move;
+    os << "\n";
+  }
+  for (const auto& tr : machine.transitions) {
+    os << "q" << tr.from << " " << tr.read[0] << " q" << tr.to << " " << tr.write[0] << " " << tr.moves[0];
+    for (int t = 1; t < machine.tapeCount; ++t) os << " " << tr.read[t] << " " << tr.write[t] << " " << tr.moves[t];
+    os << "\n";
+  }
+  return os.str();
+}
+
+void writeFile(const std::string& path, const std::string& content) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out << content;
+}
+
+std::string readFile(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  std::ostringstream os;
+  os << in.rdbuf();
+  return os.str();
+}
+
+bool hasWildcards(const FuzzMachine& machine) {
+  for (const auto& tr : machine.transitions) {
+    if (tr.read.find(Symbol::WILDCARD) != std::string::npos) return true;
+    if (tr.write.find(Symbol::WILDCARD) != std::string::npos) return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Genera una MT aleatoria bien formada.
+ *
+ * La mitad de las máquinas usan comodines en lectura y escritura. Un tercio
+ * tienen operaciones nativas en algunos estados (y el '0' y el '1' en el
+ * alfabeto de cinta, que son lo que lee y escribe @increment).
+ */
+FuzzMachine randomMachine(std::mt19937& rng) {
+  auto pick = [&rng](int n) { return (int)(rng() % n); };
+  FuzzMachine machine;
+  machine.stateCount = 1 + pick(6);
+  machine.tapeCount = 1 + pick(3);
+  machine.inputAlphabet = std::string("abc").substr(0, 1 + pick(3));
+  machine.tapeAlphabet = machine.inputAlphabet + std::string("xy").substr(0, pick(3)) + ".";
+  bool builtins = pick(3) == 0;
+  if (builtins) machine.tapeAlphabet.insert(machine.tapeAlphabet.size() - 1, "01");
+  machine.accept.assign(machine.stateCount, false);
+  machine.accept[pick(machine.stateCount)] = true;
+  if (machine.stateCount > 2 && pick(3) == 0) machine.accept[pick(machine.stateCount)] = true;
+  bool wildcards = pick(2) == 0;
+  const std::string& symbols = machine.tapeAlphabet;
+  for (int s = 0; s < machine.stateCount; ++s) {
+    if (machine.accept[s] && pick(4) != 0) continue;
+    int count = pick(2 + machine.tapeCount * (int)symbols.size());
+    for (int i = 0; i < count; ++i) {
+      FuzzTransition tr;
+      tr.from = s;
+      tr.to = pick(machine.stateCount);
+      for (int t = 0; t < machine.tapeCount; ++t) {
+        tr.read += (wildcards && pick(5) == 0) ? Symbol::WILDCARD : symbols[pick(symbols.size())];
+        tr.write += (wildcards && pick(6) == 0) ? Symbol::WILDCARD : symbols[pick(symbols.size())];
+        tr.moves += kMoves[pick(3)];
+      }
+      machine.transitions.push_back(tr);
+    }
+  }
+  for (int s = 0; builtins && s < machine.stateCount; ++s) {
+    if (machine.accept[s] || pick(2) != 0) continue;
+    static const char* kTwoTapes[] = {"@copy", "@reverse", "@move", "@compare"};
+    FuzzBuiltin builtin;
+    builtin.state = s;
+    builtin.first = pick(machine.tapeCount);
+    builtin.second = -1;
+    if (machine.tapeCount > 1 && pick(3) != 0) {
+      builtin.name = kTwoTapes[pick(4)];
+      builtin.second = (builtin.first + 1 + pick(machine.tapeCount - 1)) % machine.tapeCount;
+    } else {
+      builtin.name = pick(2) == 0 ? "@rewind" : "@increment";
+    }
+    if (builtin.name == "@compare") {
+      do {
+        builtin.moves = std::string(1, kMoves[pick(3)]) + kMoves[pick(3)];
+      } while (builtin.moves == "SS");
+    } else if (builtin.name == "@copy" || builtin.name == "@move") {
+      builtin.moves = std::string(1, kMoves[pick(2)]) + kMoves[pick(3)];
+    } else if (builtin.name == "@rewind") {
+      builtin.moves = std::string(1, kMoves[pick(2)]);
+    }
+    machine.builtins.push_back(builtin);
+  }
+  return machine;
+}
+
+std::string randomInput(std::mt19937& rng, const FuzzMachine& machine) {
+  int length = rng() % 9;
+  std::string input;
+  for (int i = 0; i < length; ++i) input += machine.inputAlphabet[rng() % machine.inputAlphabet.size()];
+  return input;
+}
+
+/**
+ * @brief Expande los comodines a transiciones concretas.
+ *
+ * Para cada estado y cada combinación de símbolos leídos elige la transición
+ * más específica (cinta a cinta, un símbolo concreto gana al comodín; a
+ * igualdad, la primera del fichero) y la reescribe sin '*': en escritura, el
+ * comodín pasa a ser el símbolo leído. Es una implementación independiente de
+ * la semántica documentada, para contrastarla con el TransitionMatcher.
+ */
+FuzzMachine expandWildcards(const FuzzMachine& machine) {
+  FuzzMachine expanded = machine;
+  expanded.transitions.clear();
+  const std::string& symbols = machine.tapeAlphabet;
+  int combinations = 1;
+  for (int t = 0; t < machine.tapeCount; ++t) combinations *= symbols.size();
+  for (int s = 0; s < machine.stateCount; ++s) {
+    for (int c = 0; c < combinations; ++c) {
+      std::string read;
+      for (int t = 0, rest = c; t < machine.tapeCount; ++t, rest /= symbols.size()) read += symbols[rest % symbols.size()];
+      const FuzzTransition* best = nullptr;
+      for (const auto& tr : machine.transitions) {
+        if (tr.from != s) continue;
+        bool matches = true;
+        for (int t = 0; t < machine.tapeCount; ++t) {
+          if (tr.read[t] != read[t] && tr.read[t] != Symbol::WILDCARD) matches = false;
+        }
+        if (!matches) continue;
+        bool better = best == nullptr;
+        for (int t = 0; !better && t < machine.tapeCount; ++t) {
+          bool wildBest = best->read[t] == Symbol::WILDCARD;
+          bool wildThis = tr.read[t] == Symbol::WILDCARD;
+          if (wildBest != wildThis) {
+            better = wildBest;
+            break;
+          }
+        }
+        if (better) best = &tr;
+      }
+      if (best == nullptr) continue;
+      FuzzTransition concrete = *best;
+      concrete.read = read;
+      for (int t = 0; t < machine.tapeCount; ++t) {
+        if (concrete.write[t] == Symbol::WILDCARD) concrete.write[t] = read[t];
+      }
+      expanded.transitions.push_back(concrete);
+    }
+  }
+  return expanded;
+}
+
+/**
+ * @brief Expande las operaciones nativas a transiciones concretas.
+ *
+ * Por cada estado con operación nativa y cada combinación de símbolos del
+ * alfabeto de cinta que cumple su condición, añade al principio una
+ * transición q -> q sin comodines que hace una iteración; al ser concretas y
+ * estar antes, ganan a las demás transiciones del estado. Es una
+ * implementación independiente de la semántica documentada en Builtin.
+ */
+FuzzMachine expandBuiltins(const FuzzMachine& machine) {
+  FuzzMachine expanded = machine;
+  expanded.builtins.clear();
+  expanded.transitions.clear();
+  if (machine.transitions.empty()) {
+    expanded.tapeCount = 1;
+    for (const auto& builtin : machine.builtins) {
+      expanded.tapeCount = std::max(expanded.tapeCount, std::max(builtin.first, builtin.second) + 1);
+    }
+  }
+  const std::string& symbols = machine.tapeAlphabet;
+  int combinations = 1;
+  for (int t = 0; t < expanded.tapeCount; ++t) combinations *= symbols.size();
+  for (const auto& builtin : machine.builtins) {
+    bool reverse = builtin.name == "@reverse";
+    char firstMove = reverse ? 'L' : (builtin.name == "@increment" ? 'L' : builtin.moves[0]);
+    char secondMove = reverse ? 'R' : (builtin.moves.size() > 1 ? builtin.moves[1] : 'S');
+    for (int c = 0; c < combinations; ++c) {
+      FuzzTransition tr;
+      tr.from = tr.to = builtin.state;
+      for (int t = 0, rest = c; t < expanded.tapeCount; ++t, rest /= symbols.size()) tr.read += symbols[rest % symbols.size()];
+      char symbol = tr.read[builtin.first];
+      if (symbol == '.') continue;
+      if (builtin.name == "@increment" && symbol != '1') continue;
+      if (builtin.name == "@compare" && tr.read[builtin.second] != symbol) continue;
+      tr.write = tr.read;
+      tr.moves = std::string(expanded.tapeCount, 'S');
+      tr.moves[builtin.first] = firstMove;
+      if (builtin.name == "@increment") tr.write[builtin.first] = '0';
+      if (builtin.name == "@move") tr.write[builtin.first] = '.';
+      if (builtin.second >= 0) {
+        tr.moves[builtin.second] = secondMove;
+        if (builtin.name != "@compare") tr.write[builtin.second] = symbol;
+      }
+      expanded.transitions.push_back(tr);
+    }
+  }
+  expanded.transitions.insert(expanded.transitions.end(), machine.transitions.begin(), machine.transitions.end());
+  return expanded;
+}
+
+/**
+ * @brief Proyecta todas las cintas de la configuración en modo completo.
+ */
+std::string allTapes(const ResultProjection& projection, const Configuration& configuration) {
+  std::string out;
+  projection.write(out, configuration);
+  return out;
+}
+
+ResultProjection projectionFor(int tapeCount) {
+  std::vector<int> tapes;
+  for (int t = 0; t < tapeCount; ++t) tapes.push_back(t);
+  return ResultProjection(tapes, ResultProjection::Mode::FULL, false);
+}
+
+Outcome runReference(const TuringMachineModel& model, const std::string& input,
+                     const ChainFusion* fusion = nullptr) {
+  TuringMachineSimulator simulator(model);
+  simulator.setMaxSteps(kMaxSteps);
+  simulator.setChainFusion(fusion);
+  std::vector<Symbol> symbols;
+  for (char c : input) symbols.push_back(Symbol(c));
+  Configuration configuration = simulator.start(String(symbols));
+  std::ostringstream unused;
+  Outcome outcome;
+  outcome.status = simulator.run(configuration, false, unused);
+  outcome.steps = configuration.getSteps();
+  outcome.tapes = allTapes(projectionFor(configuration.getTapes().size()), configuration);
+  return outcome;
+}
+
+Outcome runCompact(const CompactModel& model, const std::string& input) {
+  CompactSimulator simulator(model);
+  simulator.setMaxSteps(kMaxSteps);
+  std::vector<Symbol> symbols;
+  for (char c : input) symbols.push_back(Symbol(c));
+  Outcome outcome;
+  outcome.status = simulator.compute(String(symbols), outcome.steps, projectionFor(model.getTapeCount()), outcome.tapes);
+  return outcome;
+}
+
+Failure compare(const std::string& engine, const Outcome& expected, const Outcome& actual, bool tape0Only) {
+  Failure failure;
+  std::string expectedTapes = tape0Only ? expected.tapes.substr(0, expected.tapes.find(" | ")) : expected.tapes;
+  if (expected.status != actual.status || expected.steps != actual.steps || expectedTapes != actual.tapes) {
+    Outcome shown = expected;
+    shown.tapes = expectedTapes;
+    failure.engine = engine;
+    failure.detail = "referencia: " + describe(shown) + "; " + engine + ": " + describe(actual);
+  }
+  return failure;
+}
+
+/**
+ * @brief Ejecuta una MT y una cadena en todos los motores y devuelve la primera discrepancia.
+ */
+Failure check(const FuzzMachine& machine, const std::string& input, const std::string& workDir) {
+  Failure failure;
+  const std::string mtPath = workDir + "/.fuzz_mt.txt";
+  const std::string tapePath = workDir + "/.fuzz_tape.txt";
+  const std::string tapeOutPath = workDir + "/.fuzz_tape_out.txt";
+  std::string stage = "referencia";
+  try {
+    FileParser parser;
+    writeFile(mtPath, toText(machine, ""));
+    TuringMachineModel model = parser.parseFile(mtPath);
+    Outcome reference = runReference(model, input);
+
+    bool builtins = !machine.builtins.empty();
+    if (!builtins) {
+      stage = "compact";
+      failure = compare(stage, reference, runCompact(CompactModel::fromModel(model), input), false);
+      if (failure.failed()) return failure;
+
+      stage = "compact-stream";
+      failure = compare(stage, reference, runCompact(parser.parseCompactFile(mtPath), input), false);
+      if (failure.failed()) return failure;
+    }
+
+    stage = "lazy";
+    {
+      TuringMachineModel lazy = parser.parseLazyFile(mtPath);
+      failure = compare(stage, reference, runReference(lazy, input), false);
+      if (failure.failed()) return failure;
+      if (lazy.fingerprint() != model.fingerprint()) {
+        failure.engine = stage;
+        failure.detail = "la huella del modelo cargado entero no coincide con la de referencia";
+        return failure;
+      }
+    }
+
+    writeFile(tapePath, input);
+    if (!builtins) {
+      stage = "mmap-tape";
+      Outcome mapped;
+      {
+        MappedTape tape0(tapePath);
+        TuringMachineSimulator simulator(model);
+        simulator.setMaxSteps(kMaxSteps);
+        mapped.status = simulator.computeOnMappedTape(tape0, mapped.steps);
+        tape0.writeTo(tapeOutPath);
+      }
+      mapped.tapes = readFile(tapeOutPath);
+      if (!mapped.tapes.empty() && mapped.tapes.back() == '\n') mapped.tapes.pop_back();
+      failure = compare(stage, reference, mapped, true);
+      if (failure.failed()) return failure;
+    }
+
+    if (model.determineTapeCount() == 1 && !builtins) {
+      stage = "block";
+      for (int k = 1; k <= 4; ++k) {
+        BlockSimulator blocks(model, k);
+        blocks.setMaxSteps(kMaxSteps);
+        Configuration configuration;
+        Outcome outcome;
+        outcome.status = blocks.run(String(std::vector<Symbol>(input.begin(), input.end())), configuration);
+        outcome.steps = configuration.getSteps();
+        outcome.tapes = allTapes(projectionFor(1), configuration);
+        failure = compare(stage + " k=" + std::to_string(k), reference, outcome, false);
+        if (failure.failed()) return failure;
+      }
+    }
+
+    stage = "stream";
+    for (size_t chunk = 1; chunk <= 3; ++chunk) {
+      for (long long quantum : {1LL, 3LL, 1LL << 40}) {
+        StreamTape tape0(tapePath, false, chunk);
+        TuringMachineSimulator simulator(model);
+        simulator.setMaxSteps(kMaxSteps);
+        Configuration configuration = simulator.start(std::vector<Symbol>());
+        Outcome outcome;
+        do {
+          outcome.status = simulator.runOnStream(configuration, tape0, quantum, quantum > 3);
+        } while (outcome.status == RunStatus::RUNNING);
+        outcome.steps = configuration.getSteps();
+        std::string unread = input.substr(tape0.getReceived());
+        std::vector<Symbol>& tape = configuration.getTapes()[0];
+        if (tape0.isPending() && !unread.empty()) tape.pop_back();
+        tape.insert(tape.end(), unread.begin(), unread.end());
+        outcome.tapes = allTapes(projectionFor(configuration.getTapes().size()), configuration);
+        failure = compare(stage + " bloque=" + std::to_string(chunk) + " q=" + std::to_string(quantum),
+                          reference, outcome, false);
+        if (failure.failed()) return failure;
+      }
+    }
+
+    stage = "step";
+    for (long long quantum : {1LL, 3LL, 7LL}) {
+      TuringMachineSimulator simulator(model);
+      simulator.setMaxSteps(kMaxSteps);
+      Execution execution(simulator, 0, input, String(std::vector<Symbol>(input.begin(), input.end())));
+      while (!execution.isFinished()) execution.step(quantum);
+      Outcome outcome;
+      outcome.status = execution.getStatus();
+      outcome.steps = execution.getSteps();
+      outcome.tapes = allTapes(projectionFor(execution.getResult().getTapes().size()), execution.getResult());
+      failure = compare(stage + " q=" + std::to_string(quantum), reference, outcome, false);
+      if (failure.failed()) return failure;
+    }
+
+    stage = "fuse";
+    ChainFusion fusion(model);
+    failure = compare(stage, reference, runReference(model, input, &fusion), false);
+    if (failure.failed()) return failure;
+    for (long long quantum : {1LL, 3LL, 7LL}) {
+      TuringMachineSimulator simulator(model);
+      simulator.setMaxSteps(kMaxSteps);
+      simulator.setChainFusion(&fusion);
+      Execution execution(simulator, 0, input, String(std::vector<Symbol>(input.begin(), input.end())));
+      while (!execution.isFinished()) execution.step(quantum);
+      Outcome outcome;
+      outcome.status = execution.getStatus();
+      outcome.steps = execution.getSteps();
+      outcome.tapes = allTapes(projectionFor(execution.getResult().getTapes().size()), execution.getResult());
+      failure = compare(stage + " q=" + std::to_string(quantum), reference, outcome, false);
+      if (failure.failed()) return failure;
+    }
+
+    stage = "prefix";
+    {
+      std::vector<std::string> batch;
+      for (size_t n = 0; n <= input.size(); ++n) batch.push_back(input.substr(0, n));
+      for (char c : machine.inputAlphabet) batch.push_back(input + c);
+      batch.push_back(input);
+      TuringMachineSimulator simulator(model);
+      simulator.setMaxSteps(kMaxSteps);
+      PrefixSharing sharing(simulator);
+      for (size_t i = 0; i < batch.size(); ++i) sharing.add(i, std::vector<Symbol>(batch[i].begin(), batch[i].end()));
+      std::vector<Outcome> shared(batch.size());
+      sharing.run([&](uint64_t index, RunStatus status, const Configuration& configuration) {
+        shared[index].status = status;
+        shared[index].steps = configuration.getSteps();
+        shared[index].tapes = allTapes(projectionFor(configuration.getTapes().size()), configuration);
+      });
+      for (size_t i = 0; i < batch.size(); ++i) {
+        failure = compare(stage, runReference(model, batch[i]), shared[i], false);
+        if (failure.failed()) {
+          failure.detail = "cadena \"" + batch[i] + "\": " + failure.detail;
+          return failure;
+        }
+      }
+    }
+
+    stage = "optimize";
+    MachineOptimizer optimizer;
+    TuringMachineModel optimized = optimizer.optimize(model);
+    Outcome verdict = runReference(optimized, input);
+    if ((verdict.status == RunStatus::ACCEPTED) != (reference.status == RunStatus::ACCEPTED)) {
+      failure.engine = stage;
+      failure.detail = "referencia: " + statusName(reference.status) + "; optimize: " + statusName(verdict.status);
+      return failure;
+    }
+
+    if (hasWildcards(machine)) {
+      stage = "wildcard";
+      writeFile(mtPath, toText(expandWildcards(machine), ""));
+      TuringMachineModel expanded = parser.parseFile(mtPath);
+      failure = compare(stage, runReference(expanded, input), reference, false);
+      if (failure.failed()) return failure;
+    }
+
+    if (builtins) {
+      stage = "builtin";
+      writeFile(mtPath, toText(expandBuiltins(machine), ""));
+      TuringMachineModel expanded = parser.parseFile(mtPath);
+      failure = compare(stage, runReference(expanded, input), reference, false);
+      if (failure.failed()) return failure;
+    }
+  } catch (const std::exception& error) {
+    failure.engine = stage;
+    failure.detail = std::string("excepción: ") + error.what();
+  }
+  return failure;
+}
+
+/**
+ * @brief Reduce un caso fallido mientras el mismo motor siga discrepando.
+ *
+ * Prueba a quitar transiciones, operaciones nativas, estados (con sus
+ * transiciones, sin tocar el inicial ni dejar la MT sin estados de aceptación)
+ * y símbolos de la cadena, hasta que ninguna reducción mantenga el fallo.
+ */
+void minimize(FuzzMachine& machine, std::string& input, Failure& failure, const std::string& workDir) {
+  bool progress = true;
+  while (progress) {
+    progress = false;
+    for (size_t i = 0; i < machine.transitions.size(); ++i) {
+      FuzzMachine candidate = machine;
+      candidate.transitions.erase(candidate.transitions.begin() + i);
+      Failure result = check(candidate, input, workDir);
+      if (result.engine == failure.engine) {
+        machine = candidate;
+        failure = result;
+        progress = true;
+        --i;
+      }
+    }
+    for (size_t i = 0; i < machine.builtins.size(); ++i) {
+      FuzzMachine candidate = machine;
+      candidate.builtins.erase(candidate.builtins.begin() + i);
+      Failure result = check(candidate, input, workDir);
+      if (result.engine == failure.engine) {
+        machine = candidate;
+        failure = result;
+        progress = true;
+        --i;
+      }
+    }
+    for (int s = machine.stateCount - 1; s > 0; --s) {
+      FuzzMachine candidate = machine;
+      candidate.accept.erase(candidate.accept.begin() + s);
+      if (std::find(candidate.accept.begin(), candidate.accept.end(), true) == candidate.accept.end()) continue;
+      candidate.stateCount--;
+      candidate.transitions.clear();
+      for (FuzzTransition tr : machine.transitions) {
+        if (tr.from == s || tr.to == s) continue;
+        if (tr.from > s) tr.from--;
+        if (tr.to > s) tr.to--;
+        candidate.transitions.push_back(tr);
+      }
+      candidate.builtins.clear();
+      for (FuzzBuiltin builtin : machine.builtins) {
+        if (builtin.state == s) continue;
+        if (builtin.state > s) builtin.state--;
+        candidate.builtins.push_back(builtin);
+      }
+      Failure result = check(candidate, input, workDir);
+      if (result.engine == failure.engine) {
+        machine = candidate;
+        failure = result;
+        progress = true;
+      }
+    }
+    for (size_t i = 0; i < input.size(); ++i) {
+      std::string candidate = input;
+      candidate.erase(i, 1);
+      Failure result = check(machine, candidate, workDir);
+      if (result.engine == failure.engine) {
+        input = candidate;
+        failure = result;
+        progress = true;
+        --i;
+      }
+    }
+  }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  long iterations = argc > 1 ? std::atol(argv[1]) : 1000;
+  unsigned seed = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : std::random_device()();
+  std::string outDir = argc > 3 ? argv[3] : "Test/Fuzz";
+  ::mkdir(outDir.c_str(), 0755);
+  std::mt19937 rng(seed);
+  std::cout << "Fuzzing diferencial: " << iterations << " iteraciones, semilla " << seed << "\n";
+  int failures = 0;
+  for (long i = 0; i < iterations; ++i) {
+    FuzzMachine machine = randomMachine(rng);
+    for (int j = 0; j < 4; ++j) {
+      std::string input = randomInput(rng, machine);
+      Failure failure = check(machine, input, outDir);
+      if (!failure.failed()) continue;
+      minimize(machine, input, failure, outDir);
+      std::string base = outDir + "/Fuzz_" + std::to_string(seed) + "_" + std::to_string(i);
+      std::string header =
+        "# Caso mínimo generado por fuzz-engines (semilla " + std::to_string(seed) + ", iteración " +
+        std::to_string(i) + ")\n# Motor: " + failure.engine + "\n# " + failure.detail + "\n" +
+        "# Cadena: \"" + input + "\" (reproducir con --max-steps " + std::to_string(kMaxSteps) + ")\n\n";
+      writeFile(base + "_MT.txt", toText(machine, header));
+      writeFile(base + "_strings.txt", input + "\n");
+      std::cout << "FALLO [" << failure.engine << "] " << failure.detail << "\n  -> " << base << "_MT.txt\n";
+      failures++;
+      break;
+    }
+  }
+  std::remove((outDir + "/.fuzz_mt.txt").c_str());
+  std::remove((outDir + "/.fuzz_tape.txt").c_str());
+  std::remove((outDir + "/.fuzz_tape_out.txt").c_str());
+  std::cout << (failures == 0 ? "Sin discrepancias" : std::to_string(failures) + " discrepancias") << "\n";
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,67 @@
+#ifndef TM_API_H
+#define TM_API_H
+
+/*
+ * API C estable de la biblioteca del simulador (libtm.a / libtm.so).
+ *
+ * Permite cargar una MT desde un fichero o desde memoria, simular cadenas (una
+ * a una o por lotes) con un límite de pasos y recuperar el resultado de forma
+ * estructurada, sin lanzar procesos ni pasar por FileOut.txt. Las funciones
+ * devuelven 0 (o un puntero no nulo) si todo fue bien y -1 (o NULL) si no; en
+ * ese caso tm_last_error() describe el error del hilo llamante.
+ *
+ * Un tm_machine no es seguro para usarse desde varios hilos a la vez; para
+ * simular en paralelo basta con cargar un tm_machine por hilo.
+ */
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TM_API_VERSION 2
+
+/* Opciones de carga (se combinan con |); eligen el motor con el que se simula. */
+#define TM_LOAD_OPTIMIZE 1u      /* MachineOptimizer antes de simular */
+#define TM_LOAD_COMPACT 2u       /* modelo compacto (arena), para MT enormes; sin operaciones nativas */
+#define TM_LOAD_LAZY 4u          /* transiciones parseadas al visitar cada estado; solo tm_load_file */
+#define TM_LOAD_FUSE_CHAINS 8u   /* cadenas deterministas de transiciones aplicadas de golpe */
+
+typedef struct tm_machine tm_machine;
+
+typedef enum {
+  TM_ACCEPTED = 0,
+  TM_REJECTED = 1,
+  TM_STEP_LIMIT = 2
+} tm_status;
+
+typedef struct {
+  int status;          /* tm_status */
+  long long steps;     /* transiciones aplicadas */
+  const char* output;  /* cintas proyectadas (sin '\0' final garantizado); válido hasta la
+                          siguiente simulación o tm_free sobre el mismo tm_machine */
+  size_t output_size;
+} tm_result;
+
+int tm_api_version(void);
+const char* tm_last_error(void);
+
+tm_machine* tm_load_file(const char* path, unsigned flags);
+tm_machine* tm_load_buffer(const char* text, size_t size, unsigned flags);
+void tm_free(tm_machine* machine);
+int tm_tape_count(const tm_machine* machine);
+
+/* Cintas y modo ("full", "trim" o "span") de output; con verdict_only no se extrae ninguna. */
+int tm_set_output(tm_machine* machine, const int* tapes, size_t tape_count, const char* mode, int verdict_only);
+
+/* max_steps <= 0 usa el límite por defecto del simulador (50). */
+int tm_simulate(tm_machine* machine, const char* input, size_t size, long long max_steps, tm_result* result);
+int tm_simulate_batch(tm_machine* machine, const char* const* inputs, const size_t* sizes, size_t count,
+                      long long max_steps, tm_result* results);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,5 @@
+#include "alloc_counter.h"
+
+std::atomic<uint64_t> AllocCounter::allocations_(0);
+std::atomic<uint64_t> AllocCounter::bytes_(0);
+bool AllocCounter::installed_ = false;
@@ -0,0 +1,33 @@
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Contador global de reservas de memoria dinámica.
+ *
+ * Los contadores viven en la biblioteca, pero solo se incrementan si el
+ * programa enlaza alloc_hooks.cc, que sustituye el operator new global (lo
+ * hace pract-02; los clientes de libtm no ven su operator new alterado).
+ * isInstalled() indica si los ganchos están activos, para no publicar ceros
+ * como si fueran medidas.
+ */
+class AllocCounter {
+ public:
+  static void onAllocate(size_t bytes) {
+    allocations_.fetch_add(1, std::memory_order_relaxed);
+    bytes_.fetch_add(bytes, std::memory_order_relaxed);
+  }
+  static uint64_t getAllocations() { return allocations_.load(std::memory_order_relaxed); }
+  static uint64_t getBytes() { return bytes_.load(std::memory_order_relaxed); }
+  static void install() { installed_ = true; }
+  static bool isInstalled() { return installed_; }
+ private:
+  static std::atomic<uint64_t> allocations_;
+  static std::atomic<uint64_t> bytes_;
+  static bool installed_;
+};
+
+#endif
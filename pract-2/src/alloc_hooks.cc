@@ -0,0 +1,35 @@
+#include <cstdlib>
+#include <new>
+#include "alloc_counter.h"
+
+/*
+ * Sustitución del operator new/delete global que cuenta las reservas en
+ * AllocCounter. Solo se enlaza en el ejecutable (no forma parte de libtm).
+ */
+
+namespace {
+
+const bool kInstalled = (AllocCounter::install(), true);
+
+void* allocate(size_t size) {
+  AllocCounter::onAllocate(size);
+  void* memory = std::malloc(size == 0 ? 1 : size);
+  if (memory == nullptr) throw std::bad_alloc();
+  return memory;
+}
+
+void* allocateNoThrow(size_t size) noexcept {
+  AllocCounter::onAllocate(size);
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+}  // namespace
+
+void* operator new(size_t size) { return allocate(size); }
+void* operator new[](size_t size) { return allocate(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return allocateNoThrow(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return allocateNoThrow(size); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
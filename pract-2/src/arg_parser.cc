@@ -1,22 +1,327 @@
 #include "arg_parser.h"
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include "busy_beaver.h"
+#include "turing_machine_simulator.h"
 
 /**
  * @brief Constructor que parsea los argumentos de línea de comandos.
  * 
- * Extrae el nombre del fichero de la MT, el fichero de cadenas y los flags de traza e info.
- * El formato esperado es: programa <fichero_MT> <fichero_cadenas> [--trace] [--info]
+ * Extrae el nombre del fichero de la MT, el fichero de cadenas, los flags de traza e info
+ * y las opciones con valor (límite de pasos, instantáneas, salida, telemetría y filtros
+ * de traza). Cualquier opción --trace-* activa también la traza y --model-cache implica
+ * --compact.
+ * El formato esperado es: programa <fichero_MT> <fichero_cadenas> [opciones]; con
+ * --census el fichero de cadenas no hace falta (programa <fichero_MT> --census <n> ...), y
+ * con --busy-beaver tampoco la MT (programa --busy-beaver <n> [--bb-symbols <k>] ...).
  * 
  * @param argc Número de argumentos de línea de comandos.
  * @param argv Array de argumentos de línea de comandos.
  */
 Args::Args(int argc, char* argv[]) 
   : mtFile_(argv[1]), 
-    stringsFile_(argv[2]), 
+    stringsFile_(std::string(argv[2]).compare(0, 2, "--") == 0 ? "" : argv[2]), 
     trace_(false),
-    info_(false) {
-  for (int i = 3; i < argc; ++i) {
+    info_(false),
+    optimize_(false),
+    fuseChains_(false),
+    prefixSharing_(false),
+    lazyLoad_(false),
+    streamTape_(false),
+    streamFollow_(false),
+    compact_(false),
+    mappedTape_(false),
+    tapeOutFile_("TapeOut.txt"),
+    maxSteps_(TuringMachineSimulator::DEFAULT_MAX_STEPS),
+    checkpointSteps_(0),
+    checkpointSeconds_(0),
+    outputTapes_(1, 0),
+    outputMode_("full"),
+    verdictOnly_(false),
+    telemetry_(true),
+    perfCounters_(false),
+    metricsFile_("metrics.prom"),
+    progressSeconds_(10),
+    blockSize_(0),
+    quantum_(10000),
+    inFlight_(64),
+    census_(-1),
+    censusSamples_(3),
+    threads_(0),
+    busyBeaver_(0),
+    busyBeaverSymbols_(2) {
+  bool maxStepsGiven = false;
+  bool symbolsGiven = false;
+  bool busyBeaverGiven = false;
+  int first = stringsFile_.empty() ? 2 : 3;
+  if (mtFile_ == "--busy-beaver") {
+    busyBeaver_ = std::atoi(argv[2]);
+    busyBeaverGiven = true;
+    mtFile_.clear();
+    stringsFile_.clear();
+    first = 3;
+  }
+  std::string traceSteps, traceStates, traceWrites, traceStrings;
+  long long traceSample = 1;
+  std::string shardSpec, shardBy = "line";
+  for (int i = first; i < argc; ++i) {
     std::string arg = argv[i];
+    if (busyBeaverGiven && arg != "--bb-symbols" && arg != "--max-steps" && arg != "--threads") {
+      std::cerr << "--busy-beaver solo admite --bb-symbols, --max-steps y --threads.\n";
+      exit(EXIT_FAILURE);
+    }
     if (arg == "--trace") trace_ = true;
     else if (arg == "--info") info_ = true;
+    else if (arg == "--optimize") optimize_ = true;
+    else if (arg == "--fuse-chains") fuseChains_ = true;
+    else if (arg == "--prefix-sharing") prefixSharing_ = true;
+    else if (arg == "--lazy-load") lazyLoad_ = true;
+    else if (arg == "--stream-tape") streamTape_ = true;
+    else if (arg == "--stream-follow") streamFollow_ = true;
+    else if (arg == "--compact") compact_ = true;
+    else if (arg == "--mmap-tape") mappedTape_ = true;
+    else if (arg == "--tape-out") tapeOutFile_ = requireValue(argc, argv, i);
+    else if (arg == "--max-steps") {
+      maxSteps_ = std::atoll(requireValue(argc, argv, i).c_str());
+      maxStepsGiven = true;
+    }
+    else if (arg == "--checkpoint") checkpointFile_ = requireValue(argc, argv, i);
+    else if (arg == "--checkpoint-steps") checkpointSteps_ = std::atoll(requireValue(argc, argv, i).c_str());
+    else if (arg == "--checkpoint-seconds") checkpointSeconds_ = std::atof(requireValue(argc, argv, i).c_str());
+    else if (arg == "--resume") resumeFile_ = requireValue(argc, argv, i);
+    else if (arg == "--output-tapes") outputTapes_ = parseTapeList(requireValue(argc, argv, i));
+    else if (arg == "--output-mode") outputMode_ = requireValue(argc, argv, i);
+    else if (arg == "--verdict-only") verdictOnly_ = true;
+    else if (arg == "--trace-steps") traceSteps = requireValue(argc, argv, i);
+    else if (arg == "--trace-states") traceStates = requireValue(argc, argv, i);
+    else if (arg == "--trace-writes") traceWrites = requireValue(argc, argv, i);
+    else if (arg == "--trace-strings") traceStrings = requireValue(argc, argv, i);
+    else if (arg == "--trace-sample") traceSample = std::atoll(requireValue(argc, argv, i).c_str());
+    else if (arg == "--pipeline") pipeline_ = parseFileList(requireValue(argc, argv, i));
+    else if (arg == "--matrix") matrix_ = parseFileList(requireValue(argc, argv, i));
+    else if (arg == "--matrix-strings") matrixStrings_ = parseFileList(requireValue(argc, argv, i));
+    else if (arg == "--block-size") blockSize_ = std::atoi(requireValue(argc, argv, i).c_str());
+    else if (arg == "--shard") shardSpec = requireValue(argc, argv, i);
+    else if (arg == "--shard-by") shardBy = requireValue(argc, argv, i);
+    else if (arg == "--model-cache") modelCache_ = requireValue(argc, argv, i);
+    else if (arg == "--schedule") schedule_ = requireValue(argc, argv, i);
+    else if (arg == "--quantum") quantum_ = std::atoll(requireValue(argc, argv, i).c_str());
+    else if (arg == "--in-flight") inFlight_ = std::atoi(requireValue(argc, argv, i).c_str());
+    else if (arg == "--census") census_ = std::atoi(requireValue(argc, argv, i).c_str());
+    else if (arg == "--census-samples") censusSamples_ = std::atoi(requireValue(argc, argv, i).c_str());
+    else if (arg == "--threads") threads_ = std::atoi(requireValue(argc, argv, i).c_str());
+    else if (arg == "--bb-symbols") {
+      busyBeaverSymbols_ = std::atoi(requireValue(argc, argv, i).c_str());
+      symbolsGiven = true;
+    }
+    else if (arg == "--no-telemetry") telemetry_ = false;
+    else if (arg == "--perf-counters") perfCounters_ = true;
+    else if (arg == "--metrics") metricsFile_ = requireValue(argc, argv, i);
+    else if (arg == "--progress-seconds") progressSeconds_ = std::atof(requireValue(argc, argv, i).c_str());
+    else {
+      std::cerr << "Opción desconocida: " << arg << "\n";
+      exit(EXIT_FAILURE);
+    }
+  }
+  if (!traceSteps.empty() || !traceStates.empty() || !traceWrites.empty() || !traceStrings.empty() ||
+      traceSample != 1) {
+    trace_ = true;
+  }
+  try {
+    traceFilter_ = TraceFilter::parse(traceSteps, traceStates, traceWrites, traceStrings, traceSample);
+  } catch (const std::invalid_argument& error) {
+    std::cerr << error.what() << "\n";
+    exit(EXIT_FAILURE);
+  }
+  if (!modelCache_.empty()) compact_ = true;
+  try {
+    if (!shardSpec.empty()) shard_ = Shard::parse(shardSpec, shardBy);
+  } catch (const std::invalid_argument& error) {
+    std::cerr << error.what() << "\n";
+    exit(EXIT_FAILURE);
+  }
+  if (maxSteps_ <= 0) {
+    std::cerr << "--max-steps debe ser un número positivo.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (busyBeaverGiven) {
+    if (busyBeaver_ < 1 || busyBeaver_ > 26 || busyBeaverSymbols_ < 2 || busyBeaverSymbols_ > 10 || threads_ < 0) {
+      std::cerr << "--busy-beaver admite de 1 a 26 estados y --bb-symbols de 2 a 10 símbolos.\n";
+      exit(EXIT_FAILURE);
+    }
+    if (!maxStepsGiven) maxSteps_ = BusyBeaver::DEFAULT_MAX_STEPS;
+    return;
+  }
+  if (symbolsGiven) {
+    std::cerr << "--bb-symbols requiere --busy-beaver <n>.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (compact_ && (trace_ || !checkpointFile_.empty() || !resumeFile_.empty())) {
+    std::cerr << "--compact no admite --trace, --checkpoint ni --resume.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (mappedTape_ && (compact_ || trace_ || !checkpointFile_.empty() || !resumeFile_.empty())) {
+    std::cerr << "--mmap-tape no admite --compact, --trace, --checkpoint ni --resume.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (outputMode_ != "full" && outputMode_ != "trim" && outputMode_ != "span") {
+    std::cerr << "--output-mode debe ser full, trim o span.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (mappedTape_ && (verdictOnly_ || outputMode_ != "full" || outputTapes_ != std::vector<int>(1, 0))) {
+    std::cerr << "--mmap-tape no admite --output-tapes, --output-mode ni --verdict-only.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (!pipeline_.empty() && (compact_ || mappedTape_ || trace_ || !checkpointFile_.empty() || !resumeFile_.empty())) {
+    std::cerr << "--pipeline no admite --compact, --mmap-tape, --trace, --checkpoint ni --resume.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (blockSize_ < 0) {
+    std::cerr << "--block-size debe ser un número positivo.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (blockSize_ > 0 && (compact_ || mappedTape_ || trace_ || !checkpointFile_.empty() || !resumeFile_.empty() ||
+                         !pipeline_.empty())) {
+    std::cerr << "--block-size no admite --compact, --mmap-tape, --trace, --checkpoint, --resume ni --pipeline.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (!schedule_.empty() && schedule_ != "fair" && schedule_ != "srf") {
+    std::cerr << "--schedule debe ser fair o srf.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (quantum_ <= 0 || inFlight_ <= 0) {
+    std::cerr << "--quantum y --in-flight deben ser números positivos.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (!schedule_.empty() && (compact_ || mappedTape_ || trace_ || !checkpointFile_.empty() || !resumeFile_.empty() ||
+                             !pipeline_.empty() || blockSize_ > 0)) {
+    std::cerr << "--schedule no admite --compact, --mmap-tape, --trace, --checkpoint, --resume, --pipeline ni --block-size.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (stringsFile_.empty() && census_ < 0) {
+    std::cerr << "Falta el fichero de cadenas (solo se puede omitir con --census).\n";
+    exit(EXIT_FAILURE);
+  }
+  if (census_ >= 0 && (mappedTape_ || trace_ || !checkpointFile_.empty() || !resumeFile_.empty() ||
+                       !pipeline_.empty() || blockSize_ > 0 || !schedule_.empty() || shard_.isEnabled())) {
+    std::cerr << "--census no admite --mmap-tape, --trace, --checkpoint, --resume, --pipeline, --block-size, "
+                 "--schedule ni --shard.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (censusSamples_ < 0 || threads_ < 0) {
+    std::cerr << "--census-samples y --threads no pueden ser negativos.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (shard_.isEnabled() && (mappedTape_ || !checkpointFile_.empty() || !resumeFile_.empty() || !pipeline_.empty())) {
+    std::cerr << "--shard no admite --mmap-tape, --checkpoint, --resume ni --pipeline.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (!matrixStrings_.empty() && matrix_.empty()) {
+    std::cerr << "--matrix-strings requiere --matrix <MT2,MT3,...>.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (!matrix_.empty() && (compact_ || mappedTape_ || trace_ || !checkpointFile_.empty() || !resumeFile_.empty() ||
+                           !pipeline_.empty() || blockSize_ > 0 || !schedule_.empty() || shard_.isEnabled() ||
+                           census_ >= 0)) {
+    std::cerr << "--matrix no admite --compact, --mmap-tape, --trace, --checkpoint, --resume, --pipeline, "
+                 "--block-size, --schedule, --shard ni --census.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (fuseChains_ && (compact_ || mappedTape_ || trace_ || !checkpointFile_.empty() || !resumeFile_.empty() ||
+                      blockSize_ > 0 || census_ >= 0)) {
+    std::cerr << "--fuse-chains no admite --compact, --mmap-tape, --trace, --checkpoint, --resume, --block-size "
+                 "ni --census.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (prefixSharing_ && (compact_ || mappedTape_ || trace_ || !checkpointFile_.empty() || !resumeFile_.empty() ||
+                         !pipeline_.empty() || blockSize_ > 0 || !schedule_.empty() || shard_.isEnabled() ||
+                         census_ >= 0 || !matrix_.empty())) {
+    std::cerr << "--prefix-sharing no admite --compact, --mmap-tape, --trace, --checkpoint, --resume, --pipeline, "
+                 "--block-size, --schedule, --shard, --census ni --matrix.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (lazyLoad_ && (compact_ || !modelCache_.empty() || optimize_ || fuseChains_ || blockSize_ > 0 ||
+                    census_ >= 0 || !matrix_.empty())) {
+    std::cerr << "--lazy-load no admite --compact, --model-cache, --optimize, --fuse-chains, --block-size, "
+                 "--census ni --matrix (necesitan la máquina entera).\n";
+    exit(EXIT_FAILURE);
+  }
+  if (streamTape_ && (compact_ || mappedTape_ || trace_ || !checkpointFile_.empty() || !resumeFile_.empty() ||
+                      !pipeline_.empty() || blockSize_ > 0 || shard_.isEnabled() || census_ >= 0 ||
+                      !matrix_.empty() || prefixSharing_ || schedule_ == "srf")) {
+    std::cerr << "--stream-tape no admite --compact, --mmap-tape, --trace, --checkpoint, --resume, --pipeline, "
+                 "--block-size, --shard, --census, --matrix, --prefix-sharing ni --schedule srf.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (streamFollow_ && !streamTape_) {
+    std::cerr << "--stream-follow requiere --stream-tape.\n";
+    exit(EXIT_FAILURE);
+  }
+  if (perfCounters_ && (!telemetry_ || !pipeline_.empty() || !matrix_.empty() || census_ >= 0)) {
+    std::cerr << "--perf-counters requiere la telemetría y no admite --pipeline, --matrix ni --census "
+                 "(solo mide el hilo principal).\n";
+    exit(EXIT_FAILURE);
+  }
+  if ((checkpointSteps_ > 0 || checkpointSeconds_ > 0) && checkpointFile_.empty()) {
+    std::cerr << "--checkpoint-steps/--checkpoint-seconds requieren --checkpoint <fichero>.\n";
+    exit(EXIT_FAILURE);
+  }
+}
+
+/**
+ * @brief Devuelve el valor que acompaña a una opción y avanza el índice.
+ * 
+ * @param argc Número de argumentos de línea de comandos.
+ * @param argv Array de argumentos de línea de comandos.
+ * @param i Índice de la opción (se incrementa para saltar el valor).
+ * @return Valor de la opción.
+ */
+std::string Args::requireValue(int argc, char* argv[], int& i) const {
+  if (i + 1 >= argc) {
+    std::cerr << "La opción " << argv[i] << " requiere un valor.\n";
+    exit(EXIT_FAILURE);
+  }
+  return argv[++i];
+}
+
+/**
+ * @brief Parsea una lista de cintas separadas por comas (p. ej. "0,2").
+ * 
+ * @param list Lista de índices de cinta.
+ * @return Índices de cinta en el orden dado.
+ */
+std::vector<int> Args::parseTapeList(const std::string& list) const {
+  std::vector<int> tapes;
+  size_t start = 0;
+  while (start <= list.size()) {
+    size_t comma = list.find(',', start);
+    if (comma == std::string::npos) comma = list.size();
+    std::string item = list.substr(start, comma - start);
+    if (item.empty() || item.find_first_not_of("0123456789") != std::string::npos) {
+      std::cerr << "--output-tapes espera índices de cinta separados por comas: " << list << "\n";
+      exit(EXIT_FAILURE);
+    }
+    tapes.push_back(std::atoi(item.c_str()));
+    start = comma + 1;
+  }
+  return tapes;
+}
+
+/**
+ * @brief Parsea una lista de ficheros separados por comas, ignorando elementos vacíos.
+ * 
+ * @param list Lista de ficheros.
+ * @return Ficheros en el orden dado.
+ */
+std::vector<std::string> Args::parseFileList(const std::string& list) const {
+  std::vector<std::string> files;
+  size_t start = 0;
+  while (start <= list.size()) {
+    size_t comma = list.find(',', start);
+    if (comma == std::string::npos) comma = list.size();
+    if (comma > start) files.push_back(list.substr(start, comma - start));
+    start = comma + 1;
   }
+  return files;
 }
@@ -2,6 +2,9 @@
 #define ARG_PARSER_H
 
 #include <string>
+#include <vector>
+#include "shard.h"
+#include "trace_filter.h"
 
 /**
  * @brief Clase para almacenar los argumentos parseados de línea de comandos.
@@ -13,11 +16,86 @@ public:
   const std::string& getStringsFile() const { return stringsFile_; }
   bool getTrace() const { return trace_; }
   bool getInfo() const { return info_; }
+  bool getOptimize() const { return optimize_; }
+  bool getFuseChains() const { return fuseChains_; }
+  bool getPrefixSharing() const { return prefixSharing_; }
+  bool getLazyLoad() const { return lazyLoad_; }
+  bool getStreamTape() const { return streamTape_; }
+  bool getStreamFollow() const { return streamFollow_; }
+  bool getCompact() const { return compact_; }
+  bool getMappedTape() const { return mappedTape_; }
+  const std::string& getTapeOutFile() const { return tapeOutFile_; }
+  long long getMaxSteps() const { return maxSteps_; }
+  const std::string& getCheckpointFile() const { return checkpointFile_; }
+  long long getCheckpointSteps() const { return checkpointSteps_; }
+  double getCheckpointSeconds() const { return checkpointSeconds_; }
+  const std::string& getResumeFile() const { return resumeFile_; }
+  const std::vector<int>& getOutputTapes() const { return outputTapes_; }
+  const std::string& getOutputMode() const { return outputMode_; }
+  bool getVerdictOnly() const { return verdictOnly_; }
+  bool getTelemetry() const { return telemetry_; }
+  bool getPerfCounters() const { return perfCounters_; }
+  const std::string& getMetricsFile() const { return metricsFile_; }
+  double getProgressSeconds() const { return progressSeconds_; }
+  const TraceFilter& getTraceFilter() const { return traceFilter_; }
+  const std::vector<std::string>& getPipeline() const { return pipeline_; }
+  const std::vector<std::string>& getMatrix() const { return matrix_; }
+  const std::vector<std::string>& getMatrixStrings() const { return matrixStrings_; }
+  int getBlockSize() const { return blockSize_; }
+  const Shard& getShard() const { return shard_; }
+  const std::string& getModelCache() const { return modelCache_; }
+  const std::string& getSchedule() const { return schedule_; }
+  long long getQuantum() const { return quantum_; }
+  int getInFlight() const { return inFlight_; }
+  int getCensus() const { return census_; }
+  int getCensusSamples() const { return censusSamples_; }
+  int getThreads() const { return threads_; }
+  int getBusyBeaver() const { return busyBeaver_; }
+  int getBusyBeaverSymbols() const { return busyBeaverSymbols_; }
 private:
+  std::string requireValue(int argc, char* argv[], int& i) const;
+  std::vector<int> parseTapeList(const std::string& list) const;
+  std::vector<std::string> parseFileList(const std::string& list) const;
   std::string mtFile_;
   std::string stringsFile_;
   bool trace_;
   bool info_;
+  bool optimize_;
+  bool fuseChains_;
+  bool prefixSharing_;
+  bool lazyLoad_;
+  bool streamTape_;
+  bool streamFollow_;
+  bool compact_;
+  bool mappedTape_;
+  std::string tapeOutFile_;
+  long long maxSteps_;
+  std::string checkpointFile_;
+  long long checkpointSteps_;
+  double checkpointSeconds_;
+  std::string resumeFile_;
+  std::vector<int> outputTapes_;
+  std::string outputMode_;
+  bool verdictOnly_;
+  bool telemetry_;
+  bool perfCounters_;
+  std::string metricsFile_;
+  double progressSeconds_;
+  TraceFilter traceFilter_;
+  std::vector<std::string> pipeline_;
+  std::vector<std::string> matrix_;
+  std::vector<std::string> matrixStrings_;
+  int blockSize_;
+  Shard shard_;
+  std::string modelCache_;
+  std::string schedule_;
+  long long quantum_;
+  int inFlight_;
+  int census_;
+  int censusSamples_;
+  int threads_;
+  int busyBeaver_;
+  int busyBeaverSymbols_;
 };
 
 
@@ -0,0 +1,859 @@
+#include "batch_runner.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "batch_telemetry.h"
+#include "busy_beaver.h"
+#include "census.h"
+#include "checkpointer.h"
+#include "snapshot.h"
+#include "file_parser.h"
+#include "matrix.h"
+#include "model_cache.h"
+#include "perf_counters.h"
+#include "pipeline.h"
+#include "prefix_sharing.h"
+#include "run_context.h"
+#include "scheduler.h"
+#include "shard.h"
+
+/**
+ * @brief Constructor: prepara los motores sin MT (se carga con loadFile o loadBuffer).
+ * 
+ * @param options Motor con el que se simulará cada cadena.
+ */
+BatchRunner::BatchRunner(const BatchOptions& options)
+  : options_(options), cacheRebuilt_(false), simulator_(model_), compactSimulator_(compactModel_) {
+  setMaxSteps(options_.maxSteps);
+}
+
+/**
+ * @brief Carga la MT desde un fichero según las opciones.
+ * 
+ * Con modelCache el modelo compacto sale de la caché (y se compila si hace
+ * falta); con compact y sin optimize se parsea directamente en formato
+ * compacto; con lazyLoad solo se indexan las transiciones; si no, se parsea
+ * entera y se prepara con adopt().
+ * 
+ * @param path Fichero de la MT.
+ * @throws std::runtime_error si el fichero no existe o no es válido para el motor elegido.
+ */
+void BatchRunner::loadFile(const std::string& path) {
+  FileParser parser;
+  cacheRebuilt_ = false;
+  if (!options_.modelCache.empty()) {
+    compactModel_ = ModelCache::load(options_.modelCache, path, options_.optimize, cacheRebuilt_);
+  } else if (options_.compact && !options_.optimize) {
+    compactModel_ = parser.parseCompactFile(path);
+  } else if (options_.lazyLoad) {
+    adopt(parser.parseLazyFile(path));
+  } else {
+    adopt(parser.parseFile(path));
+  }
+}
+
+/**
+ * @brief Carga la MT desde una definición en memoria, con el mismo formato que el fichero.
+ * 
+ * @param text Definición de la MT.
+ * @throws std::runtime_error si no es válida o se pidió lazyLoad (que necesita un fichero).
+ */
+void BatchRunner::loadBuffer(const std::string& text) {
+  if (options_.lazyLoad) throw std::runtime_error("La carga perezosa necesita un fichero, no una MT en memoria");
+  FileParser parser;
+  adopt(parser.parseBuffer(text));
+}
+
+/**
+ * @brief Se queda con un modelo ya parseado y prepara el motor.
+ * 
+ * Rechaza las operaciones nativas si el motor no las admite, optimiza el
+ * modelo, lo pasa a formato compacto y crea la fusión de cadenas o el
+ * simulador por bloques según las opciones.
+ * 
+ * @param model Modelo parseado.
+ * @throws std::runtime_error si el motor no admite la MT.
+ */
+void BatchRunner::adopt(TuringMachineModel model) {
+  if (!options_.transitionsOnly.empty() && !model.getBuiltins().empty()) {
+    throw std::runtime_error("Error: " + options_.transitionsOnly + " no admite operaciones nativas (estado " +
+                             model.getBuiltins().begin()->first + ")");
+  }
+  model_ = std::move(model);
+  if (options_.optimize && !options_.lazyLoad) model_ = optimizer_.optimize(model_);
+  fusion_.reset();
+  blockSimulator_.reset();
+  simulator_.setChainFusion(nullptr);
+  if (options_.compact) {
+    compactModel_ = CompactModel::fromModel(model_);
+    model_ = TuringMachineModel();
+    return;
+  }
+  if (options_.fuseChains) {
+    fusion_.reset(new ChainFusion(model_));
+    simulator_.setChainFusion(fusion_.get());
+  }
+  if (options_.blockSize > 0) {
+    blockSimulator_.reset(new BlockSimulator(model_, options_.blockSize));
+    blockSimulator_->setMaxSteps(options_.maxSteps);
+  }
+}
+
+/**
+ * @brief Número de cintas de la MT cargada.
+ */
+int BatchRunner::getTapeCount() const {
+  return options_.compact ? compactModel_.getTapeCount() : model_.determineTapeCount();
+}
+
+/**
+ * @brief Límite de pasos por cadena de todos los motores.
+ */
+void BatchRunner::setMaxSteps(long long maxSteps) {
+  options_.maxSteps = maxSteps;
+  simulator_.setMaxSteps(maxSteps);
+  compactSimulator_.setMaxSteps(maxSteps);
+  if (blockSimulator_) blockSimulator_->setMaxSteps(maxSteps);
+}
+
+/**
+ * @brief Simula una cadena con el motor elegido.
+ * 
+ * @param input Cadena de entrada (cinta 0).
+ * @param steps Pasos dados (salida).
+ * @param output Se le añade la proyección de las cintas finales (nada con verdictOnly).
+ * @return Motivo por el que se detuvo la ejecución.
+ */
+RunStatus BatchRunner::simulate(const std::vector<Symbol>& input, long long& steps, std::string& output) {
+  if (options_.compact) return compactSimulator_.compute(String(input), steps, projection_, output);
+  RunStatus status;
+  if (blockSimulator_) {
+    status = blockSimulator_->run(String(input), configuration_);
+  } else {
+    configuration_ = simulator_.start(std::vector<Symbol>(input));
+    std::ostringstream unused;
+    status = simulator_.run(configuration_, false, unused);
+  }
+  steps = configuration_.getSteps();
+  if (!projection_.isVerdictOnly()) projection_.write(output, configuration_);
+  return status;
+}
+
+/**
+ * @brief Vuelca las métricas del lote, avisando por stderr si no se puede.
+ * 
+ * @param telemetry Telemetría acumulada.
+ * @param path Fichero de métricas.
+ */
+static void writeMetrics(const BatchTelemetry& telemetry, const std::string& path) {
+  if (!telemetry.writePrometheus(path)) {
+    std::cerr << "No se pudieron escribir las métricas en " << path << std::endl;
+  }
+}
+
+/**
+ * @brief Completa una línea de FileOut.txt con el veredicto y la proyección de las cintas.
+ * 
+ * @param line Línea que ya contiene "<cadena>: " (se completa hasta el salto de línea).
+ * @param accepted Veredicto.
+ * @param projection Cintas y modo de salida.
+ * @param configuration Configuración final.
+ * @return Posición de la línea donde empieza la proyección de las cintas.
+ */
+static size_t appendResult(std::string& line, bool accepted, const ResultProjection& projection,
+                           const Configuration& configuration) {
+  line.append(accepted ? "ACEPTADA" : "RECHAZADA");
+  size_t projectionAt = line.size();
+  if (!projection.isVerdictOnly()) {
+    line.append(" -> Resultado: ");
+    projectionAt = line.size();
+    projection.write(line, configuration);
+  }
+  line.push_back('\n');
+  return projectionAt;
+}
+
+/**
+ * @brief Comprueba que una instantánea encaja con el lote antes de recortar FileOut.txt para reanudarlo.
+ * 
+ * La cadena en curso de la instantánea tiene que ser la misma que ocupa su
+ * índice en el fichero de cadenas, y el fichero de resultados tiene que tener
+ * al menos los bytes que había al guardarla (recortarlo a más lo rellenaría
+ * de ceros). El fichero de cadenas queda de nuevo al principio.
+ * 
+ * @param snapshot Instantánea que se va a reanudar.
+ * @param inputStrings Fichero de cadenas ya abierto.
+ * @param resultPath Fichero de resultados que se va a recortar.
+ * @throws std::runtime_error si la instantánea no corresponde al lote.
+ */
+static void checkResumePosition(const Snapshot& snapshot, std::istream& inputStrings, const std::string& resultPath) {
+  std::string inputString;
+  uint64_t index = 0;
+  bool found = false;
+  while (!found && std::getline(inputStrings, inputString)) {
+    if (inputString.empty()) continue;
+    found = index++ == snapshot.getInputIndex();
+  }
+  inputStrings.clear();
+  inputStrings.seekg(0);
+  if (!found || inputString != snapshot.getInput()) {
+    throw std::runtime_error("La cadena " + std::to_string(snapshot.getInputIndex()) +
+                             " no coincide con la de la instantánea");
+  }
+  struct stat info;
+  if (::stat(resultPath.c_str(), &info) != 0 || static_cast<uint64_t>(info.st_size) < snapshot.getResultOffset()) {
+    throw std::runtime_error("El fichero " + resultPath + " es más corto que cuando se guardó la instantánea");
+  }
+}
+
+/**
+ * @brief Ejecuta el censo (--census) y muestra la tabla por longitud.
+ * 
+ * El alfabeto de entrada se lee de la cabecera del fichero de la MT, así que
+ * sirve igual con el modelo normal que con --compact o --model-cache.
+ * 
+ * @param args Argumentos de línea de comandos.
+ * @param compactModel Modelo compacto de la MT.
+ * @return 0 si todo fue bien, 1 si no se pudo leer el alfabeto o enumerar las cadenas.
+ */
+static int runCensus(const Args& args, const CompactModel& compactModel) {
+  try {
+    std::ifstream infile(args.getMtFile());
+    FileParser parser;
+    std::vector<std::string> states, inputAlphabet, tapeAlphabet, acceptStates;
+    std::string initialState, blank;
+    parser.readHeaderSections(infile, states, inputAlphabet, tapeAlphabet, initialState, blank, acceptStates);
+    std::vector<char> alphabet;
+    for (const std::string& symbol : inputAlphabet) {
+      if (!symbol.empty()) alphabet.push_back(symbol[0]);
+    }
+    int threads = args.getThreads() > 0 ? args.getThreads() : std::thread::hardware_concurrency();
+    Census census(compactModel, alphabet, args.getMaxSteps(), threads, args.getCensusSamples());
+    census.run(args.getCensus());
+    std::cout << census << "\n";
+  } catch (const std::exception& error) {
+    std::cerr << error.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Ejecuta el modo --busy-beaver: enumera las máquinas y guarda los campeones.
+ * 
+ * Cada campeón se construye como TuringMachineModel en memoria y se vuelve a
+ * simular con TuringMachineSimulator sobre la cinta en blanco, para comprobar
+ * que el enumerador y el simulador coinciden en pasos y símbolos no blancos,
+ * antes de escribirlo como fichero de MT (BusyBeaver-<n>x<k>-pasos_MT.txt y
+ * BusyBeaver-<n>x<k>-no-blancos_MT.txt).
+ * 
+ * @param args Argumentos de línea de comandos.
+ * @return 0 si todo fue bien, 1 si los parámetros no son válidos o el simulador no reproduce un campeón.
+ */
+static int runBusyBeaver(const Args& args) {
+  try {
+    int threads = args.getThreads() > 0 ? args.getThreads() : std::thread::hardware_concurrency();
+    BusyBeaver search(args.getBusyBeaver(), args.getBusyBeaverSymbols(), args.getMaxSteps(), threads);
+    search.run();
+    std::cout << search << "\n";
+    const BusyBeaverMachine* champions[] = {&search.getStepsChampion(), &search.getOnesChampion()};
+    const char* const names[] = {"pasos", "no-blancos"};
+    for (int i = 0; i < 2; ++i) {
+      TuringMachineModel model = search.toModel(*champions[i]);
+      TuringMachineSimulator simulator(model);
+      simulator.setMaxSteps(args.getMaxSteps());
+      Configuration configuration = simulator.start(String(std::vector<Symbol>()));
+      std::ostringstream unused;
+      RunStatus status = simulator.run(configuration, false, unused);
+      const std::vector<Symbol>& tape0 = configuration.getTapes()[0];
+      long long ones = std::count_if(tape0.begin(), tape0.end(), [](const Symbol& cell) { return cell.getValue() != '.'; });
+      if (status != RunStatus::ACCEPTED || configuration.getSteps() != champions[i]->steps || ones != champions[i]->ones) {
+        std::cerr << "El simulador no reproduce el campeón " << search.notation(*champions[i]) << " ("
+                  << configuration.getSteps() << " pasos, " << ones << " no blancos)" << std::endl;
+        return 1;
+      }
+      std::string path = "BusyBeaver-" + std::to_string(args.getBusyBeaver()) + "x" +
+                         std::to_string(args.getBusyBeaverSymbols()) + "-" + names[i] + "_MT.txt";
+      std::ofstream file(path);
+      file << search.toText(*champions[i]);
+      std::cout << "Campeón por " << names[i] << " comprobado con el simulador y guardado en " << path << "\n";
+    }
+  } catch (const std::exception& error) {
+    std::cerr << error.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Ejecuta una única entrada con --stream-tape: la cinta 0 llega del fichero, la FIFO o stdin.
+ * 
+ * La simulación empieza con lo primero que llega y espera cada vez que el
+ * cabezal 0 pasa de lo recibido (TuringMachineSimulator::runOnStream). El
+ * veredicto se anuncia por stdout en cuanto se decide, sin esperar al resto de
+ * la entrada, y FileOut.txt recibe la línea habitual con la cinta 0 hasta donde
+ * se llegó a leer.
+ * 
+ * @param args Argumentos de línea de comandos.
+ * @param simulator Simulador de la MT.
+ * @param projection Cintas y modo de salida.
+ * @param telemetry Telemetría del lote.
+ * @return 0 si todo fue bien, 1 si no se pudo leer la entrada.
+ */
+static int runStream(const Args& args, const TuringMachineSimulator& simulator, const ResultProjection& projection,
+                     BatchTelemetry& telemetry) {
+  BatchTelemetry::Clock::time_point phaseStart = telemetry.now();
+  std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+  Configuration configuration = simulator.start(std::vector<Symbol>());
+  RunStatus status;
+  std::unique_ptr<StreamTape> tape0;
+  try {
+    tape0.reset(new StreamTape(args.getStringsFile(), args.getStreamFollow()));
+    status = simulator.runOnStream(configuration, *tape0, std::numeric_limits<long long>::max(), true);
+  } catch (const std::runtime_error& error) {
+    std::cerr << error.what() << std::endl;
+    return 1;
+  }
+  bool accepted = status == RunStatus::ACCEPTED;
+  telemetry.recordString(phaseStart, configuration.getSteps(), accepted);
+  double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+  std::cout << "Decisión: " << (accepted ? "ACEPTADA" : "RECHAZADA")
+            << (status == RunStatus::STEP_LIMIT ? " (límite de pasos)" : "") << " en " << configuration.getSteps()
+            << " pasos, " << elapsed << " s después de empezar\n" << *tape0 << std::endl;
+  phaseStart = telemetry.now();
+  std::string resultLine = args.getStringsFile() + ": ";
+  appendResult(resultLine, accepted, projection, configuration);
+  std::ofstream resultFile("FileOut.txt");
+  resultFile << resultLine;
+  resultFile.close();
+  telemetry.addPhase(BatchTelemetry::Phase::WRITE, phaseStart);
+  writeMetrics(telemetry, args.getMetricsFile());
+  std::cout << "Resultados guardados en FileOut.txt\n";
+  return 0;
+}
+
+/**
+ * @brief Ejecuta el lote en modo --pipeline y escribe FileOut.txt.
+ * 
+ * La primera etapa es la MT principal y el resto las de --pipeline (parseadas
+ * y, con --optimize, optimizadas igual que ella). Al terminar muestra las
+ * estadísticas de cada etapa.
+ * 
+ * @param args Argumentos de línea de comandos.
+ * @param firstModel Modelo de la primera etapa.
+ * @param projection Cintas y modo de salida.
+ * @param telemetry Telemetría del lote.
+ * @param inputStrings Fichero de cadenas ya abierto.
+ * @return 0 si todo fue bien, 1 si alguna cadena produjo un error.
+ */
+static int runPipeline(const Args& args, const TuringMachineModel& firstModel, const ResultProjection& projection,
+                       BatchTelemetry& telemetry, std::istream& inputStrings) {
+  BatchTelemetry::Clock::time_point phaseStart = telemetry.now();
+  FileParser parser;
+  std::vector<TuringMachineModel> models(args.getPipeline().size());
+  for (size_t i = 0; i < models.size(); ++i) {
+    models[i] = parser.parseFile(args.getPipeline()[i]);
+    if (args.getOptimize()) {
+      MachineOptimizer optimizer;
+      models[i] = optimizer.optimize(models[i]);
+    }
+  }
+  telemetry.addPhase(BatchTelemetry::Phase::PARSE, phaseStart);
+  try {
+    projection.checkTapes(models.empty() ? firstModel.determineTapeCount() : models.back().determineTapeCount(),
+                          models.empty() ? args.getMtFile() : args.getPipeline().back());
+  } catch (const std::runtime_error& error) {
+    std::cerr << error.what() << std::endl;
+    return 1;
+  }
+  std::vector<std::unique_ptr<TuringMachineSimulator>> simulators;
+  std::vector<std::unique_ptr<ChainFusion>> fusions;
+  std::vector<const TuringMachineSimulator*> stages;
+  std::vector<std::string> names(1, args.getMtFile());
+  simulators.emplace_back(new TuringMachineSimulator(firstModel));
+  for (size_t i = 0; i < models.size(); ++i) {
+    simulators.emplace_back(new TuringMachineSimulator(models[i]));
+    names.push_back(args.getPipeline()[i]);
+  }
+  for (size_t i = 0; i < simulators.size(); ++i) {
+    simulators[i]->setMaxSteps(args.getMaxSteps());
+    if (args.getFuseChains()) {
+      fusions.emplace_back(new ChainFusion(i == 0 ? firstModel : models[i - 1]));
+      simulators[i]->setChainFusion(fusions.back().get());
+    }
+    stages.push_back(simulators[i].get());
+  }
+  Pipeline pipeline(stages, names);
+  std::ofstream resultFile("FileOut.txt");
+  std::string resultLine;
+  bool failed = false;
+  pipeline.run(inputStrings, [&](PipelineItem& item) {
+    if (!item.error.empty()) {
+      std::cerr << "Error procesando la cadena \"" << item.input << "\" (" << item.error << ")" << std::endl;
+      failed = true;
+      return;
+    }
+    bool accepted = item.status == RunStatus::ACCEPTED;
+    telemetry.recordString(item.started, item.steps, accepted);
+    BatchTelemetry::Clock::time_point writeStart = telemetry.now();
+    resultLine.assign(item.input).append(": ");
+    appendResult(resultLine, accepted, projection, item.configuration);
+    resultFile << resultLine;
+    telemetry.addPhase(BatchTelemetry::Phase::WRITE, writeStart);
+  });
+  resultFile.close();
+  writeMetrics(telemetry, args.getMetricsFile());
+  std::cout << "Resultados guardados en FileOut.txt\n";
+  std::cout << "Etapas del pipeline:\n";
+  for (size_t i = 0; i < pipeline.getStats().size(); ++i) {
+    std::cout << "  " << i + 1 << ". " << pipeline.getStats()[i] << "\n";
+    if (!fusions.empty()) std::cout << "     " << *fusions[i] << "\n";
+  }
+  return failed ? 1 : 0;
+}
+
+/**
+ * @brief Ejecuta el modo --matrix y escribe la tabla de resultados en FileOut.txt.
+ * 
+ * La primera MT es la principal y el resto las de --matrix (parseadas y, con
+ * --optimize, optimizadas igual que ella); las cadenas son las del fichero
+ * principal seguidas de las de --matrix-strings. Con --fuse-chains cada MT
+ * tiene su propia ChainFusion.
+ * 
+ * @param args Argumentos de línea de comandos.
+ * @param firstModel Modelo de la primera MT.
+ * @param projection Cintas y modo de salida de cada celda.
+ * @param telemetry Telemetría del lote (solo se mide el parseo).
+ * @param inputStrings Fichero de cadenas principal ya abierto.
+ * @return 0 si todo fue bien, 1 si no se pudo cargar alguna MT o abrir algún fichero de cadenas.
+ */
+static int runMatrix(const Args& args, const TuringMachineModel& firstModel, const ResultProjection& projection,
+                     BatchTelemetry& telemetry, std::istream& inputStrings) {
+  BatchTelemetry::Clock::time_point phaseStart = telemetry.now();
+  FileParser parser;
+  std::vector<TuringMachineModel> models(args.getMatrix().size());
+  for (size_t i = 0; i < models.size(); ++i) {
+    try {
+      models[i] = parser.parseFile(args.getMatrix()[i]);
+    } catch (const std::exception& error) {
+      std::cerr << "No se pudo cargar la MT " << args.getMatrix()[i] << ": " << error.what() << std::endl;
+      return 1;
+    }
+    try {
+      projection.checkTapes(models[i].determineTapeCount(), args.getMatrix()[i]);
+    } catch (const std::runtime_error& error) {
+      std::cerr << error.what() << std::endl;
+      return 1;
+    }
+    if (args.getOptimize()) {
+      MachineOptimizer optimizer;
+      models[i] = optimizer.optimize(models[i]);
+    }
+  }
+  std::vector<std::unique_ptr<TuringMachineSimulator>> simulators;
+  std::vector<std::unique_ptr<ChainFusion>> fusions;
+  std::vector<const TuringMachineSimulator*> machines;
+  std::vector<std::string> names(1, args.getMtFile());
+  simulators.emplace_back(new TuringMachineSimulator(firstModel));
+  for (size_t i = 0; i < models.size(); ++i) {
+    simulators.emplace_back(new TuringMachineSimulator(models[i]));
+    names.push_back(args.getMatrix()[i]);
+  }
+  for (size_t i = 0; i < simulators.size(); ++i) {
+    simulators[i]->setMaxSteps(args.getMaxSteps());
+    if (args.getFuseChains()) {
+      fusions.emplace_back(new ChainFusion(i == 0 ? firstModel : models[i - 1]));
+      simulators[i]->setChainFusion(fusions.back().get());
+    }
+    machines.push_back(simulators[i].get());
+  }
+  int threads = args.getThreads() > 0 ? args.getThreads() : std::thread::hardware_concurrency();
+  Matrix matrix(machines, names, projection, threads);
+  matrix.addStrings(args.getStringsFile(), inputStrings);
+  for (const std::string& path : args.getMatrixStrings()) {
+    std::ifstream strings(path);
+    if (!strings.is_open()) {
+      std::cerr << "No se pudo abrir el archivo de cadenas: " << path << std::endl;
+      return 1;
+    }
+    matrix.addStrings(path, strings);
+  }
+  telemetry.addPhase(BatchTelemetry::Phase::PARSE, phaseStart);
+  matrix.run();
+  std::ofstream resultFile("FileOut.txt");
+  matrix.write(resultFile);
+  resultFile.close();
+  writeMetrics(telemetry, args.getMetricsFile());
+  std::cout << "Resultados guardados en FileOut.txt\n";
+  std::cout << matrix << "\n";
+  return 0;
+}
+
+/**
+ * @brief Ejecuta el lote con --prefix-sharing y escribe FileOut.txt en el orden del fichero.
+ * 
+ * Lee todas las cadenas, las simula con PrefixSharing y reordena las líneas por
+ * su índice. El tiempo de cada cadena en la telemetría es el transcurrido desde
+ * el resultado anterior, ya que la simulación de los prefijos es compartida.
+ * 
+ * @param args Argumentos de línea de comandos.
+ * @param simulator Simulador de la MT (con --fuse-chains ya configurado).
+ * @param projection Cintas y modo de salida.
+ * @param telemetry Telemetría del lote.
+ * @param inputStrings Fichero de cadenas ya abierto.
+ * @return 0.
+ */
+static int runPrefixSharing(const Args& args, const TuringMachineSimulator& simulator,
+                            const ResultProjection& projection, BatchTelemetry& telemetry,
+                            std::istream& inputStrings) {
+  BatchTelemetry::Clock::time_point phaseStart = telemetry.now();
+  PrefixSharing sharing(simulator);
+  std::vector<std::string> inputs;
+  std::string inputString;
+  RunContext context;
+  while (std::getline(inputStrings, inputString)) {
+    if (inputString.empty()) continue;
+    context.load(inputString);
+    sharing.add(inputs.size(), context.getInput());
+    inputs.push_back(inputString);
+  }
+  telemetry.addPhase(BatchTelemetry::Phase::PARSE, phaseStart);
+  std::vector<std::string> lines(inputs.size());
+  BatchTelemetry::Clock::time_point previous = telemetry.now();
+  sharing.run([&](uint64_t index, RunStatus status, const Configuration& configuration) {
+    bool accepted = status == RunStatus::ACCEPTED;
+    telemetry.recordString(previous, configuration.getSteps(), accepted);
+    BatchTelemetry::Clock::time_point writeStart = telemetry.now();
+    lines[index].assign(inputs[index]).append(": ");
+    appendResult(lines[index], accepted, projection, configuration);
+    telemetry.addPhase(BatchTelemetry::Phase::WRITE, writeStart);
+    previous = telemetry.now();
+  });
+  phaseStart = telemetry.now();
+  std::ofstream resultFile("FileOut.txt");
+  for (const std::string& line : lines) resultFile << line;
+  resultFile.close();
+  telemetry.addPhase(BatchTelemetry::Phase::WRITE, phaseStart);
+  writeMetrics(telemetry, args.getMetricsFile());
+  std::cout << "Resultados guardados en FileOut.txt\n";
+  std::cout << sharing << "\n";
+  return 0;
+}
+
+/**
+ * @brief Programa de línea de comandos del simulador de Máquinas de Turing multicinta (pract-02).
+ * 
+ * Flujo de ejecución:
+ * 1. Lee y construye el modelo de la Máquina de Turing desde el fichero de entrada
+ *    con loadFile() (y lo optimiza con MachineOptimizer si se pasa --optimize)
+ * 2. Prepara el motor elegido por los argumentos (simulador, compacto, bloques...)
+ * 3. Si se solicita --info, muestra la información de la MT
+ * 4. Lee cada cadena del fichero de cadenas
+ * 5. Simula cada cadena en la MT, determinando si es aceptada o rechazada
+ * 6. Escribe los resultados en FileOut.txt, incluyendo el estado final de la cinta 0
+ * 7. Si el flag de traza está activo, incluye la traza de ejecución (filtrada con --trace-*)
+ * 
+ * Con --checkpoint se guardan instantáneas periódicas (y al recibir SIGINT/SIGTERM,
+ * que suspenden la ejecución); con --resume se continúa el lote desde la cadena y
+ * configuración guardadas, recortando FileOut.txt al punto de la instantánea.
+ * Con --compact el modelo se carga en formato CompactModel (arena contigua) y se
+ * simula con CompactSimulator, pensado para máquinas con millones de transiciones.
+ * Con --mmap-tape el fichero de cadenas es una única entrada que se proyecta en
+ * memoria como cinta 0; la cinta final se vuelca a --tape-out (TapeOut.txt).
+ * Con --output-tapes/--output-mode se elige qué cintas (y qué tramo) se escriben
+ * como resultado; con --verdict-only solo se escribe el veredicto.
+ * Con --pipeline la cinta 0 final de cada MT pasa directamente a la siguiente, y
+ * cada etapa se ejecuta en su propio hilo.
+ * Con --block-size k las MT de una cinta se simulan con BlockSimulator (bloques de k
+ * celdas con recorridos memorizados).
+ * Con --schedule las cadenas se intercalan en cuantos de --quantum pasos (Scheduler),
+ * de modo que las cortas terminan enseguida aunque haya largas en vuelo; los
+ * resultados se reordenan para que FileOut.txt conserve el orden del fichero.
+ * Con --prefix-sharing las cadenas se ordenan y los prefijos comunes se simulan una
+ * sola vez (PrefixSharing); FileOut.txt conserva el orden del fichero.
+ * Con --census n no se lee ningún fichero de cadenas: se clasifican en paralelo
+ * todas las cadenas del alfabeto de entrada de longitud 0..n (Census).
+ * Con --busy-beaver n no se lee ninguna MT: se enumeran en paralelo las MT de n
+ * estados en forma normal de árbol (BusyBeaver) y se guardan los campeones.
+ * Con --shard i/N solo se procesan las cadenas de esa parte del lote y los resultados,
+ * precedidos de su índice, van a FileOut-<i>-of-<N>.txt; "--merge <ficheros...>" los
+ * junta en FileOut.txt en el orden original. Con --model-cache el modelo compacto se
+ * compila una vez a disco y los demás procesos lo proyectan en memoria compartida.
+ * Con --stream-tape la cinta 0 se alimenta poco a poco desde el fichero, una FIFO o
+ * stdin y la MT decide en cuanto puede; con --schedule fair cada línea del fichero de
+ * cadenas es un origen y las ejecuciones sin entrada ceden el turno.
+ * Con --lazy-load solo se indexan las líneas de transición por estado origen y las de
+ * cada estado se parsean la primera vez que la simulación entra en él.
+ * Salvo con --no-telemetry, se mide el lote (tiempos por fase, histogramas de tiempo
+ * y pasos por cadena, memoria) y al terminar se vuelca en --metrics (metrics.prom);
+ * con --perf-counters se añaden los contadores hardware por fase, paso y veredicto.
+ * 
+ * @param args Argumentos de línea de comandos ya validados.
+ * @return 0 si la ejecución fue exitosa, 1 si hubo error abriendo ficheros,
+ *         3 si la ejecución se suspendió y se guardó una instantánea
+ */
+int BatchRunner::run(const Args& args) {
+  if (args.getBusyBeaver() > 0) return runBusyBeaver(args);
+  BatchTelemetry telemetry(args.getTelemetry(), args.getProgressSeconds());
+  std::unique_ptr<PerfCounters> perfCounters;
+  if (args.getPerfCounters()) {
+    perfCounters.reset(new PerfCounters());
+    if (!perfCounters->isAvailable()) {
+      std::cerr << "--perf-counters: no se pudo abrir ningún contador hardware (" << perfCounters->getError()
+                << "); se continúa sin ellos" << std::endl;
+    }
+    for (int e = 0; e < PerfCounters::EVENT_COUNT && perfCounters->isAvailable(); ++e) {
+      PerfCounters::Event event = static_cast<PerfCounters::Event>(e);
+      if (!perfCounters->isOpen(event)) {
+        std::cerr << "--perf-counters: evento " << PerfCounters::eventName(event) << " no disponible" << std::endl;
+      }
+    }
+    telemetry.setPerfCounters(perfCounters.get());
+  }
+  BatchTelemetry::Clock::time_point phaseStart = telemetry.now();
+  BatchOptions options;
+  options.optimize = args.getOptimize();
+  options.compact = args.getCompact();
+  options.lazyLoad = args.getLazyLoad();
+  options.fuseChains = args.getFuseChains() && args.getPipeline().empty() && args.getMatrix().empty();
+  options.blockSize = args.getBlockSize();
+  options.maxSteps = args.getMaxSteps();
+  options.modelCache = args.getModelCache();
+  options.transitionsOnly = args.getCompact() ? "--compact" : args.getCensus() >= 0 ? "--census" :
+                            args.getMappedTape() ? "--mmap-tape" : args.getBlockSize() > 0 ? "--block-size" : "";
+  BatchRunner runner(options);
+  try {
+    runner.loadFile(args.getMtFile());
+  } catch (const std::exception& error) {
+    std::cerr << error.what() << std::endl;
+    return 1;
+  }
+  if (runner.cacheRebuilt_) std::cerr << "Modelo compilado en la caché " << args.getModelCache() << std::endl;
+  TuringMachineModel& model = runner.model_;
+  CompactModel& compactModel = runner.compactModel_;
+  TuringMachineSimulator& simulator = runner.simulator_;
+  telemetry.addPhase(BatchTelemetry::Phase::PARSE, phaseStart);
+  try {
+    runner.setProjection(ResultProjection(args.getOutputTapes(), ResultProjection::parseMode(args.getOutputMode()),
+                                          args.getVerdictOnly()));
+    if (args.getPipeline().empty() && args.getCensus() < 0) {
+      runner.getProjection().checkTapes(runner.getTapeCount(), args.getMtFile());
+    }
+  } catch (const std::runtime_error& error) {
+    std::cerr << error.what() << std::endl;
+    return 1;
+  }
+  const ResultProjection& projection = runner.getProjection();
+  if (args.getInfo()) {
+    std::cout << "\n" << std::string(120, '=') << "\n";
+    std::cout << "INFORMACIÓN DE LA MÁQUINA DE TURING\n";
+    std::cout << std::string(120, '=') << "\n";
+    if (args.getCompact()) std::cout << compactModel << "\n";
+    else std::cout << model << "\n";
+    if (args.getOptimize() && args.getModelCache().empty()) std::cout << runner.optimizer_.getSummary();
+    std::cout << std::string(120, '=') << "\n\n";
+  }
+  if (args.getCensus() >= 0) {
+    if (!args.getCompact()) {
+      try {
+        compactModel = CompactModel::fromModel(model);
+      } catch (const std::runtime_error& error) {
+        std::cerr << error.what() << std::endl;
+        return 1;
+      }
+    }
+    return runCensus(args, compactModel);
+  }
+  if (args.getMappedTape()) {
+    long long steps = 0;
+    bool accepted = false;
+    try {
+      MappedTape tape0(args.getStringsFile());
+      phaseStart = telemetry.now();
+      accepted = simulator.computeOnMappedTape(tape0, steps) == RunStatus::ACCEPTED;
+      telemetry.recordString(phaseStart, steps, accepted);
+      phaseStart = telemetry.now();
+      tape0.writeTo(args.getTapeOutFile());
+    } catch (const std::runtime_error& error) {
+      std::cerr << error.what() << std::endl;
+      return 1;
+    }
+    std::ofstream resultFile("FileOut.txt");
+    resultFile << args.getStringsFile() << ": " << (accepted ? "ACEPTADA" : "RECHAZADA")
+               << " -> Resultado en: " << args.getTapeOutFile() << " (" << steps << " pasos)\n";
+    resultFile.close();
+    telemetry.addPhase(BatchTelemetry::Phase::WRITE, phaseStart);
+    writeMetrics(telemetry, args.getMetricsFile());
+    std::cout << "Resultados guardados en FileOut.txt\n";
+    return 0;
+  }
+  if (args.getStreamTape() && args.getSchedule().empty()) return runStream(args, simulator, projection, telemetry);
+  std::ifstream inputStrings(args.getStringsFile());
+  if (!inputStrings.is_open()) {
+    std::cerr << "No se pudo abrir el archivo de cadenas: " << args.getStringsFile() << std::endl;
+    return 1;
+  }
+  if (!args.getPipeline().empty()) return runPipeline(args, model, projection, telemetry, inputStrings);
+  if (!args.getMatrix().empty()) return runMatrix(args, model, projection, telemetry, inputStrings);
+  const std::unique_ptr<ChainFusion>& fusion = runner.fusion_;
+  if (args.getPrefixSharing()) {
+    int code = runPrefixSharing(args, simulator, projection, telemetry, inputStrings);
+    if (fusion) std::cout << *fusion << "\n";
+    if (model.getLazyIndex()) std::cout << *model.getLazyIndex() << "\n";
+    return code;
+  }
+  const Shard& shard = args.getShard();
+  const std::string resultPath = shard.getOutputPath();
+  Snapshot resumeSnapshot;
+  bool resuming = !args.getResumeFile().empty();
+  if (resuming) {
+    try {
+      resumeSnapshot = Snapshot::load(args.getResumeFile(), model.determineTapeCount());
+      if (resumeSnapshot.getFingerprint() != model.fingerprint()) {
+        throw std::runtime_error("La instantánea " + args.getResumeFile() + " no corresponde a la MT " +
+                                 args.getMtFile());
+      }
+      resumeSnapshot.checkModel(model);
+      checkResumePosition(resumeSnapshot, inputStrings, resultPath);
+    } catch (const std::runtime_error& error) {
+      std::cerr << error.what() << std::endl;
+      return 1;
+    }
+    if (truncate(resultPath.c_str(), resumeSnapshot.getResultOffset()) != 0) {
+      std::cerr << "No se pudo recortar FileOut.txt para reanudar la ejecución" << std::endl;
+      return 1;
+    }
+  }
+  std::unique_ptr<Checkpointer> checkpointer;
+  if (!args.getCheckpointFile().empty()) {
+    checkpointer.reset(new Checkpointer(args.getCheckpointFile(), args.getCheckpointSteps(),
+                                        args.getCheckpointSeconds(), model.fingerprint()));
+    checkpointer->installSignalHandlers();
+    simulator.setCheckpointer(checkpointer.get());
+  }
+  std::ofstream resultFile(resultPath, resuming ? std::ios::app : std::ios::trunc);
+  uint64_t resultOffset = resuming ? resumeSnapshot.getResultOffset() : 0;
+  uint64_t inputIndex = 0;
+  simulator.setTraceFilter(&args.getTraceFilter());
+  const std::unique_ptr<BlockSimulator>& blockSimulator = runner.blockSimulator_;
+  std::unique_ptr<Scheduler> scheduler;
+  std::map<uint64_t, std::string> pendingLines;
+  Scheduler::Sink finish = [&](Execution& execution) {
+    bool accepted = execution.getStatus() == RunStatus::ACCEPTED;
+    telemetry.recordString(execution.getStarted(), execution.getSteps(), accepted);
+    BatchTelemetry::Clock::time_point writeStart = telemetry.now();
+    std::string& line = pendingLines[execution.getIndex()];
+    line.assign(shard.linePrefix(execution.getIndex())).append(execution.getInput()).append(": ");
+    appendResult(line, accepted, projection, execution.getResult());
+    while (!pendingLines.empty() && !pendingLines.begin()->second.empty()) {
+      resultFile << pendingLines.begin()->second;
+      pendingLines.erase(pendingLines.begin());
+    }
+    telemetry.addPhase(BatchTelemetry::Phase::WRITE, writeStart);
+  };
+  if (!args.getSchedule().empty()) {
+    scheduler.reset(new Scheduler(simulator, Scheduler::parsePolicy(args.getSchedule()), args.getQuantum(),
+                                  args.getInFlight()));
+  }
+  std::string inputString;
+  std::string resultLine;
+  RunContext context;
+  while (std::getline(inputStrings, inputString)) {
+    if (inputString.empty()) continue;
+    uint64_t index = inputIndex++;
+    if (resuming && index < resumeSnapshot.getInputIndex()) continue;
+    if (!shard.owns(index, inputString)) continue;
+    context.load(inputString);
+    bool trace = args.getTrace() && args.getTraceFilter().matchesString(inputString);
+    if (trace) {
+      context.resetTrace();
+      std::cout << "\n" << std::string(120, '=') << "\n";
+      std::cout << "PROCESANDO CADENA: \"" << inputString << "\"\n";
+      std::cout << std::string(120, '=') << "\n";
+    }
+    resultLine.assign(shard.linePrefix(index)).append(inputString).append(": ");
+    if (args.getCompact() || blockSimulator) {
+      long long steps = 0;
+      size_t verdictAt = resultLine.size();
+      resultLine.append(projection.isVerdictOnly() ? "" : " -> Resultado: ");
+      phaseStart = telemetry.now();
+      bool accepted = runner.simulate(context.getInput(), steps, resultLine) == RunStatus::ACCEPTED;
+      telemetry.recordString(phaseStart, steps, accepted);
+      phaseStart = telemetry.now();
+      resultLine.insert(verdictAt, accepted ? "ACEPTADA" : "RECHAZADA");
+      resultLine.push_back('\n');
+      resultFile << resultLine;
+      telemetry.addPhase(BatchTelemetry::Phase::WRITE, phaseStart);
+      continue;
+    }
+    if (scheduler) {
+      pendingLines.emplace(index, std::string());
+      if (args.getStreamTape()) {
+        try {
+          scheduler->admit(index, inputString, std::unique_ptr<StreamTape>(new StreamTape(inputString, args.getStreamFollow())));
+        } catch (const std::runtime_error& error) {
+          std::cerr << error.what() << std::endl;
+          return 1;
+        }
+      } else {
+        scheduler->admit(index, inputString, String(context.getInput()));
+      }
+      while (scheduler->isFull()) scheduler->runQuantum(finish);
+      continue;
+    }
+    Configuration& configuration = context.getConfiguration();
+    if (resuming && index == resumeSnapshot.getInputIndex()) {
+      configuration = resumeSnapshot.getConfiguration();
+    } else {
+      simulator.start(context);
+    }
+    if (checkpointer) checkpointer->beginInput(index, inputString, resultOffset);
+    phaseStart = telemetry.now();
+    RunStatus status = simulator.run(context, trace, context.getTrace());
+    if (status == RunStatus::SUSPENDED) {
+      telemetry.addPhase(BatchTelemetry::Phase::SIMULATE, phaseStart);
+      writeMetrics(telemetry, args.getMetricsFile());
+      checkpointer->save(configuration);
+      std::cout << context.getTrace().str();
+      std::cerr << "Ejecución suspendida en la cadena " << index << " (paso " << configuration.getSteps()
+                << "). Instantánea guardada en " << checkpointer->getPath() << std::endl;
+      return 3;
+    }
+    bool accepted = status == RunStatus::ACCEPTED;
+    telemetry.recordString(phaseStart, configuration.getSteps(), accepted);
+    phaseStart = telemetry.now();
+    size_t projectionAt = appendResult(resultLine, accepted, projection, configuration);
+    resultFile << resultLine;
+    if (checkpointer) resultFile.flush();
+    resultOffset += resultLine.size();
+    telemetry.addPhase(BatchTelemetry::Phase::WRITE, phaseStart);
+    if (trace) {
+      std::cout << context.getTrace().str();
+      std::cout << "\n" << std::string(120, '=') << "\n";
+      std::cout << "RESULTADO FINAL: " << inputString << " -> " << (accepted ? "✓ ACEPTADA" : "✗ RECHAZADA") << "\n";
+      if (!projection.isVerdictOnly()) {
+        std::cout << "Cinta resultante: " << resultLine.substr(projectionAt, resultLine.size() - projectionAt - 1) << "\n";
+      }
+      std::cout << std::string(120, '=') << "\n\n";
+    }
+  }
+  if (scheduler) scheduler->drain(finish);
+  if (checkpointer) std::remove(checkpointer->getPath().c_str());
+  inputStrings.close();
+  resultFile.close();
+  writeMetrics(telemetry, args.getMetricsFile());
+  if (!args.getTrace()) {
+    std::cout << "Resultados guardados en " << resultPath << "\n";
+  }
+  if (blockSimulator) std::cout << *blockSimulator << "\n";
+  if (fusion) std::cout << *fusion << "\n";
+  if (scheduler) std::cout << *scheduler << "\n";
+  if (model.getLazyIndex()) std::cout << *model.getLazyIndex() << "\n";
+  return 0;
+}
@@ -0,0 +1,73 @@
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "arg_parser.h"
+#include "block_simulator.h"
+#include "chain_fusion.h"
+#include "compact_model.h"
+#include "compact_simulator.h"
+#include "machine_optimizer.h"
+#include "result_projection.h"
+#include "symbol.h"
+#include "turing_machine_model.h"
+#include "turing_machine_simulator.h"
+
+/**
+ * @brief Motor con el que se simulan las cadenas de un lote.
+ */
+struct BatchOptions {
+  bool optimize = false;       // MachineOptimizer antes de simular
+  bool compact = false;        // CompactModel y CompactSimulator
+  bool lazyLoad = false;       // transiciones parseadas por estado al visitarlo (solo desde fichero)
+  bool fuseChains = false;     // superinstrucciones (ChainFusion)
+  int blockSize = 0;           // BlockSimulator con bloques de blockSize celdas (0: no)
+  long long maxSteps = TuringMachineSimulator::DEFAULT_MAX_STEPS;
+  std::string modelCache;      // caché en disco del modelo compacto (--model-cache)
+  std::string transitionsOnly; // opción que solo admite transiciones (sin operaciones nativas), o vacío
+};
+
+/**
+ * @brief Carga una MT y simula lotes de cadenas con el motor elegido.
+ *
+ * Es el punto de entrada común del ejecutable y de la API C: load() parsea la
+ * MT según BatchOptions (modelo normal, perezoso, optimizado, compacto o desde
+ * la caché) y prepara el motor (simulador, fusión de cadenas o bloques), y
+ * simulate() ejecuta una cadena con él y escribe la proyección de sus cintas.
+ * run() es el programa completo de línea de comandos: elige el modo a partir de
+ * los argumentos (instantáneas, planificador, shards, pipeline, matriz,
+ * prefijos compartidos, censo, streaming, castores afanosos...) y escribe
+ * FileOut.txt. Los simuladores guardan referencias al modelo, así que un
+ * BatchRunner no se copia.
+ */
+class BatchRunner {
+ public:
+  explicit BatchRunner(const BatchOptions& options);
+  BatchRunner(const BatchRunner&) = delete;
+  BatchRunner& operator=(const BatchRunner&) = delete;
+  void loadFile(const std::string& path);
+  void loadBuffer(const std::string& text);
+  int getTapeCount() const;
+  void setProjection(const ResultProjection& projection) { projection_ = projection; }
+  const ResultProjection& getProjection() const { return projection_; }
+  void setMaxSteps(long long maxSteps);
+  RunStatus simulate(const std::vector<Symbol>& input, long long& steps, std::string& output);
+  static int run(const Args& args);
+ private:
+  void adopt(TuringMachineModel model);
+  BatchOptions options_;
+  TuringMachineModel model_;
+  CompactModel compactModel_;
+  MachineOptimizer optimizer_;
+  bool cacheRebuilt_;
+  TuringMachineSimulator simulator_;
+  CompactSimulator compactSimulator_;
+  std::unique_ptr<ChainFusion> fusion_;
+  std::unique_ptr<BlockSimulator> blockSimulator_;
+  ResultProjection projection_;
+  Configuration configuration_;
+};
+
+#endif
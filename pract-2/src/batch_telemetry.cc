@@ -0,0 +1,252 @@
+#include "batch_telemetry.h"
+#include <fstream>
+#include <iostream>
+#include <sys/resource.h>
+#include "alloc_counter.h"
+
+namespace {
+
+const char* const kPhaseNames[] = {"parse", "simulate", "write"};
+const char* const kResultNames[] = {"accepted", "rejected"};
+const double kQuantiles[] = {0.5, 0.9, 0.99, 0.999};
+
+double seconds(std::chrono::nanoseconds duration) {
+  return std::chrono::duration<double>(duration).count();
+}
+
+/**
+ * @brief Pico de memoria residente del proceso en bytes (getrusage da KiB en Linux).
+ */
+uint64_t peakRssBytes() {
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+  return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+}
+
+/**
+ * @brief Escribe las líneas HELP y TYPE de una métrica.
+ */
+void writeHeader(std::ostream& os, const std::string& name, const std::string& type, const std::string& help) {
+  os << "# HELP " << name << " " << help << "\n";
+  os << "# TYPE " << name << " " << type << "\n";
+}
+
+/**
+ * @brief Escribe un histograma como métrica de tipo summary de Prometheus.
+ */
+void writeSummary(std::ostream& os, const std::string& name, const std::string& help,
+                  const Histogram& histogram, double scale) {
+  writeHeader(os, name, "summary", help);
+  for (double q : kQuantiles) {
+    os << name << "{quantile=\"" << q << "\"} " << histogram.quantile(q) * scale << "\n";
+  }
+  os << name << "_sum " << histogram.getSum() * scale << "\n";
+  os << name << "_count " << histogram.getCount() << "\n";
+}
+
+}  // namespace
+
+/**
+ * @brief Constructor: empieza a contar el tiempo total del lote.
+ *
+ * @param enabled Si es false ninguna operación hace nada (ni siquiera leer el reloj).
+ * @param progressSeconds Cada cuántos segundos se escribe una línea de progreso (0 para nunca).
+ */
+BatchTelemetry::BatchTelemetry(bool enabled, double progressSeconds)
+  : enabled_(enabled),
+    progressInterval_(std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::duration<double>(progressSeconds))),
+    start_(Clock::now()), lastProgress_(start_), lastAllocations_(AllocCounter::getAllocations()),
+    accepted_(0), rejected_(0), perf_(nullptr) {
+  for (auto& phase : phases_) phase = std::chrono::nanoseconds(0);
+}
+
+/**
+ * @brief Suma al total de una fase el tiempo transcurrido desde un instante.
+ *
+ * Al cerrar la fase de parseo se toma la referencia de reservas de memoria
+ * para la primera cadena.
+ *
+ * @param phase Fase a la que se imputa el tiempo.
+ * @param since Instante de inicio (obtenido con now()).
+ */
+void BatchTelemetry::addPhase(Phase phase, Clock::time_point since) {
+  if (!enabled_) return;
+  phases_[static_cast<int>(phase)] += Clock::now() - since;
+  if (perf_ != nullptr) {
+    PerfCounters::Sample delta;
+    perf_->readDelta(delta);
+    perfPhases_[static_cast<int>(phase)] += delta;
+  }
+  if (phase == Phase::PARSE) lastAllocations_ = AllocCounter::getAllocations();
+}
+
+/**
+ * @brief Registra una cadena simulada e imputa su tiempo a la fase de simulación.
+ *
+ * @param since Instante en el que empezó su simulación (obtenido con now()).
+ * @param steps Pasos ejecutados.
+ * @param accepted Veredicto.
+ */
+void BatchTelemetry::recordString(Clock::time_point since, long long steps, bool accepted) {
+  if (!enabled_) return;
+  Clock::time_point end = Clock::now();
+  std::chrono::nanoseconds elapsed = end - since;
+  phases_[static_cast<int>(Phase::SIMULATE)] += elapsed;
+  nanos_.record(elapsed.count());
+  steps_.record(steps < 0 ? 0 : steps);
+  uint64_t allocations = AllocCounter::getAllocations();
+  allocations_.record(allocations - lastAllocations_);
+  lastAllocations_ = allocations;
+  if (accepted) accepted_++;
+  else rejected_++;
+  if (perf_ != nullptr) {
+    PerfCounters::Sample delta;
+    perf_->readDelta(delta);
+    perfPhases_[static_cast<int>(Phase::SIMULATE)] += delta;
+    perfResults_[accepted ? 0 : 1] += delta;
+  }
+  if (progressInterval_.count() > 0 && end - lastProgress_ >= progressInterval_) reportProgress(end);
+}
+
+/**
+ * @brief Activa la imputación de contadores hardware a fases y veredictos.
+ *
+ * Se llama antes de la primera fase: lo contado hasta entonces no se imputa.
+ *
+ * @param counters Contadores ya abiertos (nullptr para desactivarlo); deben vivir más que la telemetría.
+ */
+void BatchTelemetry::setPerfCounters(PerfCounters* counters) {
+  perf_ = enabled_ && counters != nullptr && counters->isAvailable() ? counters : nullptr;
+  if (perf_ != nullptr) {
+    PerfCounters::Sample discarded;
+    perf_->readDelta(discarded);
+  }
+}
+
+/**
+ * @brief Escribe en stderr una línea con el progreso acumulado.
+ *
+ * @param now Instante actual.
+ */
+void BatchTelemetry::reportProgress(Clock::time_point now) {
+  lastProgress_ = now;
+  double elapsed = seconds(now - start_);
+  double simulate = seconds(phases_[static_cast<int>(Phase::SIMULATE)]);
+  std::cerr << "[progreso] " << nanos_.getCount() << " cadenas en " << elapsed << " s ("
+            << nanos_.getCount() / elapsed << " cadenas/s, "
+            << (simulate > 0 ? steps_.getSum() / simulate : 0) << " pasos/s, p99 "
+            << nanos_.quantile(0.99) / 1e6 << " ms/cadena";
+  if (AllocCounter::isInstalled()) {
+    std::cerr << ", " << static_cast<double>(allocations_.getSum()) / allocations_.getCount() << " reservas/cadena";
+  }
+  std::cerr << ")" << std::endl;
+}
+
+/**
+ * @brief Vuelca todas las métricas en formato de texto de Prometheus.
+ *
+ * @param os Stream de salida.
+ */
+void BatchTelemetry::writePrometheus(std::ostream& os) const {
+  double elapsed = seconds(Clock::now() - start_);
+  double simulate = seconds(phases_[static_cast<int>(Phase::SIMULATE)]);
+  std::streamsize precision = os.precision(12);
+  writeHeader(os, "tm_strings_total", "counter", "Cadenas simuladas por veredicto.");
+  os << "tm_strings_total{result=\"accepted\"} " << accepted_ << "\n";
+  os << "tm_strings_total{result=\"rejected\"} " << rejected_ << "\n";
+  writeHeader(os, "tm_steps_total", "counter", "Pasos de MT ejecutados en el lote.");
+  os << "tm_steps_total " << steps_.getSum() << "\n";
+  writeSummary(os, "tm_string_duration_seconds", "Tiempo de pared de simulación por cadena.", nanos_, 1e-9);
+  writeSummary(os, "tm_string_steps", "Pasos ejecutados por cadena.", steps_, 1);
+  writeHeader(os, "tm_phase_seconds", "gauge", "Tiempo total por fase del lote.");
+  for (int i = 0; i < 3; ++i) {
+    os << "tm_phase_seconds{phase=\"" << kPhaseNames[i] << "\"} " << seconds(phases_[i]) << "\n";
+  }
+  writeHeader(os, "tm_batch_seconds", "gauge", "Tiempo de pared total del lote.");
+  os << "tm_batch_seconds " << elapsed << "\n";
+  writeHeader(os, "tm_steps_per_second", "gauge", "Pasos por segundo de simulación.");
+  os << "tm_steps_per_second " << (simulate > 0 ? steps_.getSum() / simulate : 0) << "\n";
+  writeHeader(os, "tm_strings_per_second", "gauge", "Cadenas por segundo de pared.");
+  os << "tm_strings_per_second " << (elapsed > 0 ? nanos_.getCount() / elapsed : 0) << "\n";
+  if (AllocCounter::isInstalled()) {
+    writeSummary(os, "tm_string_allocations", "Reservas de memoria dinámica por cadena.", allocations_, 1);
+    writeHeader(os, "tm_allocations_total", "counter", "Reservas de memoria dinámica del proceso.");
+    os << "tm_allocations_total " << AllocCounter::getAllocations() << "\n";
+    writeHeader(os, "tm_allocated_bytes_total", "counter", "Bytes reservados en memoria dinámica por el proceso.");
+    os << "tm_allocated_bytes_total " << AllocCounter::getBytes() << "\n";
+  }
+  writeHeader(os, "tm_peak_rss_bytes", "gauge", "Pico de memoria residente del proceso.");
+  os << "tm_peak_rss_bytes " << peakRssBytes() << "\n";
+  if (perf_ != nullptr) writePerfCounters(os);
+  os.precision(precision);
+}
+
+/**
+ * @brief Vuelca los contadores hardware: totales por fase y veredicto, por paso y por cadena.
+ *
+ * Los eventos que no se pudieron abrir se omiten.
+ *
+ * @param os Stream de salida.
+ */
+void BatchTelemetry::writePerfCounters(std::ostream& os) const {
+  const uint64_t strings[2] = {accepted_, rejected_};
+  const double steps = static_cast<double>(steps_.getSum());
+  writeHeader(os, "tm_perf_events_total", "counter", "Eventos de los contadores hardware por fase del lote.");
+  for (int e = 0; e < PerfCounters::EVENT_COUNT; ++e) {
+    PerfCounters::Event event = static_cast<PerfCounters::Event>(e);
+    if (!perf_->isOpen(event)) continue;
+    for (int i = 0; i < 3; ++i) {
+      os << "tm_perf_events_total{phase=\"" << kPhaseNames[i] << "\",event=\"" << PerfCounters::eventName(event)
+         << "\"} " << perfPhases_[i].values[e] << "\n";
+    }
+  }
+  writeHeader(os, "tm_perf_events_per_step", "gauge", "Eventos hardware de la fase de simulación por paso de MT.");
+  for (int e = 0; e < PerfCounters::EVENT_COUNT; ++e) {
+    PerfCounters::Event event = static_cast<PerfCounters::Event>(e);
+    if (!perf_->isOpen(event)) continue;
+    os << "tm_perf_events_per_step{event=\"" << PerfCounters::eventName(event) << "\"} "
+       << (steps > 0 ? perfPhases_[static_cast<int>(Phase::SIMULATE)].values[e] / steps : 0) << "\n";
+  }
+  writeHeader(os, "tm_perf_string_events_total", "counter", "Eventos hardware de simulación por veredicto.");
+  for (int e = 0; e < PerfCounters::EVENT_COUNT; ++e) {
+    PerfCounters::Event event = static_cast<PerfCounters::Event>(e);
+    if (!perf_->isOpen(event)) continue;
+    for (int r = 0; r < 2; ++r) {
+      os << "tm_perf_string_events_total{result=\"" << kResultNames[r] << "\",event=\""
+         << PerfCounters::eventName(event) << "\"} " << perfResults_[r].values[e] << "\n";
+    }
+  }
+  writeHeader(os, "tm_perf_events_per_string", "gauge", "Eventos hardware de simulación por cadena de cada veredicto.");
+  for (int e = 0; e < PerfCounters::EVENT_COUNT; ++e) {
+    PerfCounters::Event event = static_cast<PerfCounters::Event>(e);
+    if (!perf_->isOpen(event)) continue;
+    for (int r = 0; r < 2; ++r) {
+      os << "tm_perf_events_per_string{result=\"" << kResultNames[r] << "\",event=\""
+         << PerfCounters::eventName(event) << "\"} "
+         << (strings[r] > 0 ? static_cast<double>(perfResults_[r].values[e]) / strings[r] : 0) << "\n";
+    }
+  }
+  if (perf_->isOpen(PerfCounters::CYCLES) && perf_->isOpen(PerfCounters::INSTRUCTIONS)) {
+    const PerfCounters::Sample& simulate = perfPhases_[static_cast<int>(Phase::SIMULATE)];
+    writeHeader(os, "tm_perf_instructions_per_cycle", "gauge", "Instrucciones por ciclo en la fase de simulación.");
+    os << "tm_perf_instructions_per_cycle "
+       << (simulate.values[PerfCounters::CYCLES] > 0
+           ? static_cast<double>(simulate.values[PerfCounters::INSTRUCTIONS]) / simulate.values[PerfCounters::CYCLES]
+           : 0) << "\n";
+  }
+}
+
+/**
+ * @brief Vuelca las métricas en un fichero (lo sobrescribe).
+ *
+ * @param path Ruta del fichero.
+ * @return true si se pudo escribir.
+ */
+bool BatchTelemetry::writePrometheus(const std::string& path) const {
+  if (!enabled_) return true;
+  std::ofstream out(path, std::ios::trunc);
+  if (!out.is_open()) return false;
+  writePrometheus(out);
+  return static_cast<bool>(out);
+}
@@ -0,0 +1,60 @@
+#ifndef BATCH_TELEMETRY_H
+#define BATCH_TELEMETRY_H
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include "histogram.h"
+#include "perf_counters.h"
+
+/**
+ * @brief Telemetría de rendimiento de un lote de cadenas.
+ *
+ * Acumula el tiempo de cada fase (parseo, simulación y escritura), histogramas
+ * HDR del tiempo de pared y de los pasos de cada cadena, y los veredictos. Cada
+ * cadena cuesta dos lecturas del reloj y dos registros O(1) en histogramas, lo
+ * bastante poco como para dejarla activa por defecto. En lotes largos escribe
+ * líneas de progreso periódicas en stderr y al terminar vuelca las métricas en
+ * formato de texto de Prometheus. Si el programa cuenta las reservas de memoria
+ * (AllocCounter), registra también cuántas hace cada cadena: las hechas desde la
+ * cadena anterior o, para la primera, desde el final del parseo.
+ *
+ * Con setPerfCounters() (--perf-counters) cada addPhase() y recordString()
+ * imputan a su fase lo que han contado los contadores hardware desde la
+ * lectura anterior, y recordString() también al veredicto de la cadena; al
+ * volcar se publican los totales por fase y por veredicto, por paso simulado
+ * y por cadena.
+ */
+class BatchTelemetry {
+ public:
+  enum class Phase { PARSE, SIMULATE, WRITE };
+  typedef std::chrono::steady_clock Clock;
+  BatchTelemetry(bool enabled, double progressSeconds);
+  bool isEnabled() const { return enabled_; }
+  Clock::time_point now() const { return enabled_ ? Clock::now() : Clock::time_point(); }
+  void addPhase(Phase phase, Clock::time_point since);
+  void recordString(Clock::time_point since, long long steps, bool accepted);
+  void setPerfCounters(PerfCounters* counters);
+  void writePrometheus(std::ostream& os) const;
+  bool writePrometheus(const std::string& path) const;
+ private:
+  void reportProgress(Clock::time_point now);
+  void writePerfCounters(std::ostream& os) const;
+  bool enabled_;
+  std::chrono::nanoseconds progressInterval_;
+  Clock::time_point start_;
+  Clock::time_point lastProgress_;
+  std::chrono::nanoseconds phases_[3];
+  Histogram nanos_;
+  Histogram steps_;
+  Histogram allocations_;
+  uint64_t lastAllocations_;
+  uint64_t accepted_;
+  uint64_t rejected_;
+  PerfCounters* perf_;
+  PerfCounters::Sample perfPhases_[3];
+  PerfCounters::Sample perfResults_[2];
+};
+
+#endif
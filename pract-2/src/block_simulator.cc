@@ -0,0 +1,337 @@
+#include "block_simulator.h"
+#include <algorithm>
+#include <deque>
+#include <stdexcept>
+#include "turing_machine_simulator.h"
+
+namespace {
+
+// Pasos máximos al memorizar un recorrido; si no sale antes, se simula sin memoria.
+const long long kMemoBudget = 1 << 16;
+
+int64_t floorDiv(int64_t value, int64_t divisor) {
+  return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+}  // namespace
+
+/**
+ * @brief Constructor del motor de bloques.
+ * 
+ * @param model Modelo de la MT (debe tener una sola cinta).
+ * @param blockSize Número de celdas por bloque (k).
+ * @throws std::runtime_error si la MT tiene más de una cinta u operaciones nativas,
+ *         k no es positivo o hay demasiados estados para la clave de memoria.
+ */
+BlockSimulator::BlockSimulator(const TuringMachineModel& model, int blockSize)
+  : model_(model), blockSize_(blockSize), maxSteps_(TuringMachineSimulator::DEFAULT_MAX_STEPS),
+    initialState_(0), hits_(0), misses_(0), fallbacks_(0), runBlocks_(0) {
+  if (blockSize_ <= 0) throw std::runtime_error("El tamaño de bloque debe ser positivo");
+  if (model_.determineTapeCount() != 1) {
+    throw std::runtime_error("El motor de bloques solo admite MT de una cinta (esta tiene " +
+                             std::to_string(model_.determineTapeCount()) + ")");
+  }
+  if (!model_.getBuiltins().empty()) {
+    throw std::runtime_error("El motor de bloques no admite operaciones nativas (estado " +
+                             model_.getBuiltins().begin()->first + ")");
+  }
+  for (const auto& statePair : model_.getStates()) stateNames_.push_back(statePair.first);
+  std::sort(stateNames_.begin(), stateNames_.end());
+  if (stateNames_.size() >= (1u << 20)) throw std::runtime_error("Demasiados estados para el motor de bloques");
+  for (uint32_t i = 0; i < stateNames_.size(); ++i) {
+    stateIds_[stateNames_[i]] = i;
+    const State& state = model_.getStateById(stateNames_[i]);
+    accept_.push_back(state.isAccept());
+    dead_.push_back(state.isDead());
+  }
+  auto initial = stateIds_.find(model_.getInitialStateId());
+  if (initial == stateIds_.end()) {
+    throw std::runtime_error("No se pudo obtener el estado inicial de la máquina: " + model_.getInitialStateId());
+  }
+  initialState_ = initial->second;
+}
+
+/**
+ * @brief Devuelve el id de macro-símbolo de un contenido de bloque, creándolo si es nuevo.
+ * 
+ * @param content Contenido del bloque (k celdas).
+ * @return Id del bloque.
+ */
+uint32_t BlockSimulator::intern(const std::string& content) {
+  auto it = blockIds_.find(content);
+  if (it != blockIds_.end()) return it->second;
+  uint32_t id = blocks_.size();
+  blocks_.push_back(content);
+  blockIds_[content] = id;
+  return id;
+}
+
+/**
+ * @brief Simula paso a paso dentro de un bloque hasta que el cabezal sale o la MT se detiene.
+ * 
+ * Sigue el mismo orden que TuringMachineSimulator::run(): comprueba aceptación y
+ * estado muerto, busca la transición, escribe, mueve, cuenta el paso y
+ * comprueba el límite. La posición final puede quedar fuera del bloque (-1 o k)
+ * si el último paso lo abandona.
+ * 
+ * @param state Estado al entrar en el bloque.
+ * @param block Id del contenido del bloque.
+ * @param position Celda del bloque bajo el cabezal.
+ * @param budget Pasos permitidos: se devuelve Exit::LIMIT al ejecutar el paso budget + 1.
+ * @return Recorrido realizado.
+ */
+BlockSimulator::Traversal BlockSimulator::traverse(uint32_t state, uint32_t block, int position, long long budget) {
+  std::string content = blocks_[block];
+  std::vector<Symbol> read(1, Symbol('.'));
+  Traversal result;
+  result.steps = 0;
+  result.minPosition = position;
+  result.maxPosition = position;
+  while (true) {
+    if (accept_[state]) {
+      result.exit = Exit::ACCEPT;
+      break;
+    }
+    if (dead_[state]) {
+      result.exit = Exit::REJECT;
+      break;
+    }
+    read[0] = Symbol(content[position]);
+    const Transition* transition = model_.findTransition(stateNames_[state], read);
+    if (transition == nullptr) {
+      result.exit = Exit::REJECT;
+      break;
+    }
+    const std::pair<Symbol, Moves>& action = transition->getTapeActions().begin()->second;
+    if (action.first.getValue() != Symbol::WILDCARD) content[position] = action.first.getValue();
+    if (action.second == Moves::LEFT) position--;
+    else if (action.second == Moves::RIGHT) position++;
+    state = stateIds_[transition->getTo().getId()];
+    result.steps++;
+    if (result.steps > budget) {
+      result.exit = Exit::LIMIT;
+      break;
+    }
+    if (position < 0) {
+      result.exit = Exit::LEFT;
+      break;
+    }
+    if (position >= blockSize_) {
+      result.exit = Exit::RIGHT;
+      break;
+    }
+    result.minPosition = std::min(result.minPosition, position);
+    result.maxPosition = std::max(result.maxPosition, position);
+  }
+  result.state = state;
+  result.position = position;
+  result.block = intern(content);
+  return result;
+}
+
+/**
+ * @brief Devuelve el recorrido memorizado de un estado que entra en un bloque.
+ * 
+ * @param state Estado al entrar.
+ * @param block Id del bloque.
+ * @param position Celda de entrada (0 por la izquierda, k - 1 por la derecha).
+ * @return Recorrido (Exit::LIMIT si no sale del bloque en kMemoBudget pasos).
+ */
+const BlockSimulator::Traversal& BlockSimulator::memoized(uint32_t state, uint32_t block, int position) {
+  uint64_t key = (static_cast<uint64_t>(block) << 21) | (static_cast<uint64_t>(state) << 1) | (position == 0 ? 0 : 1);
+  auto it = memo_.find(key);
+  if (it != memo_.end()) {
+    hits_++;
+    return it->second;
+  }
+  misses_++;
+  Traversal traversal = traverse(state, block, position, kMemoBudget);
+  return memo_.insert(std::make_pair(key, traversal)).first->second;
+}
+
+/**
+ * @brief Reescribe un tramo de bloques consecutivos de una serie.
+ * 
+ * Parte la serie si el tramo no la ocupa entera y la une con sus vecinas si
+ * quedan con el mismo bloque, para que la cinta siga comprimida.
+ * 
+ * @param runs Series de la cinta.
+ * @param run Serie que contiene el tramo (salida: la serie que lo contiene tras reescribirlo).
+ * @param start Bloque absoluto donde empieza esa serie (se actualiza igual que run).
+ * @param from Primer bloque absoluto del tramo.
+ * @param count Número de bloques del tramo.
+ * @param block Nuevo contenido de los bloques del tramo.
+ * @return La serie que contiene el tramo.
+ */
+BlockSimulator::Run& BlockSimulator::rewrite(std::deque<Run>& runs, size_t& run, int64_t& start, int64_t from, int64_t count,
+                             uint32_t block) const {
+  Run& current = runs[run];
+  uint32_t old = current.block;
+  if (old == block) return current;
+  int64_t before = from - start;
+  int64_t after = start + current.count - from - count;
+  current.block = block;
+  current.count = count;
+  if (after > 0) {
+    runs.insert(runs.begin() + run + 1, Run{old, after});
+  } else if (run + 1 < runs.size() && runs[run + 1].block == block) {
+    runs[run].count += runs[run + 1].count;
+    runs.erase(runs.begin() + run + 1);
+  }
+  if (before > 0) {
+    runs.insert(runs.begin() + run, Run{old, before});
+    run++;
+    start += before;
+  } else if (run > 0 && runs[run - 1].block == block) {
+    start -= runs[run - 1].count;
+    runs[run - 1].count += runs[run].count;
+    runs.erase(runs.begin() + run);
+    run--;
+  }
+  return runs[run];
+}
+
+/**
+ * @brief Simula la MT sobre una cadena de entrada, bloque a bloque.
+ * 
+ * Un recorrido que entra por un extremo del bloque, sale por el otro y deja la
+ * MT en el mismo estado se aplica a todos los bloques que quedan en su serie
+ * en esa dirección (tantos como quepan enteros en los pasos que quedan). Si la
+ * serie es el blanco de un extremo de la cinta, se alarga lo que haga falta.
+ * 
+ * @param input Cadena de entrada.
+ * @param configuration Configuración final (salida): estado, cinta 0 con la misma
+ *        extensión que en TuringMachineSimulator, cabezal y pasos.
+ * @return Motivo por el que se detuvo la ejecución.
+ */
+RunStatus BlockSimulator::run(const String& input, Configuration& configuration) {
+  const int64_t k = blockSize_;
+  std::string cells;
+  for (const auto& symbol : input.getSymbols()) cells.push_back(symbol.getValue());
+  if (cells.empty()) cells.push_back('.');
+  int64_t minCell = 0;
+  int64_t maxCell = cells.size() - 1;
+  cells.resize((cells.size() + k - 1) / k * k, '.');
+  uint32_t blank = intern(std::string(k, '.'));
+  std::deque<Run> runs;
+  for (size_t i = 0; i < cells.size(); i += k) {
+    uint32_t block = intern(cells.substr(i, k));
+    if (!runs.empty() && runs.back().block == block) runs.back().count++;
+    else runs.push_back(Run{block, 1});
+  }
+  int64_t firstBlock = 0;
+  size_t run = 0;
+  int64_t runStart = 0;
+  int64_t blockIndex = 0;
+  int position = 0;
+  uint32_t state = initialState_;
+  long long steps = 0;
+  RunStatus status = RunStatus::RUNNING;
+  while (status == RunStatus::RUNNING) {
+    Run& current = runs[run];
+    uint32_t block = current.block;
+    long long budget = maxSteps_ - steps;
+    Traversal traversal = memoized(state, block, position);
+    if (traversal.exit == Exit::LIMIT || traversal.steps > budget) {
+      fallbacks_++;
+      traversal = traverse(state, block, position, budget);
+    }
+    int64_t repeat = 1;
+    bool crosses = (traversal.exit == Exit::RIGHT && position == 0) || (traversal.exit == Exit::LEFT && position == k - 1);
+    if (crosses && traversal.state == state) {
+      bool right = traversal.exit == Exit::RIGHT;
+      int64_t ahead = right ? runStart + current.count - blockIndex : blockIndex - runStart + 1;
+      repeat = static_cast<int64_t>(budget / traversal.steps);
+      bool open = block == blank && (right ? run + 1 == runs.size() : run == 0);
+      if (open && repeat > ahead) {
+        current.count += repeat - ahead;
+        if (!right) {
+          firstBlock -= repeat - ahead;
+          runStart = firstBlock;
+        }
+      } else if (!open) repeat = std::min(repeat, ahead);
+      runBlocks_ += repeat - 1;
+    }
+    int64_t low = traversal.exit == Exit::LEFT ? blockIndex - repeat + 1 : blockIndex;
+    int64_t high = low + repeat - 1;
+    int64_t head = (traversal.exit == Exit::LEFT ? low : high) * k + traversal.position;
+    Run& written = rewrite(runs, run, runStart, low, repeat, traversal.block);
+    state = traversal.state;
+    steps += traversal.steps * repeat;
+    minCell = std::min({minCell, low * k + traversal.minPosition, head});
+    maxCell = std::max({maxCell, high * k + traversal.maxPosition, head});
+    switch (traversal.exit) {
+      case Exit::ACCEPT: status = RunStatus::ACCEPTED; break;
+      case Exit::REJECT: status = RunStatus::REJECTED; break;
+      case Exit::LIMIT: status = RunStatus::STEP_LIMIT; break;
+      case Exit::LEFT:
+        blockIndex = low - 1;
+        position = k - 1;
+        break;
+      case Exit::RIGHT:
+        blockIndex = high + 1;
+        position = 0;
+        break;
+    }
+    if (status != RunStatus::RUNNING) {
+      position = head - blockIndex * k;
+      break;
+    }
+    if (blockIndex >= runStart + written.count) {
+      if (run + 1 < runs.size()) {
+        runStart += written.count;
+        run++;
+      } else if (written.block == blank) {
+        written.count++;
+      } else {
+        runs.push_back(Run{blank, 1});
+        runStart += written.count;
+        run++;
+      }
+    } else if (blockIndex < runStart) {
+      if (run > 0) {
+        run--;
+        runStart -= runs[run].count;
+      } else {
+        if (written.block == blank) written.count++;
+        else runs.push_front(Run{blank, 1});
+        firstBlock--;
+        runStart = firstBlock;
+      }
+    }
+  }
+  std::vector<Symbol> tape0;
+  tape0.reserve(maxCell - minCell + 1);
+  size_t cursor = 0;
+  int64_t cursorStart = firstBlock;
+  for (int64_t p = minCell; p <= maxCell; ++p) {
+    int64_t b = floorDiv(p, k);
+    while (cursor < runs.size() && b >= cursorStart + runs[cursor].count) cursorStart += runs[cursor++].count;
+    char value = (b < firstBlock || cursor == runs.size()) ? '.' : blocks_[runs[cursor].block][p - b * k];
+    tape0.push_back(Symbol(value));
+  }
+  int64_t head = blockIndex * k + position;
+  configuration.getTapes().assign(1, tape0);
+  configuration.getHeads().assign(1, static_cast<int>(head - minCell));
+  configuration.setState(model_.getStateById(stateNames_[state]));
+  configuration.setSteps(steps);
+  return status;
+}
+
+/**
+ * @brief Imprime las estadísticas de la memoria de bloques.
+ * 
+ * @param os Stream de salida.
+ * @param simulator Motor de bloques.
+ * @return Referencia al stream de salida para permitir encadenamiento.
+ */
+std::ostream& operator<<(std::ostream& os, const BlockSimulator& simulator) {
+  uint64_t lookups = simulator.hits_ + simulator.misses_;
+  os << "Motor de bloques (k = " << simulator.blockSize_ << "): " << simulator.blocks_.size()
+     << " bloques distintos, " << simulator.memo_.size() << " recorridos memorizados, "
+     << simulator.hits_ << "/" << lookups << " aciertos";
+  if (lookups > 0) os << " (" << 100.0 * simulator.hits_ / lookups << " %)";
+  os << ", " << simulator.fallbacks_ << " recorridos paso a paso, " << simulator.runBlocks_
+     << " bloques aplicados en serie";
+  return os;
+}
@@ -0,0 +1,77 @@
+#ifndef BLOCK_SIMULATOR_H
+#define BLOCK_SIMULATOR_H
+
+#include <cstdint>
+#include <deque>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "configuration.h"
+#include "string.h"
+#include "turing_machine_model.h"
+
+/**
+ * @brief Motor de macro-símbolos para MT de una cinta.
+ *
+ * La cinta se divide en bloques de k celdas y cada contenido distinto de bloque
+ * se interna como un macro-símbolo. La primera vez que un estado entra en un
+ * bloque por un lado se simula paso a paso hasta que el cabezal sale del bloque
+ * (o la MT se detiene), y el resultado (estado de salida, bloque reescrito, lado
+ * de salida, pasos y celdas visitadas) se memoriza; las siguientes veces se
+ * aplica de golpe. La memoria se comparte entre todas las cadenas del lote.
+ *
+ * La cinta se guarda comprimida en series de bloques iguales (Run). Si un
+ * estado cruza un bloque de un extremo al otro y sale en el mismo estado, el
+ * recorrido se repite igual en todos los bloques de la serie, así que se aplica
+ * a la serie entera de una vez (multiplicando los pasos) en lugar de bloque a
+ * bloque: barrer n bloques iguales cuesta O(1) y no O(n).
+ *
+ * Es exacto: el número de pasos, el veredicto, el límite de pasos y la cinta
+ * final (incluida su extensión) coinciden con TuringMachineSimulator. Cuando un
+ * recorrido memorizado no cabe en los pasos que quedan, ese bloque se vuelve a
+ * simular paso a paso con el presupuesto restante.
+ */
+class BlockSimulator {
+ public:
+  BlockSimulator(const TuringMachineModel& model, int blockSize);
+  RunStatus run(const String& input, Configuration& configuration);
+  void setMaxSteps(long long maxSteps) { maxSteps_ = maxSteps; }
+  friend std::ostream& operator<<(std::ostream& os, const BlockSimulator& simulator);
+ private:
+  enum class Exit : uint8_t { LEFT, RIGHT, ACCEPT, REJECT, LIMIT };
+  struct Run {
+    uint32_t block;
+    int64_t count;
+  };
+  struct Traversal {
+    Exit exit;
+    uint32_t state;
+    uint32_t block;
+    int position;
+    int minPosition;
+    int maxPosition;
+    long long steps;
+  };
+  Traversal traverse(uint32_t state, uint32_t block, int position, long long budget);
+  const Traversal& memoized(uint32_t state, uint32_t block, int position);
+  uint32_t intern(const std::string& content);
+  Run& rewrite(std::deque<Run>& runs, size_t& run, int64_t& start, int64_t from, int64_t count, uint32_t block) const;
+  const TuringMachineModel& model_;
+  int blockSize_;
+  long long maxSteps_;
+  uint32_t initialState_;
+  std::vector<std::string> stateNames_;
+  std::unordered_map<std::string, uint32_t> stateIds_;
+  std::vector<bool> accept_;
+  std::vector<bool> dead_;
+  std::vector<std::string> blocks_;
+  std::unordered_map<std::string, uint32_t> blockIds_;
+  std::unordered_map<uint64_t, Traversal> memo_;
+  uint64_t hits_;
+  uint64_t misses_;
+  uint64_t fallbacks_;
+  uint64_t runBlocks_;
+};
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef BLOCKING_QUEUE_H
+#define BLOCKING_QUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+/**
+ * @brief Cola FIFO acotada y segura entre hilos (productor/consumidor).
+ *
+ * push() bloquea mientras la cola está llena y pop() mientras está vacía, lo
+ * que limita cuántos elementos hay en vuelo entre dos etapas de un Pipeline.
+ */
+template <typename T>
+class BlockingQueue {
+ public:
+  explicit BlockingQueue(size_t capacity) : capacity_(capacity) {}
+  void push(T value) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    notFull_.wait(lock, [this] { return items_.size() < capacity_; });
+    items_.push_back(std::move(value));
+    notEmpty_.notify_one();
+  }
+  T pop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    notEmpty_.wait(lock, [this] { return !items_.empty(); });
+    T value = std::move(items_.front());
+    items_.pop_front();
+    notFull_.notify_one();
+    return value;
+  }
+ private:
+  size_t capacity_;
+  std::deque<T> items_;
+  std::mutex mutex_;
+  std::condition_variable notFull_;
+  std::condition_variable notEmpty_;
+};
+
+#endif
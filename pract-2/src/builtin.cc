@@ -0,0 +1,259 @@
+#include "builtin.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+const char kBlank = '.';
+
+struct BuiltinSpec {
+  const char* name;
+  const char* usage;
+  Builtin::Kind kind;
+  size_t tapes;
+  bool moves;
+  Moves firstMove;
+  Moves secondMove;
+};
+
+// Nombre, argumentos, número de cintas, si admite movimientos y movimientos por defecto de cada operación.
+const BuiltinSpec kSpecs[] = {
+  {"@copy", "<origen> <destino> [<mov> <mov>]", Builtin::Kind::COPY, 2, true, Moves::RIGHT, Moves::RIGHT},
+  {"@reverse", "<origen> <destino>", Builtin::Kind::REVERSE, 2, false, Moves::LEFT, Moves::RIGHT},
+  {"@move", "<origen> <destino> [<mov> <mov>]", Builtin::Kind::MOVE, 2, true, Moves::RIGHT, Moves::RIGHT},
+  {"@rewind", "<cinta> [<mov>]", Builtin::Kind::REWIND, 1, true, Moves::LEFT, Moves::STAY},
+  {"@compare", "<cinta> <cinta> [<mov> <mov>]", Builtin::Kind::COMPARE, 2, true, Moves::RIGHT, Moves::RIGHT},
+  {"@increment", "<cinta>", Builtin::Kind::INCREMENT, 1, false, Moves::LEFT, Moves::STAY},
+};
+
+const BuiltinSpec& specOf(Builtin::Kind kind) {
+  for (const auto& spec : kSpecs) {
+    if (spec.kind == kind) return spec;
+  }
+  throw std::logic_error("Operación nativa sin especificación");
+}
+
+int delta(Moves move) {
+  return move == Moves::LEFT ? -1 : (move == Moves::RIGHT ? 1 : 0);
+}
+
+// Celdas que quedan dentro de la cinta en la dirección del movimiento (unlimited si no se mueve).
+long long reach(const std::vector<Symbol>& tape, long long head, int step, long long unlimited) {
+  if (step > 0) return static_cast<long long>(tape.size()) - head;
+  if (step < 0) return head + 1;
+  return unlimited;
+}
+
+// Deja cinta y cabezal como moveHead() tras el último movimiento de una serie:
+// si el cabezal ha salido por un extremo, la cinta crece con un blanco por ese lado.
+void settle(std::vector<Symbol>& tape, long long head, int& result) {
+  if (head < 0) {
+    tape.insert(tape.begin(), Symbol(kBlank));
+    head = 0;
+  } else if (head == static_cast<long long>(tape.size())) {
+    tape.push_back(Symbol(kBlank));
+  }
+  result = static_cast<int>(head);
+}
+
+}  // namespace
+
+/**
+ * @brief Constructor privado: las operaciones se crean con parse().
+ *
+ * Mientras no se restringe con restrictedTo(), la condición admite cualquier símbolo que no sea el blanco.
+ *
+ * @param kind Operación.
+ * @param first Cinta que se lee (el origen en las copias).
+ * @param second Segunda cinta (el destino en las copias), o -1 si solo usa una.
+ * @param firstMove Movimiento de la primera cinta en cada iteración.
+ * @param secondMove Movimiento de la segunda cinta en cada iteración.
+ */
+Builtin::Builtin(Kind kind, int first, int second, Moves firstMove, Moves secondMove)
+  : kind_(kind), first_(first), second_(second), firstMove_(firstMove), secondMove_(secondMove) {
+  symbols_.set();
+  symbols_.reset(static_cast<unsigned char>(kBlank));
+}
+
+/**
+ * @brief Construye una operación nativa a partir de los tokens de su línea.
+ *
+ * @param tokens Tokens de la línea: estado, "@nombre" y argumentos.
+ * @return Operación nativa.
+ * @throws std::runtime_error si la operación no existe o sus argumentos no son válidos.
+ */
+Builtin Builtin::parse(const std::vector<std::string>& tokens) {
+  std::string line;
+  for (const auto& token : tokens) line += (line.empty() ? "" : " ") + token;
+  const BuiltinSpec* spec = nullptr;
+  for (const auto& candidate : kSpecs) {
+    if (tokens.size() >= 2 && tokens[1] == candidate.name) spec = &candidate;
+  }
+  if (spec == nullptr) {
+    throw std::runtime_error("Error: Operación nativa desconocida en '" + line + "'");
+  }
+  std::runtime_error invalid("Error: Argumentos inválidos en '" + line + "' (se espera " + spec->name + " " +
+                             spec->usage + ")");
+  size_t args = tokens.size() - 2;
+  if (args != spec->tapes && !(spec->moves && args == 2 * spec->tapes)) throw invalid;
+  int tapes[2] = {-1, -1};
+  Moves moves[2] = {spec->firstMove, spec->secondMove};
+  for (size_t i = 0; i < args; ++i) {
+    const std::string& token = tokens[2 + i];
+    if (i < spec->tapes) {
+      if (token.empty() || token.size() > 4 || token.find_first_not_of("0123456789") != std::string::npos) throw invalid;
+      tapes[i] = std::stoi(token);
+    } else if (token == "L" || token == "R" || token == "S") {
+      moves[i - spec->tapes] = token == "L" ? Moves::LEFT : (token == "R" ? Moves::RIGHT : Moves::STAY);
+    } else {
+      throw invalid;
+    }
+  }
+  if (spec->tapes == 2 && tapes[0] == tapes[1]) {
+    throw std::runtime_error("Error: Las dos cintas de '" + line + "' deben ser distintas");
+  }
+  bool stuck = spec->kind == Kind::COMPARE ? moves[0] == Moves::STAY && moves[1] == Moves::STAY
+                                           : moves[0] == Moves::STAY;
+  if (stuck) {
+    throw std::runtime_error("Error: En '" + line + "' la cinta que se lee no puede quedarse quieta (S)");
+  }
+  return Builtin(spec->kind, tapes[0], tapes[1], moves[0], moves[1]);
+}
+
+/**
+ * @brief Devuelve la misma operación con la condición limitada a los símbolos de un alfabeto.
+ *
+ * @param tapeAlphabet Alfabeto de cinta de la MT (el blanco nunca cumple la condición).
+ * @return Operación restringida.
+ */
+Builtin Builtin::restrictedTo(const Alphabet& tapeAlphabet) const {
+  Builtin restricted(*this);
+  restricted.symbols_.reset();
+  for (const Symbol& symbol : tapeAlphabet.getSymbols()) {
+    if (symbol.getValue() != kBlank) restricted.symbols_.set(static_cast<unsigned char>(symbol.getValue()));
+  }
+  return restricted;
+}
+
+/**
+ * @brief Comprueba la condición del bucle sobre los símbolos leídos.
+ *
+ * @param read Símbolos bajo los cabezales, uno por cinta.
+ * @return true si toca una iteración más de la operación.
+ */
+bool Builtin::holds(const std::vector<Symbol>& read) const {
+  char symbol = read[first_].getValue();
+  if (!symbols_.test(static_cast<unsigned char>(symbol))) return false;
+  switch (kind_) {
+    case Kind::COMPARE: return read[second_].getValue() == symbol;
+    case Kind::INCREMENT: return symbol == '1';
+    default: return true;
+  }
+}
+
+/**
+ * @brief Cuenta las iteraciones seguidas que cumplen la condición leyendo solo celdas que ya existen.
+ *
+ * @param tapes Cintas.
+ * @param heads Posiciones de los cabezales.
+ * @param budget Máximo de iteraciones a contar.
+ * @return Número de iteraciones.
+ */
+long long Builtin::scan(const std::vector<std::vector<Symbol>>& tapes, const std::vector<int>& heads,
+                        long long budget) const {
+  const std::vector<Symbol>& tape = tapes[first_];
+  long long head = heads[first_];
+  int step = delta(firstMove_);
+  long long limit = std::min(budget, reach(tape, head, step, budget));
+  long long count = 0;
+  if (kind_ == Kind::COMPARE) {
+    const std::vector<Symbol>& other = tapes[second_];
+    long long otherHead = heads[second_];
+    int otherStep = delta(secondMove_);
+    limit = std::min(limit, reach(other, otherHead, otherStep, budget));
+    while (count < limit) {
+      char symbol = tape[head + count * step].getValue();
+      if (!symbols_.test(static_cast<unsigned char>(symbol)) || other[otherHead + count * otherStep].getValue() != symbol) {
+        break;
+      }
+      ++count;
+    }
+    return count;
+  }
+  while (count < limit) {
+    char symbol = tape[head + count * step].getValue();
+    if (!symbols_.test(static_cast<unsigned char>(symbol)) || (kind_ == Kind::INCREMENT && symbol != '1')) break;
+    ++count;
+  }
+  return count;
+}
+
+/**
+ * @brief Ejecuta de golpe todas las iteraciones posibles de la operación.
+ *
+ * Cada tramo se cuenta con scan() y se aplica con copias y rellenos sobre las
+ * cintas en lugar de iteración a iteración; solo el último movimiento de un
+ * tramo puede sacar un cabezal de su cinta, y entonces la cinta crece con un
+ * blanco como con TuringMachineSimulator::moveHead().
+ *
+ * @param tapes Cintas (se modifican y pueden crecer con blancos).
+ * @param heads Posiciones de los cabezales (se modifican).
+ * @param budget Máximo de iteraciones (pasos) a ejecutar.
+ * @return Número de iteraciones ejecutadas; cada una es un paso de la MT.
+ */
+long long Builtin::run(std::vector<std::vector<Symbol>>& tapes, std::vector<int>& heads, long long budget) const {
+  long long done = 0;
+  while (done < budget) {
+    long long count = scan(tapes, heads, budget - done);
+    if (count == 0) break;
+    std::vector<Symbol>& tape = tapes[first_];
+    long long head = heads[first_];
+    int step = delta(firstMove_);
+    if (kind_ == Kind::COPY || kind_ == Kind::REVERSE || kind_ == Kind::MOVE) {
+      std::vector<Symbol>& target = tapes[second_];
+      long long targetHead = heads[second_];
+      int targetStep = delta(secondMove_);
+      if (targetStep < 0) count = std::min(count, targetHead + 1);
+      if (targetStep > 0 && targetHead + count > static_cast<long long>(target.size())) {
+        target.resize(targetHead + count, Symbol(kBlank));
+      }
+      if (step > 0 && targetStep > 0) {
+        std::copy(tape.begin() + head, tape.begin() + head + count, target.begin() + targetHead);
+      } else if (step < 0 && targetStep > 0) {
+        std::reverse_copy(tape.begin() + head - count + 1, tape.begin() + head + 1, target.begin() + targetHead);
+      } else {
+        for (long long i = 0; i < count; ++i) target[targetHead + i * targetStep] = tape[head + i * step];
+      }
+      if (kind_ == Kind::MOVE) {
+        long long low = step > 0 ? head : head - count + 1;
+        std::fill(tape.begin() + low, tape.begin() + low + count, Symbol(kBlank));
+      }
+      settle(target, targetHead + count * targetStep, heads[second_]);
+    } else if (kind_ == Kind::COMPARE) {
+      settle(tapes[second_], heads[second_] + count * delta(secondMove_), heads[second_]);
+    } else if (kind_ == Kind::INCREMENT) {
+      std::fill(tape.begin() + head - count + 1, tape.begin() + head + 1, Symbol('0'));
+    }
+    settle(tape, head + count * step, heads[first_]);
+    done += count;
+  }
+  return done;
+}
+
+/**
+ * @brief Muestra la operación con el formato del fichero de la MT (con todos sus argumentos).
+ *
+ * @param os Stream de salida.
+ * @param builtin Operación a mostrar.
+ * @return Referencia al stream de salida.
+ */
+std::ostream& operator<<(std::ostream& os, const Builtin& builtin) {
+  const BuiltinSpec& spec = specOf(builtin.kind_);
+  os << spec.name << " " << builtin.first_;
+  if (spec.tapes == 2) os << " " << builtin.second_;
+  if (spec.moves) {
+    os << " " << builtin.firstMove_;
+    if (spec.tapes == 2) os << " " << builtin.secondMove_;
+  }
+  return os;
+}
@@ -0,0 +1,56 @@
+#ifndef BUILTIN_H
+#define BUILTIN_H
+
+#include <bitset>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "alphabet.h"
+#include "moves.h"
+#include "symbol.h"
+
+/**
+ * @brief Operación nativa que un estado invoca con una línea "<estado> @<nombre> <argumentos>".
+ *
+ * Es un bucle del estado sobre sí mismo: mientras se cumple su condición sobre
+ * los símbolos leídos, cada iteración es un paso que escribe, mueve y sigue en
+ * el mismo estado; cuando deja de cumplirse se aplican las transiciones normales
+ * del estado. Equivale por tanto a escribir a mano una transición q -> q por cada
+ * combinación de símbolos que cumple la condición (que tienen prioridad sobre las
+ * demás del estado), y los pasos, el veredicto y las cintas son los de esa versión.
+ * El simulador ejecuta todas las iteraciones posibles de golpe con run().
+ *
+ * - @copy o d [mo md]: mientras o no lee blanco, escribe en d lo leído en o y mueve o y d (R R por defecto).
+ * - @reverse o d: @copy o d L R, copia o del revés.
+ * - @move o d [mo md]: como @copy, pero deja un blanco en o.
+ * - @rewind c [m]: mientras c no lee blanco, mueve c (L por defecto).
+ * - @compare a b [ma mb]: mientras a y b leen el mismo símbolo no blanco, mueve a y b (R R por defecto).
+ * - @increment c: mientras c lee '1', escribe '0' y mueve c a la izquierda (el acarreo de sumar 1 en binario).
+ *
+ * Las cintas de cada operación son distintas y la cinta que se lee no puede quedarse quieta (S).
+ * Como las transiciones a mano solo pueden leer símbolos del alfabeto de cinta,
+ * el modelo restringe la condición a ese alfabeto con restrictedTo().
+ */
+class Builtin {
+ public:
+  enum class Kind { COPY, REVERSE, MOVE, REWIND, COMPARE, INCREMENT };
+  static bool isInvocation(const std::string& token) { return token.size() > 1 && token[0] == '@'; }
+  static Builtin parse(const std::vector<std::string>& tokens);
+  Builtin restrictedTo(const Alphabet& tapeAlphabet) const;
+  Kind getKind() const { return kind_; }
+  int getMaxTape() const { return second_ > first_ ? second_ : first_; }
+  bool holds(const std::vector<Symbol>& read) const;
+  long long run(std::vector<std::vector<Symbol>>& tapes, std::vector<int>& heads, long long budget) const;
+  friend std::ostream& operator<<(std::ostream& os, const Builtin& builtin);
+ private:
+  Builtin(Kind kind, int first, int second, Moves firstMove, Moves secondMove);
+  long long scan(const std::vector<std::vector<Symbol>>& tapes, const std::vector<int>& heads, long long budget) const;
+  Kind kind_;
+  int first_;
+  int second_;
+  Moves firstMove_;
+  Moves secondMove_;
+  std::bitset<256> symbols_;
+};
+
+#endif
@@ -0,0 +1,378 @@
+#include "busy_beaver.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+// Celdas que se añaden a la cinta cuando el cabezal sale por un extremo.
+const int kGrow = 64;
+
+// Ramas por hilo que se abren en anchura antes de repartir el trabajo.
+const size_t kTasksPerThread = 64;
+
+}  // namespace
+
+/**
+ * @brief Orden total entre tablas (para desempatar campeones de forma determinista).
+ *
+ * @param other Otra máquina del mismo tamaño.
+ * @return true si la tabla de esta máquina va antes en orden lexicográfico.
+ */
+bool BusyBeaverMachine::precedes(const BusyBeaverMachine& other) const {
+  for (size_t i = 0; i < table.size() && i < other.table.size(); ++i) {
+    const Entry& a = table[i];
+    const Entry& b = other.table[i];
+    if (a.next != b.next) return a.next < b.next;
+    if (a.write != b.write) return a.write < b.write;
+    if (a.move != b.move) return a.move < b.move;
+  }
+  return false;
+}
+
+/**
+ * @brief Constructor del enumerador.
+ *
+ * @param states Número de estados (sin contar la parada), entre 1 y 26.
+ * @param symbols Número de símbolos (blanco incluido), entre 2 y 10.
+ * @param maxSteps Límite de pasos por máquina; las que lo agotan quedan indecisas.
+ * @param threads Número de hilos (al menos 1).
+ * @throws std::invalid_argument si el número de estados o de símbolos está fuera de rango.
+ */
+BusyBeaver::BusyBeaver(int states, int symbols, long long maxSteps, int threads)
+  : states_(states), symbols_(symbols), maxSteps_(maxSteps), threads_(std::max(threads, 1)), seconds_(0) {
+  if (states_ < 1 || states_ > 26) throw std::invalid_argument("El número de estados debe estar entre 1 y 26");
+  if (symbols_ < 2 || symbols_ > 10) throw std::invalid_argument("El número de símbolos debe estar entre 2 y 10");
+}
+
+/**
+ * @brief Recorre todo el árbol de máquinas y calcula los campeones.
+ */
+void BusyBeaver::run() {
+  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+  total_ = Stats();
+  Node root;
+  root.machine.table.resize(states_ * symbols_);
+  root.tape.assign(kGrow, 0);
+  root.origin = kGrow / 2;
+  root.head = root.low = root.high = kGrow / 2;
+  root.state = 0;
+  root.usedStates = 1;
+  root.usedSymbols = 1;
+  root.defined = 0;
+  std::vector<Node> frontier(1, root);
+  while (!frontier.empty() && frontier.size() < threads_ * kTasksPerThread) {
+    std::vector<Node> next;
+    for (Node& node : frontier) process(node, next, total_);
+    frontier.swap(next);
+  }
+  std::atomic<size_t> nextTask(0);
+  std::vector<Stats> partial(threads_);
+  std::vector<std::thread> workers;
+  for (int w = 0; w < threads_; ++w) {
+    workers.emplace_back([this, w, &frontier, &nextTask, &partial]() {
+      std::vector<Node> pending;
+      for (size_t task = nextTask++; task < frontier.size(); task = nextTask++) {
+        pending.push_back(std::move(frontier[task]));
+        while (!pending.empty()) {
+          Node node = std::move(pending.back());
+          pending.pop_back();
+          process(node, pending, partial[w]);
+        }
+      }
+    });
+  }
+  for (std::thread& worker : workers) worker.join();
+  for (const Stats& stats : partial) {
+    total_.halted += stats.halted;
+    total_.cycles += stats.cycles;
+    total_.escapes += stats.escapes;
+    total_.complete += stats.complete;
+    total_.undecided += stats.undecided;
+    total_.simulatedSteps += stats.simulatedSteps;
+    if (!stats.steps.table.empty()) offer(total_.steps, stats.steps, true);
+    if (!stats.ones.table.empty()) offer(total_.ones, stats.ones, false);
+  }
+  stepsChampion_ = total_.steps;
+  onesChampion_ = total_.ones;
+  seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+/**
+ * @brief Simula un nodo y, si llega a una transición sin definir, lo ramifica.
+ *
+ * La rama de parada es una hoja (se ofrece a los campeones); las demás
+ * definiciones se añaden a pending, salvo la que completaría la tabla, que ya
+ * no podría parar.
+ *
+ * @param node Nodo a procesar (su configuración avanza).
+ * @param pending Nodos pendientes donde se añaden los hijos.
+ * @param stats Contadores del hilo.
+ */
+void BusyBeaver::process(Node& node, std::vector<Node>& pending, Stats& stats) const {
+  switch (advance(node, stats)) {
+    case Outcome::CYCLE:
+      stats.cycles++;
+      return;
+    case Outcome::ESCAPE:
+      stats.escapes++;
+      return;
+    case Outcome::BUDGET:
+      stats.undecided++;
+      return;
+    case Outcome::UNDEFINED:
+      break;
+  }
+  int read = node.tape[node.head];
+  int slot = node.state * symbols_ + read;
+  BusyBeaverMachine halted = node.machine;
+  halted.table[slot].write = 1;
+  halted.table[slot].move = 1;
+  halted.table[slot].next = states_;
+  halted.steps = node.machine.steps + 1;
+  halted.ones = std::count_if(node.tape.begin(), node.tape.end(), [](uint8_t cell) { return cell != 0; }) +
+                (read == 0 ? 1 : 0);
+  stats.halted++;
+  offer(stats.steps, halted, true);
+  offer(stats.ones, halted, false);
+  int lastNext = std::min(node.usedStates, states_ - 1);
+  int lastWrite = std::min(node.usedSymbols, symbols_ - 1);
+  for (int next = 0; next <= lastNext; ++next) {
+    for (int write = 0; write <= lastWrite; ++write) {
+      for (int move = node.defined == 0 ? 1 : -1; move <= 1; move += 2) {
+        if (node.defined + 1 == states_ * symbols_) {
+          stats.complete++;
+          continue;
+        }
+        pending.push_back(node);
+        Node& child = pending.back();
+        child.machine.table[slot].write = write;
+        child.machine.table[slot].move = move;
+        child.machine.table[slot].next = next;
+        child.defined++;
+        child.usedStates = std::max(child.usedStates, next + 1);
+        child.usedSymbols = std::max(child.usedSymbols, write + 1);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Simula hasta una transición sin definir, un bucle demostrado o el límite de pasos.
+ *
+ * Para los ciclos guarda una copia de la configuración y la compara con cada
+ * configuración siguiente; la copia se renueva cada vez que se dobla la
+ * distancia (Brent), así que se detecta cualquier ciclo exacto con coste
+ * amortizado lineal.
+ *
+ * @param node Nodo a simular.
+ * @param stats Contadores del hilo (pasos simulados).
+ * @return Motivo por el que se detuvo la simulación.
+ */
+BusyBeaver::Outcome BusyBeaver::advance(Node& node, Stats& stats) const {
+  std::vector<uint8_t> snapshot = node.tape;
+  long long snapshotOrigin = node.origin;
+  int snapshotLow = node.low;
+  int snapshotHigh = node.high;
+  int snapshotState = node.state;
+  long long snapshotHead = node.head - node.origin;
+  long long snapshotSteps = node.machine.steps;
+  long long distance = 1;
+  while (true) {
+    if (node.machine.steps >= maxSteps_) return Outcome::BUDGET;
+    uint8_t read = node.tape[node.head];
+    const BusyBeaverMachine::Entry& entry = node.machine.table[node.state * symbols_ + read];
+    if (entry.next == BusyBeaverMachine::UNDEFINED) return Outcome::UNDEFINED;
+    if (read == 0 && entry.next == node.state &&
+        ((entry.move > 0 && node.head >= node.high) || (entry.move < 0 && node.head <= node.low))) {
+      return Outcome::ESCAPE;
+    }
+    node.tape[node.head] = entry.write;
+    node.state = entry.next;
+    node.head += entry.move;
+    node.machine.steps++;
+    stats.simulatedSteps++;
+    if (node.head < 0 || node.head >= (int)node.tape.size()) grow(node);
+    node.low = std::min(node.low, node.head);
+    node.high = std::max(node.high, node.head);
+    if (node.state == snapshotState && node.head - node.origin == snapshotHead &&
+        sameTape(node, snapshot, snapshotOrigin, snapshotLow, snapshotHigh)) {
+      return Outcome::CYCLE;
+    }
+    if (node.machine.steps - snapshotSteps == distance) {
+      snapshot = node.tape;
+      snapshotOrigin = node.origin;
+      snapshotLow = node.low;
+      snapshotHigh = node.high;
+      snapshotState = node.state;
+      snapshotHead = node.head - node.origin;
+      snapshotSteps = node.machine.steps;
+      distance *= 2;
+    }
+  }
+}
+
+/**
+ * @brief Amplía la cinta por el extremo por el que ha salido el cabezal.
+ */
+void BusyBeaver::grow(Node& node) {
+  if (node.head < 0) {
+    node.tape.insert(node.tape.begin(), kGrow, 0);
+    node.head += kGrow;
+    node.origin += kGrow;
+    node.low += kGrow;
+    node.high += kGrow;
+  } else {
+    node.tape.resize(node.tape.size() + kGrow, 0);
+  }
+}
+
+/**
+ * @brief Compara la cinta de un nodo con una copia anterior, en posiciones absolutas.
+ *
+ * Fuera de la zona visitada de cada una, las celdas son blancas.
+ */
+bool BusyBeaver::sameTape(const Node& node, const std::vector<uint8_t>& tape, long long origin, int low, int high) {
+  long long first = std::min(node.low - node.origin, low - origin);
+  long long last = std::max(node.high - node.origin, high - origin);
+  for (long long position = first; position <= last; ++position) {
+    long long here = position + node.origin;
+    long long there = position + origin;
+    uint8_t current = here >= node.low && here <= node.high ? node.tape[here] : 0;
+    uint8_t previous = there >= low && there <= high ? tape[there] : 0;
+    if (current != previous) return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Sustituye al campeón si el candidato es mejor.
+ *
+ * @param best Campeón actual (vacío si aún no hay ninguno).
+ * @param candidate Máquina que para.
+ * @param bySteps true para comparar por pasos (y luego por unos), false por unos (y luego por pasos).
+ */
+void BusyBeaver::offer(BusyBeaverMachine& best, const BusyBeaverMachine& candidate, bool bySteps) {
+  if (best.table.empty()) {
+    best = candidate;
+    return;
+  }
+  long long candidateKey[2] = {bySteps ? candidate.steps : candidate.ones, bySteps ? candidate.ones : candidate.steps};
+  long long bestKey[2] = {bySteps ? best.steps : best.ones, bySteps ? best.ones : best.steps};
+  if (candidateKey[0] != bestKey[0] ? candidateKey[0] > bestKey[0]
+      : candidateKey[1] != bestKey[1] ? candidateKey[1] > bestKey[1] : candidate.precedes(best)) {
+    best = candidate;
+  }
+}
+
+/**
+ * @brief Nombre de un símbolo en los ficheros de MT: el blanco es '.', el resto sus dígitos.
+ */
+char BusyBeaver::symbolName(int symbol) const {
+  return symbol == 0 ? '.' : static_cast<char>('0' + symbol);
+}
+
+/**
+ * @brief Tabla en la notación habitual: por estado, escritura, movimiento y destino de cada símbolo.
+ *
+ * Los estados son A, B, ...; la parada es H y las transiciones sin definir "---".
+ * Por ejemplo, el campeón de 2 estados es "1RB1LB_1LA1RH".
+ */
+std::string BusyBeaver::notation(const BusyBeaverMachine& machine) const {
+  std::string text;
+  for (int state = 0; state < states_; ++state) {
+    if (state > 0) text += '_';
+    for (int symbol = 0; symbol < symbols_; ++symbol) {
+      const BusyBeaverMachine::Entry& entry = machine.table[state * symbols_ + symbol];
+      if (entry.next == BusyBeaverMachine::UNDEFINED) {
+        text += "---";
+        continue;
+      }
+      text += static_cast<char>('0' + entry.write);
+      text += entry.move < 0 ? 'L' : 'R';
+      text += entry.next == states_ ? 'H' : static_cast<char>('A' + entry.next);
+    }
+  }
+  return text;
+}
+
+/**
+ * @brief Fichero de MT (formato de Test/MT) de una máquina; la parada es el estado de aceptación H.
+ *
+ * Las transiciones sin definir no se escriben. Se simula sobre la cinta en
+ * blanco con un fichero de cadenas que contenga ".".
+ */
+std::string BusyBeaver::toText(const BusyBeaverMachine& machine) const {
+  std::ostringstream text;
+  text << "# Castor afanoso de " << states_ << " estados y " << symbols_ << " símbolos: " << notation(machine) << "\n";
+  text << "# Sobre la cinta en blanco para en " << machine.steps << " pasos con " << machine.ones
+       << " símbolos no blancos (--max-steps " << machine.steps << " o más)\n\n";
+  text << "# Estados\n";
+  for (int state = 0; state < states_; ++state) text << static_cast<char>('A' + state) << " ";
+  text << "H\n\n# Alfabeto de entrada\n1\n\n# Alfabeto de cinta\n";
+  for (int symbol = 1; symbol < symbols_; ++symbol) text << symbolName(symbol) << " ";
+  text << ".\n\n# Estado inicial\nA\n\n# Símbolo blanco\n.\n\n# Estados de aceptación\nH\n\n# Transiciones\n";
+  for (int state = 0; state < states_; ++state) {
+    for (int symbol = 0; symbol < symbols_; ++symbol) {
+      const BusyBeaverMachine::Entry& entry = machine.table[state * symbols_ + symbol];
+      if (entry.next == BusyBeaverMachine::UNDEFINED) continue;
+      text << static_cast<char>('A' + state) << " " << symbolName(symbol) << " "
+           << (entry.next == states_ ? 'H' : static_cast<char>('A' + entry.next)) << " "
+           << symbolName(entry.write) << " " << (entry.move < 0 ? 'L' : 'R') << "\n";
+    }
+  }
+  return text.str();
+}
+
+/**
+ * @brief Construye directamente en memoria el TuringMachineModel de una máquina (sin pasar por fichero).
+ */
+TuringMachineModel BusyBeaver::toModel(const BusyBeaverMachine& machine) const {
+  std::vector<State> states;
+  for (int state = 0; state < states_; ++state) states.push_back(State(std::string(1, 'A' + state)));
+  states.push_back(State("H"));
+  states.back().setAccept(true);
+  std::vector<Transition> transitions;
+  for (int state = 0; state < states_; ++state) {
+    for (int symbol = 0; symbol < symbols_; ++symbol) {
+      const BusyBeaverMachine::Entry& entry = machine.table[state * symbols_ + symbol];
+      if (entry.next == BusyBeaverMachine::UNDEFINED) continue;
+      std::map<int, std::pair<Symbol, Moves>> actions;
+      actions.insert(std::make_pair(0, std::make_pair(Symbol(symbolName(entry.write)),
+                                                      entry.move < 0 ? Moves::LEFT : Moves::RIGHT)));
+      transitions.push_back(Transition(states[state], states[entry.next], std::vector<Symbol>(1, symbolName(symbol)),
+                                       actions));
+    }
+  }
+  Alphabet input;
+  input.addSymbol(Symbol('1'));
+  Alphabet tape;
+  for (int symbol = 0; symbol < symbols_; ++symbol) tape.addSymbol(Symbol(symbolName(symbol)));
+  return TuringMachineModel(states, transitions, input, tape, "A");
+}
+
+/**
+ * @brief Muestra cuántas máquinas se han clasificado de cada forma y los campeones.
+ */
+std::ostream& operator<<(std::ostream& os, const BusyBeaver& search) {
+  const BusyBeaver::Stats& stats = search.total_;
+  uint64_t machines = stats.halted + stats.cycles + stats.escapes + stats.complete + stats.undecided;
+  os << "Castores afanosos de " << search.states_ << " estados y " << search.symbols_ << " símbolos (límite "
+     << search.maxSteps_ << " pasos, " << search.threads_ << " hilos): " << machines << " máquinas en forma normal "
+     << "de árbol en " << search.seconds_ << " s (" << stats.simulatedSteps << " pasos simulados)\n";
+  os << "  Paran: " << stats.halted << "\n";
+  os << "  Sin transición de parada posible: " << stats.complete << "\n";
+  os << "  Escapan por un extremo de la cinta: " << stats.escapes << "\n";
+  os << "  Repiten una configuración: " << stats.cycles << "\n";
+  os << "  Indecisas (agotan el límite de pasos): " << stats.undecided << "\n";
+  if (!search.stepsChampion_.table.empty()) {
+    os << "  Campeón por pasos: " << search.notation(search.stepsChampion_) << " (" << search.stepsChampion_.steps
+       << " pasos, " << search.stepsChampion_.ones << " no blancos)\n";
+    os << "  Campeón por símbolos no blancos: " << search.notation(search.onesChampion_) << " ("
+       << search.onesChampion_.ones << " no blancos, " << search.onesChampion_.steps << " pasos)";
+  }
+  return os;
+}
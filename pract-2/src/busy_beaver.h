@@ -0,0 +1,110 @@
+#ifndef BUSY_BEAVER_H
+#define BUSY_BEAVER_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "turing_machine_model.h"
+
+/**
+ * @brief Máquina de una cinta del enumerador de castores afanosos.
+ *
+ * La tabla tiene una entrada por (estado, símbolo) en el orden
+ * estado * símbolos + símbolo. Cada entrada escribe un símbolo (0 es el blanco),
+ * mueve el cabezal a la izquierda (-1) o a la derecha (+1) y pasa al estado
+ * next; next == UNDEFINED es una transición que la ejecución no ha necesitado y
+ * next == número de estados es la parada.
+ */
+struct BusyBeaverMachine {
+  static const int8_t UNDEFINED = -1;
+  struct Entry {
+    Entry() : write(0), move(0), next(UNDEFINED) {}
+    int8_t write;
+    int8_t move;
+    int8_t next;
+  };
+  std::vector<Entry> table;
+  long long steps = 0;
+  long long ones = 0;
+  bool precedes(const BusyBeaverMachine& other) const;
+};
+
+/**
+ * @brief Enumerador de máquinas de n estados y k símbolos en forma normal de árbol (--busy-beaver).
+ *
+ * No genera las máquinas completas por adelantado: simula desde la cinta en
+ * blanco y, cuando la ejecución llega a una transición sin definir, ramifica
+ * con todas sus definiciones posibles (la parada incluida) y cada rama sigue
+ * desde la misma configuración. Así solo se distinguen transiciones que
+ * alguna ejecución usa, y se poda pronto:
+ * - Isomorfismos: los estados y los símbolos nuevos se introducen en orden
+ *   (el siguiente sin usar, no cualquiera) y la primera transición mueve a la
+ *   derecha (la simétrica por izquierda-derecha es la misma máquina reflejada)
+ * - Paradas: elegir la parada cierra la rama (escribe 1, como en el problema clásico)
+ * - Sin parada posible: si se definen todas las transiciones sin elegir la
+ *   parada, la máquina ya no puede parar y no se simula
+ * - Bucles triviales: un estado que lee blanco en el extremo de la zona visitada
+ *   y sigue en sí mismo hacia fuera (escape), o una configuración exactamente
+ *   repetida (ciclo, detectado con el método de Brent)
+ * Las ramas que agotan el límite de pasos quedan como indecisas.
+ *
+ * El árbol se abre en anchura hasta tener suficientes ramas y los hilos se las
+ * reparten con un contador atómico; cada hilo recorre las suyas en profundidad
+ * con una pila explícita. Los campeones son la máquina que para con más pasos y
+ * la que para con más símbolos no blancos; a igualdad gana la primera tabla en
+ * orden lexicográfico, así que el resultado no depende del número de hilos.
+ */
+class BusyBeaver {
+ public:
+  static const long long DEFAULT_MAX_STEPS = 1000;
+  BusyBeaver(int states, int symbols, long long maxSteps, int threads);
+  void run();
+  const BusyBeaverMachine& getStepsChampion() const { return stepsChampion_; }
+  const BusyBeaverMachine& getOnesChampion() const { return onesChampion_; }
+  std::string notation(const BusyBeaverMachine& machine) const;
+  std::string toText(const BusyBeaverMachine& machine) const;
+  TuringMachineModel toModel(const BusyBeaverMachine& machine) const;
+  friend std::ostream& operator<<(std::ostream& os, const BusyBeaver& search);
+ private:
+  enum class Outcome { UNDEFINED, CYCLE, ESCAPE, BUDGET };
+  struct Node {
+    BusyBeaverMachine machine;
+    std::vector<uint8_t> tape;
+    long long origin;
+    int head;
+    int low;
+    int high;
+    int state;
+    int usedStates;
+    int usedSymbols;
+    int defined;
+  };
+  struct Stats {
+    Stats() : halted(0), cycles(0), escapes(0), complete(0), undecided(0), simulatedSteps(0) {}
+    uint64_t halted;
+    uint64_t cycles;
+    uint64_t escapes;
+    uint64_t complete;
+    uint64_t undecided;
+    uint64_t simulatedSteps;
+    BusyBeaverMachine steps;
+    BusyBeaverMachine ones;
+  };
+  Outcome advance(Node& node, Stats& stats) const;
+  void process(Node& node, std::vector<Node>& pending, Stats& stats) const;
+  static void grow(Node& node);
+  static bool sameTape(const Node& node, const std::vector<uint8_t>& tape, long long origin, int low, int high);
+  static void offer(BusyBeaverMachine& best, const BusyBeaverMachine& candidate, bool bySteps);
+  char symbolName(int symbol) const;
+  int states_;
+  int symbols_;
+  long long maxSteps_;
+  int threads_;
+  Stats total_;
+  BusyBeaverMachine stepsChampion_;
+  BusyBeaverMachine onesChampion_;
+  double seconds_;
+};
+
+#endif
@@ -0,0 +1,169 @@
+#include "census.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <stdexcept>
+#include <thread>
+#include "compact_simulator.h"
+#include "result_projection.h"
+
+namespace {
+
+// Cadenas consecutivas que un hilo toma de una vez.
+const uint64_t kChunk = 4096;
+
+/**
+ * @brief Muestras de una clase encontradas por un hilo, con su índice en la enumeración.
+ */
+typedef std::vector<std::pair<uint64_t, std::string>> Samples;
+
+}  // namespace
+
+/**
+ * @brief Constructor del censo.
+ * 
+ * @param model Modelo compacto de la MT (no se toma su propiedad).
+ * @param alphabet Símbolos del alfabeto de entrada (se ordenan y se quitan repetidos).
+ * @param maxSteps Límite de pasos por cadena; por encima la cadena cuenta como LÍMITE.
+ * @param threads Número de hilos (al menos 1).
+ * @param samples Muestras por longitud y clase.
+ * @throws std::invalid_argument si el alfabeto está vacío.
+ */
+Census::Census(const CompactModel& model, const std::vector<char>& alphabet, long long maxSteps, int threads,
+               int samples)
+  : model_(model), alphabet_(alphabet), maxSteps_(maxSteps), threads_(std::max(threads, 1)),
+    samples_(std::max(samples, 0)), seconds_(0) {
+  std::sort(alphabet_.begin(), alphabet_.end());
+  alphabet_.erase(std::unique(alphabet_.begin(), alphabet_.end()), alphabet_.end());
+  if (alphabet_.empty()) throw std::invalid_argument("El alfabeto de entrada está vacío");
+}
+
+/**
+ * @brief Clasifica todas las cadenas de longitud 0 a maxLength.
+ * 
+ * @param maxLength Longitud máxima.
+ * @throws std::invalid_argument si el número de cadenas de alguna longitud no cabe en 64 bits.
+ */
+void Census::run(int maxLength) {
+  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+  rows_.clear();
+  for (int length = 0; length <= maxLength; ++length) rows_.push_back(runLength(length));
+  seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+/**
+ * @brief Clasifica todas las cadenas de una longitud repartiéndolas entre los hilos.
+ * 
+ * La cadena de índice i tiene como dígitos (en base |alfabeto|, el más
+ * significativo a la izquierda) los índices de sus símbolos.
+ * 
+ * @param length Longitud de las cadenas.
+ * @return Fila del censo para esa longitud.
+ */
+CensusRow Census::runLength(int length) {
+  const uint64_t base = alphabet_.size();
+  uint64_t total = 1;
+  for (int i = 0; i < length; ++i) {
+    if (total > UINT64_MAX / base) {
+      throw std::invalid_argument("Demasiadas cadenas de longitud " + std::to_string(length) + " para enumerarlas");
+    }
+    total *= base;
+  }
+  std::atomic<uint64_t> next(0);
+  std::vector<CensusRow> partial(threads_);
+  std::vector<std::vector<Samples>> found(threads_, std::vector<Samples>(CensusRow::KINDS));
+  std::vector<std::thread> workers;
+  for (int w = 0; w < threads_; ++w) {
+    workers.emplace_back([&, w] {
+      CompactSimulator simulator(model_);
+      simulator.setMaxSteps(maxSteps_);
+      ResultProjection verdictOnly(std::vector<int>(1, 0), ResultProjection::Mode::FULL, true);
+      std::string unused;
+      std::vector<uint64_t> digits(length);
+      std::vector<Symbol> symbols(length, Symbol(alphabet_[0]));
+      CensusRow& row = partial[w];
+      while (true) {
+        uint64_t first = next.fetch_add(kChunk);
+        if (first >= total) break;
+        uint64_t last = std::min(total, first + kChunk);
+        uint64_t rest = first;
+        for (int i = length - 1; i >= 0; --i) {
+          digits[i] = rest % base;
+          rest /= base;
+          symbols[i] = Symbol(alphabet_[digits[i]]);
+        }
+        for (uint64_t index = first; index < last; ++index) {
+          long long steps = 0;
+          RunStatus status = simulator.compute(String(symbols), steps, verdictOnly, unused);
+          int kind = status == RunStatus::ACCEPTED ? CensusRow::ACCEPTED
+                   : status == RunStatus::STEP_LIMIT ? CensusRow::STEP_LIMIT : CensusRow::REJECTED;
+          row.counts[kind]++;
+          if (found[w][kind].size() < samples_) {
+            std::string text;
+            for (const Symbol& symbol : symbols) text.push_back(symbol.getValue());
+            found[w][kind].push_back(std::make_pair(index, text));
+          }
+          for (int i = length - 1; i >= 0; --i) {
+            if (++digits[i] < base) {
+              symbols[i] = Symbol(alphabet_[digits[i]]);
+              break;
+            }
+            digits[i] = 0;
+            symbols[i] = Symbol(alphabet_[0]);
+          }
+        }
+      }
+    });
+  }
+  for (std::thread& worker : workers) worker.join();
+  CensusRow row;
+  row.length = length;
+  for (int kind = 0; kind < CensusRow::KINDS; ++kind) {
+    Samples merged;
+    for (int w = 0; w < threads_; ++w) {
+      row.counts[kind] += partial[w].counts[kind];
+      merged.insert(merged.end(), found[w][kind].begin(), found[w][kind].end());
+    }
+    std::sort(merged.begin(), merged.end());
+    for (size_t i = 0; i < merged.size() && i < samples_; ++i) row.samples[kind].push_back(merged[i].second);
+  }
+  return row;
+}
+
+/**
+ * @brief Muestra la tabla del censo: cadenas por longitud y clase, con sus muestras.
+ * 
+ * @param os Stream de salida.
+ * @param census Censo ya ejecutado.
+ * @return Referencia al stream de salida para permitir encadenamiento.
+ */
+std::ostream& operator<<(std::ostream& os, const Census& census) {
+  static const char* const names[CensusRow::KINDS] = {"aceptadas", "rechazadas", "límite"};
+  uint64_t totals[CensusRow::KINDS] = {0, 0, 0};
+  os << "Censo del lenguaje (alfabeto {";
+  for (size_t i = 0; i < census.alphabet_.size(); ++i) os << (i ? "," : "") << census.alphabet_[i];
+  os << "}, límite " << census.maxSteps_ << " pasos, " << census.threads_ << " hilos)\n";
+  os << std::setw(8) << "longitud" << std::setw(14) << "cadenas" << std::setw(14) << "aceptadas"
+     << std::setw(14) << "rechazadas" << std::setw(15) << "límite" << "\n";
+  for (const CensusRow& row : census.rows_) {
+    uint64_t strings = row.counts[0] + row.counts[1] + row.counts[2];
+    os << std::setw(8) << row.length << std::setw(14) << strings;
+    for (int kind = 0; kind < CensusRow::KINDS; ++kind) {
+      os << std::setw(14) << row.counts[kind];
+      totals[kind] += row.counts[kind];
+    }
+    os << "\n";
+    for (int kind = 0; kind < CensusRow::KINDS; ++kind) {
+      if (row.samples[kind].empty()) continue;
+      os << "          " << names[kind] << ":";
+      for (const std::string& sample : row.samples[kind]) os << " \"" << sample << "\"";
+      os << "\n";
+    }
+  }
+  uint64_t strings = totals[0] + totals[1] + totals[2];
+  os << "Total: " << strings << " cadenas (" << totals[0] << " aceptadas, " << totals[1] << " rechazadas, "
+     << totals[2] << " en el límite de pasos) en " << census.seconds_ << " s";
+  if (census.seconds_ > 0) os << " (" << static_cast<uint64_t>(strings / census.seconds_) << " cadenas/s)";
+  return os;
+}
@@ -0,0 +1,52 @@
+#ifndef CENSUS_H
+#define CENSUS_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "compact_model.h"
+
+/**
+ * @brief Resultado del censo para una longitud de cadena.
+ *
+ * Las clases son ACEPTADA, RECHAZADA y LÍMITE (la MT superó el límite de pasos:
+ * posible bucle). Las muestras son las primeras cadenas de cada clase en orden
+ * lexicográfico, de modo que no dependen del número de hilos.
+ */
+struct CensusRow {
+  enum Kind { ACCEPTED = 0, REJECTED = 1, STEP_LIMIT = 2, KINDS = 3 };
+  int length = 0;
+  uint64_t counts[KINDS] = {0, 0, 0};
+  std::vector<std::string> samples[KINDS];
+};
+
+/**
+ * @brief Censo del lenguaje de una MT: clasifica todas las cadenas hasta una longitud (--census).
+ *
+ * Enumera en memoria, sin ningún fichero de entrada, todas las cadenas sobre el
+ * alfabeto de entrada de longitud 0..n en orden lexicográfico. Cada longitud se
+ * trocea en bloques de índices consecutivos que los hilos se reparten con un
+ * contador atómico (las cadenas que llegan al límite de pasos cuestan más, así
+ * que el reparto es dinámico); cada hilo recorre su bloque con un cuentakilómetros
+ * sobre los dígitos de la cadena y la simula con CompactSimulator, que no
+ * modifica el modelo y se comparte entre hilos.
+ */
+class Census {
+ public:
+  Census(const CompactModel& model, const std::vector<char>& alphabet, long long maxSteps, int threads, int samples);
+  void run(int maxLength);
+  const std::vector<CensusRow>& getRows() const { return rows_; }
+  friend std::ostream& operator<<(std::ostream& os, const Census& census);
+ private:
+  CensusRow runLength(int length);
+  const CompactModel& model_;
+  std::vector<char> alphabet_;
+  long long maxSteps_;
+  int threads_;
+  size_t samples_;
+  std::vector<CensusRow> rows_;
+  double seconds_;
+};
+
+#endif
@@ -0,0 +1,154 @@
+#include "chain_fusion.h"
+#include "turing_machine_simulator.h"
+
+namespace {
+
+// Marca de "símbolo desconocido" bajo un cabezal durante el análisis.
+const int kUnknown = -1;
+
+}  // namespace
+
+/**
+ * @brief Analiza todas las transiciones del modelo y compila sus cadenas forzadas.
+ * 
+ * Solo se guardan las cadenas de al menos dos eslabones.
+ * 
+ * @param model Modelo de la MT (se guardan punteros a sus transiciones).
+ */
+ChainFusion::ChainFusion(const TuringMachineModel& model)
+  : model_(model), tapeCount_(model.determineTapeCount()), transitions_(0), fusedLinks_(0), longest_(0) {
+  for (const auto& entry : model_.getTransitions()) {
+    for (const Transition& transition : entry.second) {
+      transitions_++;
+      Superinstruction chain;
+      if (!fuse(transition, chain)) continue;
+      fusedLinks_ += chain.length;
+      if (chain.length > longest_) longest_ = chain.length;
+      chains_.emplace(&transition, std::move(chain));
+    }
+  }
+}
+
+/**
+ * @brief Comprueba que una transición se puede aplicar sin errores.
+ * 
+ * Una transición con acciones mal formadas o con un destino inexistente hace
+ * fallar a TuringMachineSimulator al aplicarla; no se fusiona para que el
+ * error siga apareciendo en el mismo paso.
+ * 
+ * @param transition Transición a comprobar.
+ * @return true si puede formar parte de una superinstrucción.
+ */
+bool ChainFusion::isFusable(const Transition& transition) const {
+  const auto& actions = transition.getTapeActions();
+  if ((int)transition.getReadSymbols().size() != tapeCount_ || (int)actions.size() != tapeCount_) return false;
+  for (const auto& pair : actions) {
+    Moves move = pair.second.second;
+    if (pair.first < 0 || pair.first >= tapeCount_) return false;
+    if (move != Moves::LEFT && move != Moves::RIGHT && move != Moves::STAY) return false;
+  }
+  return model_.getStates().count(transition.getTo().getId()) > 0;
+}
+
+/**
+ * @brief Devuelve la transición que se aplicará forzosamente desde un estado.
+ * 
+ * @param state Estado en el que está la máquina.
+ * @param known Símbolo bajo cada cabezal, o kUnknown si no se conoce.
+ * @return La única transición compatible (que lee comodín en las cintas
+ *         desconocidas), o nullptr si la siguiente transición depende de la cinta
+ *         (siempre en un estado con operación nativa).
+ */
+const Transition* ChainFusion::forcedSuccessor(const State& state, const std::vector<int>& known) const {
+  if (model_.getBuiltinFrom(state.getId()) != nullptr) return nullptr;
+  const Transition* forced = nullptr;
+  for (const Transition& candidate : model_.getTransitionsFrom(state.getId())) {
+    const std::vector<Symbol>& read = candidate.getReadSymbols();
+    if ((int)read.size() != tapeCount_) return nullptr;
+    bool compatible = true;
+    for (int t = 0; t < tapeCount_ && compatible; ++t) {
+      char symbol = read[t].getValue();
+      compatible = symbol == Symbol::WILDCARD || known[t] == kUnknown || known[t] == symbol;
+    }
+    if (!compatible) continue;
+    if (forced != nullptr) return nullptr;
+    forced = &candidate;
+  }
+  if (forced == nullptr || !isFusable(*forced)) return nullptr;
+  for (int t = 0; t < tapeCount_; ++t) {
+    if (known[t] == kUnknown && forced->getReadSymbols()[t].getValue() != Symbol::WILDCARD) return nullptr;
+  }
+  return forced;
+}
+
+/**
+ * @brief Sigue la cadena forzada que empieza en una transición y la compila.
+ * 
+ * @param entry Transición de entrada (la que encuentra el simulador).
+ * @param chain Superinstrucción resultante (salida).
+ * @return true si la cadena tiene al menos dos eslabones.
+ */
+bool ChainFusion::fuse(const Transition& entry, Superinstruction& chain) const {
+  if (!isFusable(entry)) return false;
+  std::vector<int> known(tapeCount_, kUnknown);
+  std::vector<std::vector<std::pair<char, Moves>>> perTape(tapeCount_);
+  const Transition* link = &entry;
+  chain.length = 0;
+  while (true) {
+    for (const auto& pair : link->getTapeActions()) {
+      int t = pair.first;
+      char write = pair.second.first.getValue();
+      char read = link->getReadSymbols()[t].getValue();
+      Moves move = pair.second.second;
+      perTape[t].push_back(std::make_pair(write, move));
+      if (move != Moves::STAY) known[t] = kUnknown;
+      else if (write != Symbol::WILDCARD) known[t] = write;
+      else if (read != Symbol::WILDCARD) known[t] = read;
+    }
+    chain.length++;
+    chain.target = model_.getStateById(link->getTo().getId());
+    if (chain.target.isAccept() || chain.target.isDead() || chain.length == kMaxLength) break;
+    link = forcedSuccessor(chain.target, known);
+    if (link == nullptr) break;
+  }
+  if (chain.length < 2) return false;
+  for (int t = 0; t < tapeCount_; ++t) {
+    char pending = Symbol::WILDCARD;
+    for (const auto& op : perTape[t]) {
+      if (op.first != Symbol::WILDCARD) pending = op.first;
+      if (op.second == Moves::STAY) continue;
+      chain.actions.push_back(Action{t, pending, op.second});
+      pending = Symbol::WILDCARD;
+    }
+    if (pending != Symbol::WILDCARD) chain.actions.push_back(Action{t, pending, Moves::STAY});
+  }
+  return true;
+}
+
+/**
+ * @brief Aplica las escrituras y movimientos de una superinstrucción.
+ * 
+ * @param chain Superinstrucción a aplicar.
+ * @param tapes Cintas (se modifican y pueden crecer con blancos).
+ * @param heads Posiciones de los cabezales (se modifican).
+ */
+void ChainFusion::apply(const Superinstruction& chain, std::vector<std::vector<Symbol>>& tapes,
+                        std::vector<int>& heads) {
+  for (const Action& action : chain.actions) {
+    if (action.write != Symbol::WILDCARD) tapes[action.tape][heads[action.tape]] = Symbol(action.write);
+    TuringMachineSimulator::moveHead(tapes[action.tape], heads[action.tape], action.move);
+  }
+}
+
+/**
+ * @brief Muestra cuántas transiciones se han fusionado y la longitud de las cadenas.
+ */
+std::ostream& operator<<(std::ostream& os, const ChainFusion& fusion) {
+  os << "Fusión de cadenas: " << fusion.chains_.size() << " superinstrucciones de " << fusion.transitions_
+     << " transiciones";
+  if (!fusion.chains_.empty()) {
+    os << ", longitud media " << (double)fusion.fusedLinks_ / fusion.chains_.size() << " pasos (máxima "
+       << fusion.longest_ << ")";
+  }
+  return os;
+}
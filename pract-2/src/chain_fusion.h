@@ -0,0 +1,68 @@
+#ifndef CHAIN_FUSION_H
+#define CHAIN_FUSION_H
+
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+#include "moves.h"
+#include "state.h"
+#include "symbol.h"
+#include "transition.h"
+#include "turing_machine_model.h"
+
+/**
+ * @brief Fusión de cadenas deterministas de transiciones en superinstrucciones.
+ *
+ * Tras aplicar una transición, lo que hay bajo cada cabezal que no se ha
+ * movido es conocido (lo que se acaba de escribir o leer). Si en el estado
+ * destino solo una transición es compatible con esos símbolos, y lee comodín
+ * en las cintas cuyo símbolo no se conoce, esa transición es la que elegirá
+ * el TransitionMatcher sea cual sea el contenido de la cinta. Encadenando
+ * este razonamiento se obtiene, para cada transición, la secuencia de
+ * transiciones que la siguen forzosamente (hasta un estado de aceptación, un
+ * estado muerto, una bifurcación o kMaxLength eslabones).
+ *
+ * Cada cadena se compila en una superinstrucción: las escrituras y
+ * movimientos de todos sus eslabones agrupados por cinta (las escrituras
+ * consecutivas sobre la misma celda se quedan en la última), el estado final
+ * y el número de pasos que representa. El simulador la aplica de golpe en
+ * lugar de repetir búsqueda y aplicación por eslabón; el número de pasos, el
+ * veredicto y las cintas son los mismos que paso a paso.
+ *
+ * Guarda punteros a las transiciones del modelo, que debe seguir vivo (y sin
+ * moverse) mientras se use.
+ */
+class ChainFusion {
+ public:
+  struct Action {
+    int tape;
+    char write;
+    Moves move;
+  };
+  struct Superinstruction {
+    std::vector<Action> actions;
+    State target;
+    long long length;
+  };
+  static const int kMaxLength = 64;
+  explicit ChainFusion(const TuringMachineModel& model);
+  const Superinstruction* find(const Transition& entry) const {
+    auto it = chains_.find(&entry);
+    return it == chains_.end() ? nullptr : &it->second;
+  }
+  static void apply(const Superinstruction& chain, std::vector<std::vector<Symbol>>& tapes,
+                    std::vector<int>& heads);
+  friend std::ostream& operator<<(std::ostream& os, const ChainFusion& fusion);
+ private:
+  bool fuse(const Transition& entry, Superinstruction& chain) const;
+  bool isFusable(const Transition& transition) const;
+  const Transition* forcedSuccessor(const State& state, const std::vector<int>& known) const;
+  const TuringMachineModel& model_;
+  int tapeCount_;
+  std::unordered_map<const Transition*, Superinstruction> chains_;
+  long long transitions_;
+  long long fusedLinks_;
+  long long longest_;
+};
+
+#endif
@@ -0,0 +1,95 @@
+#include "checkpointer.h"
+#include <csignal>
+#include "snapshot.h"
+
+namespace {
+
+volatile std::sig_atomic_t suspendFlag = 0;
+
+void onSuspendSignal(int) {
+  suspendFlag = 1;
+}
+
+// Cada cuántos pasos se consulta el reloj cuando la política es por tiempo.
+const long long kClockCheckMask = 1023;
+
+}  // namespace
+
+/**
+ * @brief Constructor de la política de instantáneas.
+ *
+ * @param path Fichero donde se guardan las instantáneas.
+ * @param everySteps Guardar cada este número de pasos (0 para desactivar).
+ * @param everySeconds Guardar cada estos segundos (0 para desactivar).
+ * @param fingerprint Huella del modelo que se está simulando.
+ */
+Checkpointer::Checkpointer(const std::string& path, long long everySteps, double everySeconds, uint64_t fingerprint)
+  : path_(path), everySteps_(everySteps), everySeconds_(everySeconds), fingerprint_(fingerprint),
+    inputIndex_(0), resultOffset_(0), lastSavedSteps_(0),
+    lastSavedTime_(std::chrono::steady_clock::now()) {
+}
+
+/**
+ * @brief Instala los manejadores de SIGINT y SIGTERM que piden la suspensión.
+ *
+ * El manejador solo activa un flag; el simulador lo consulta entre pasos y
+ * devuelve RunStatus::SUSPENDED con la configuración intacta.
+ */
+void Checkpointer::installSignalHandlers() const {
+  std::signal(SIGINT, onSuspendSignal);
+  std::signal(SIGTERM, onSuspendSignal);
+}
+
+/**
+ * @brief Indica qué cadena del lote empieza a simularse.
+ *
+ * @param inputIndex Índice de la cadena (contando solo líneas no vacías).
+ * @param input Cadena tal y como aparece en el fichero de cadenas.
+ * @param resultOffset Tamaño de FileOut.txt antes de escribir su resultado.
+ */
+void Checkpointer::beginInput(uint64_t inputIndex, const std::string& input, uint64_t resultOffset) {
+  inputIndex_ = inputIndex;
+  input_ = input;
+  resultOffset_ = resultOffset;
+  lastSavedSteps_ = 0;
+}
+
+/**
+ * @brief Notificación de paso ejecutado; guarda instantánea si la política lo indica.
+ *
+ * El reloj solo se consulta cada 1024 pasos para que el coste en el bucle
+ * principal sea despreciable.
+ *
+ * @param configuration Configuración actual de la MT.
+ */
+void Checkpointer::onStep(const Configuration& configuration) {
+  long long steps = configuration.getSteps();
+  if (everySteps_ > 0 && steps - lastSavedSteps_ >= everySteps_) {
+    save(configuration);
+    return;
+  }
+  if (everySeconds_ > 0 && (steps & kClockCheckMask) == 0) {
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - lastSavedTime_;
+    if (elapsed.count() >= everySeconds_) save(configuration);
+  }
+}
+
+/**
+ * @brief Guarda inmediatamente una instantánea de la configuración dada.
+ *
+ * @param configuration Configuración actual de la MT.
+ */
+void Checkpointer::save(const Configuration& configuration) {
+  Snapshot(fingerprint_, inputIndex_, resultOffset_, input_, configuration).save(path_);
+  lastSavedSteps_ = configuration.getSteps();
+  lastSavedTime_ = std::chrono::steady_clock::now();
+}
+
+/**
+ * @brief Indica si se ha recibido una señal de suspensión.
+ *
+ * @return true si se debe suspender la ejecución en curso.
+ */
+bool Checkpointer::suspendRequested() const {
+  return suspendFlag != 0;
+}
@@ -0,0 +1,38 @@
+#ifndef CHECKPOINTER_H
+#define CHECKPOINTER_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include "configuration.h"
+
+/**
+ * @brief Política de instantáneas periódicas y suspensión de ejecuciones largas.
+ *
+ * El simulador le notifica cada paso ejecutado; el Checkpointer decide si toca
+ * guardar una instantánea (cada N pasos y/o cada N segundos) y si se ha pedido
+ * suspender la ejecución con SIGINT o SIGTERM. Conoce además en qué cadena del
+ * lote se está trabajando, que es lo que necesita la instantánea para reanudar.
+ */
+class Checkpointer {
+ public:
+  Checkpointer(const std::string& path, long long everySteps, double everySeconds, uint64_t fingerprint);
+  void installSignalHandlers() const;
+  void beginInput(uint64_t inputIndex, const std::string& input, uint64_t resultOffset);
+  void onStep(const Configuration& configuration);
+  void save(const Configuration& configuration);
+  bool suspendRequested() const;
+  const std::string& getPath() const { return path_; }
+ private:
+  std::string path_;
+  long long everySteps_;
+  double everySeconds_;
+  uint64_t fingerprint_;
+  uint64_t inputIndex_;
+  uint64_t resultOffset_;
+  std::string input_;
+  long long lastSavedSteps_;
+  std::chrono::steady_clock::time_point lastSavedTime_;
+};
+
+#endif
@@ -0,0 +1,397 @@
+#include "compact_model.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char kCompactMagic[8] = {'P', 'T', 'M', 'C', 'M', 'O', 'D', '1'};
+
+uint64_t alignTo8(uint64_t value) {
+  return (value + 7) & ~static_cast<uint64_t>(7);
+}
+
+/**
+ * @brief Orden de especificidad entre dos patrones de lectura.
+ *
+ * Cinta a cinta, un símbolo concreto va antes que el comodín; entre símbolos
+ * concretos distintos el orden es arbitrario (nunca coinciden ambos a la vez).
+ */
+bool moreSpecific(const uint8_t* a, const uint8_t* b, int tapeCount) {
+  for (int t = 0; t < tapeCount; ++t) {
+    bool wa = a[t] == static_cast<uint8_t>(Symbol::WILDCARD);
+    bool wb = b[t] == static_cast<uint8_t>(Symbol::WILDCARD);
+    if (wa != wb) return !wa;
+    if (!wa && a[t] != b[t]) return a[t] < b[t];
+  }
+  return false;
+}
+
+// Comprueba que count elementos de width bytes a partir de offset caben en size bytes (sin desbordar).
+bool fits(uint64_t offset, uint64_t count, uint64_t width, uint64_t size) {
+  return offset <= size && (width == 0 || count <= (size - offset) / width);
+}
+
+}  // namespace
+
+/**
+ * @brief Constructor del builder.
+ *
+ * @param stateNames Nombres de todos los estados (su posición es su id entero).
+ * @param tapeCount Número de cintas de la máquina (fija el tamaño del registro).
+ * @throws std::runtime_error si hay nombres de estado repetidos.
+ */
+CompactModelBuilder::CompactModelBuilder(const std::vector<std::string>& stateNames, int tapeCount)
+  : names_(stateNames), flags_(stateNames.size(), 0), tapeCount_(tapeCount), initial_(0) {
+  for (size_t i = 0; i < names_.size(); ++i) {
+    if (!stateIds_.insert(std::make_pair(names_[i], (uint32_t)i)).second) {
+      throw std::runtime_error("Estado repetido: " + names_[i]);
+    }
+  }
+  stride_ = (4 + 3 * tapeCount_ + 3) & ~3u;
+}
+
+/**
+ * @brief Devuelve el id entero de un estado.
+ *
+ * @param name Nombre del estado.
+ * @return Id entero del estado.
+ * @throws std::runtime_error si el estado no existe.
+ */
+uint32_t CompactModelBuilder::stateIndex(const std::string& name) const {
+  auto it = stateIds_.find(name);
+  if (it == stateIds_.end()) throw std::runtime_error("Estado no encontrado: " + name);
+  return it->second;
+}
+
+/**
+ * @brief Añade una transición como registro de tamaño fijo.
+ *
+ * @param from Estado origen.
+ * @param to Estado destino.
+ * @param read Símbolo de lectura por cinta.
+ * @param write Símbolo de escritura por cinta.
+ * @param moves Movimiento por cinta.
+ * @throws std::runtime_error si la transición no tiene exactamente una acción por cinta.
+ */
+void CompactModelBuilder::addTransition(uint32_t from, uint32_t to, const std::vector<char>& read,
+                                        const std::vector<char>& write, const std::vector<Moves>& moves) {
+  if ((int)read.size() != tapeCount_ || (int)write.size() != tapeCount_ || (int)moves.size() != tapeCount_) {
+    throw std::runtime_error(
+      "Error: La transición desde el estado '" + names_[from] + "' tiene " + std::to_string(read.size()) +
+      " cintas, pero el modelo compacto tiene " + std::to_string(tapeCount_) + " cintas");
+  }
+  size_t offset = pending_.size();
+  pending_.resize(offset + stride_, 0);
+  uint8_t* record = &pending_[offset];
+  std::memcpy(record, &to, 4);
+  for (int t = 0; t < tapeCount_; ++t) {
+    record[4 + t] = static_cast<uint8_t>(read[t]);
+    record[4 + tapeCount_ + 2 * t] = static_cast<uint8_t>(write[t]);
+    record[4 + tapeCount_ + 2 * t + 1] = static_cast<uint8_t>(moves[t]);
+  }
+  from_.push_back(from);
+}
+
+/**
+ * @brief Genera la arena final y libera los buffers temporales.
+ *
+ * @return Modelo compacto.
+ */
+CompactModel CompactModelBuilder::build() {
+  uint32_t stateCount = names_.size();
+  uint64_t transitionCount = from_.size();
+  uint64_t nameBytes = 0;
+  for (const auto& name : names_) nameBytes += name.size();
+
+  CompactModel::Header header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, kCompactMagic, sizeof(kCompactMagic));
+  header.version = 2;
+  header.tapeCount = tapeCount_;
+  header.stateCount = stateCount;
+  header.initialState = initial_;
+  header.transitionCount = transitionCount;
+  header.recordStride = stride_;
+  header.flagsOffset = alignTo8(sizeof(header));
+  header.indexOffset = alignTo8(header.flagsOffset + stateCount);
+  header.recordsOffset = alignTo8(header.indexOffset + 8 * (uint64_t(stateCount) + 1));
+  header.namesOffset = alignTo8(header.recordsOffset + transitionCount * stride_);
+  header.nameDataOffset = header.namesOffset + 8 * (uint64_t(stateCount) + 1);
+  header.totalSize = alignTo8(header.nameDataOffset + nameBytes);
+
+  std::shared_ptr<std::vector<uint8_t>> arena = std::make_shared<std::vector<uint8_t>>(header.totalSize, 0);
+  uint8_t* base = arena->data();
+  std::memcpy(base, &header, sizeof(header));
+  if (stateCount > 0) std::memcpy(base + header.flagsOffset, flags_.data(), stateCount);
+
+  uint64_t* index = reinterpret_cast<uint64_t*>(base + header.indexOffset);
+  for (uint64_t i = 0; i < transitionCount; ++i) index[from_[i] + 1]++;
+  for (uint32_t s = 0; s < stateCount; ++s) index[s + 1] += index[s];
+  std::vector<uint64_t> cursor(index, index + stateCount);
+  uint8_t* records = base + header.recordsOffset;
+  std::vector<bool> hasWildcard(stateCount, false);
+  for (uint64_t i = 0; i < transitionCount; ++i) {
+    uint32_t from = from_[i];
+    const uint8_t* source = &pending_[i * stride_];
+    for (int t = 0; t < tapeCount_; ++t) {
+      if (source[4 + t] == static_cast<uint8_t>(Symbol::WILDCARD)) hasWildcard[from] = true;
+    }
+    std::memcpy(records + cursor[from]++ * stride_, source, stride_);
+  }
+  std::vector<uint8_t>().swap(pending_);
+  std::vector<uint32_t>().swap(from_);
+
+  // Solo los estados con comodines necesitan reordenarse por especificidad.
+  for (uint32_t s = 0; s < stateCount; ++s) {
+    uint64_t count = index[s + 1] - index[s];
+    if (!hasWildcard[s] || count < 2) continue;
+    std::vector<uint8_t> block(records + index[s] * stride_, records + index[s + 1] * stride_);
+    std::vector<uint64_t> order(count);
+    for (uint64_t i = 0; i < count; ++i) order[i] = i;
+    int tapeCount = tapeCount_;
+    uint32_t stride = stride_;
+    std::stable_sort(order.begin(), order.end(), [&](uint64_t a, uint64_t b) {
+      return moreSpecific(&block[a * stride + 4], &block[b * stride + 4], tapeCount);
+    });
+    for (uint64_t i = 0; i < count; ++i) {
+      std::memcpy(records + (index[s] + i) * stride_, &block[order[i] * stride_], stride_);
+    }
+  }
+
+  uint64_t* nameOffsets = reinterpret_cast<uint64_t*>(base + header.namesOffset);
+  uint64_t nameCursor = 0;
+  for (uint32_t s = 0; s < stateCount; ++s) {
+    nameOffsets[s] = nameCursor;
+    std::memcpy(base + header.nameDataOffset + nameCursor, names_[s].data(), names_[s].size());
+    nameCursor += names_[s].size();
+  }
+  nameOffsets[stateCount] = nameCursor;
+
+  CompactModel model;
+  model.owner_ = arena;
+  model.data_ = base;
+  model.size_ = header.totalSize;
+  return model;
+}
+
+/**
+ * @brief Convierte un TuringMachineModel (p. ej. ya optimizado) al formato compacto.
+ *
+ * @param model Modelo de partida.
+ * @return Modelo compacto equivalente.
+ * @throws std::runtime_error si la MT tiene operaciones nativas.
+ */
+CompactModel CompactModel::fromModel(const TuringMachineModel& model) {
+  if (!model.getBuiltins().empty()) {
+    throw std::runtime_error("El formato compacto no admite operaciones nativas (estado " +
+                             model.getBuiltins().begin()->first + ")");
+  }
+  std::vector<std::string> names;
+  for (const auto& statePair : model.getStates()) names.push_back(statePair.first);
+  std::sort(names.begin(), names.end());
+  int tapeCount = model.determineTapeCount();
+  CompactModelBuilder builder(names, tapeCount);
+  for (const auto& statePair : model.getStates()) {
+    uint32_t id = builder.stateIndex(statePair.first);
+    if (statePair.second.isAccept()) builder.setAccept(id);
+    if (statePair.second.isDead()) builder.setDead(id);
+  }
+  builder.setInitial(builder.stateIndex(model.getInitialStateId()));
+  std::vector<char> read, write;
+  std::vector<Moves> moves;
+  for (const auto& transPair : model.getTransitions()) {
+    for (const auto& transition : transPair.second) {
+      read.clear();
+      write.clear();
+      moves.clear();
+      for (const auto& symbol : transition.getReadSymbols()) read.push_back(symbol.getValue());
+      for (const auto& action : transition.getTapeActions()) {
+        write.push_back(action.second.first.getValue());
+        moves.push_back(action.second.second);
+      }
+      builder.addTransition(builder.stateIndex(transition.getFrom().getId()),
+                            builder.stateIndex(transition.getTo().getId()), read, write, moves);
+    }
+  }
+  return builder.build();
+}
+
+/**
+ * @brief Guarda la arena en disco tal cual, para proyectarla después con map().
+ *
+ * La escritura es atómica (fichero temporal propio del proceso + fsync +
+ * rename), así que varios procesos pueden compilar el mismo modelo a la vez sin
+ * que ninguno llegue a ver un fichero a medias. Si el fsync falla, el temporal
+ * se borra sin renombrarlo.
+ *
+ * @param path Fichero de destino.
+ * @param sourceHash Huella del origen del modelo (para invalidar la caché).
+ * @throws std::runtime_error si no se puede escribir.
+ */
+void CompactModel::save(const std::string& path, uint64_t sourceHash) const {
+  Header stamped = header();
+  stamped.sourceHash = sourceHash;
+  const std::string tmpPath = path + ".tmp." + std::to_string(::getpid());
+  int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) throw std::runtime_error("No se pudo crear el modelo compilado: " + tmpPath);
+  const uint8_t* parts[2] = {reinterpret_cast<const uint8_t*>(&stamped), data_ + sizeof(Header)};
+  size_t sizes[2] = {sizeof(Header), size_ - sizeof(Header)};
+  for (int i = 0; i < 2; ++i) {
+    size_t written = 0;
+    while (written < sizes[i]) {
+      ssize_t n = ::write(fd, parts[i] + written, sizes[i] - written);
+      if (n < 0) {
+        ::close(fd);
+        ::unlink(tmpPath.c_str());
+        throw std::runtime_error("Error escribiendo el modelo compilado: " + tmpPath);
+      }
+      written += n;
+    }
+  }
+  if (::fsync(fd) != 0) {
+    ::close(fd);
+    ::unlink(tmpPath.c_str());
+    throw std::runtime_error("Error volcando el modelo compilado a disco: " + tmpPath);
+  }
+  ::close(fd);
+  if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+    throw std::runtime_error("No se pudo renombrar el modelo compilado a: " + path);
+  }
+}
+
+/**
+ * @brief Proyecta en memoria (solo lectura, compartida) un modelo guardado con save().
+ *
+ * Las páginas las comparte el núcleo entre todos los procesos que proyectan el
+ * mismo fichero; la proyección se libera cuando se destruye la última copia
+ * del CompactModel.
+ *
+ * @param path Fichero del modelo compilado.
+ * @return Modelo compacto que apunta directamente a la proyección.
+ * @throws std::runtime_error si el fichero no existe o no es un modelo compilado válido.
+ */
+CompactModel CompactModel::map(const std::string& path) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) throw std::runtime_error("No se pudo abrir el modelo compilado: " + path);
+  struct stat info;
+  if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header)) {
+    ::close(fd);
+    throw std::runtime_error("Modelo compilado no válido: " + path);
+  }
+  size_t size = info.st_size;
+  void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) throw std::runtime_error("No se pudo proyectar el modelo compilado: " + path);
+  std::shared_ptr<const void> owner(mapping, [size](const void* p) { ::munmap(const_cast<void*>(p), size); });
+  const Header* header = static_cast<const Header*>(mapping);
+  if (std::memcmp(header->magic, kCompactMagic, sizeof(kCompactMagic)) != 0 || header->version != 2 ||
+      header->totalSize != size) {
+    throw std::runtime_error("Modelo compilado no válido o de otra versión: " + path);
+  }
+  CompactModel model;
+  model.owner_ = owner;
+  model.data_ = static_cast<const uint8_t*>(mapping);
+  model.size_ = size;
+  if (!model.isConsistent()) throw std::runtime_error("Modelo compilado corrupto: " + path);
+  return model;
+}
+
+/**
+ * @brief Comprueba que la arena es coherente antes de usarla.
+ *
+ * Un fichero con la cabecera correcta puede estar dañado o editado: cada
+ * sección tiene que caber en la arena (y las de enteros de 64 bits estar
+ * alineadas), el índice CSR y el de nombres tienen que ser crecientes y
+ * acabar donde acaba su sección, y cada registro tiene que apuntar a un
+ * estado existente con movimientos válidos. Recorre todos los registros.
+ *
+ * @return true si el simulador puede usar la arena sin salirse de ella.
+ */
+bool CompactModel::isConsistent() const {
+  const Header& h = header();
+  uint64_t states = h.stateCount;
+  if (states == 0 || h.initialState >= states || h.tapeCount == 0 || h.tapeCount > (1u << 20) ||
+      h.recordStride != ((4 + 3 * h.tapeCount + 3) & ~3u)) {
+    return false;
+  }
+  if (h.flagsOffset < sizeof(Header) || !fits(h.flagsOffset, states, 1, size_) || h.indexOffset % 8 != 0 ||
+      !fits(h.indexOffset, states + 1, 8, size_) || !fits(h.recordsOffset, h.transitionCount, h.recordStride, size_) ||
+      h.namesOffset % 8 != 0 || !fits(h.namesOffset, states + 1, 8, size_) || h.nameDataOffset > size_) {
+    return false;
+  }
+  const uint64_t* csr = index();
+  if (csr[0] != 0 || csr[states] != h.transitionCount) return false;
+  for (uint64_t s = 0; s < states; ++s) {
+    if (csr[s] > csr[s + 1]) return false;
+  }
+  const uint64_t* names = reinterpret_cast<const uint64_t*>(data_ + h.namesOffset);
+  if (names[0] != 0 || !fits(h.nameDataOffset, names[states], 1, size_)) return false;
+  for (uint64_t s = 0; s < states; ++s) {
+    if (names[s] > names[s + 1]) return false;
+  }
+  for (uint64_t i = 0; i < h.transitionCount; ++i) {
+    const uint8_t* current = record(i);
+    if (recordTarget(current) >= states) return false;
+    const uint8_t* actions = recordActions(current);
+    for (uint32_t t = 0; t < h.tapeCount; ++t) {
+      if (actions[2 * t + 1] > static_cast<uint8_t>(Moves::STAY)) return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Devuelve el nombre original de un estado.
+ *
+ * @param state Id entero del estado.
+ * @return Nombre del estado.
+ */
+std::string CompactModel::getStateName(uint32_t state) const {
+  const uint64_t* offsets = reinterpret_cast<const uint64_t*>(data_ + header().namesOffset);
+  const char* names = reinterpret_cast<const char*>(data_ + header().nameDataOffset);
+  return std::string(names + offsets[state], names + offsets[state + 1]);
+}
+
+/**
+ * @brief Lee el estado destino de un registro.
+ *
+ * @param record Puntero al registro.
+ * @return Id entero del estado destino.
+ */
+uint32_t CompactModel::recordTarget(const uint8_t* record) {
+  uint32_t to;
+  std::memcpy(&to, record, 4);
+  return to;
+}
+
+/**
+ * @brief Bytes de arena por transición (incluye estados, índice y nombres).
+ *
+ * @return Tamaño total de la arena dividido entre el número de transiciones.
+ */
+double CompactModel::bytesPerTransition() const {
+  if (getTransitionCount() == 0) return 0;
+  return static_cast<double>(size_) / getTransitionCount();
+}
+
+/**
+ * @brief Imprime un resumen del modelo compacto.
+ *
+ * @param os Stream de salida.
+ * @param model Modelo compacto.
+ * @return Referencia al stream de salida para permitir encadenamiento.
+ */
+std::ostream& operator<<(std::ostream& os, const CompactModel& model) {
+  os << "Modelo compacto:\n";
+  os << "  Estados: " << model.getStateCount() << ", transiciones: " << model.getTransitionCount()
+     << ", cintas: " << model.getTapeCount() << "\n";
+  os << "  Arena: " << model.getByteSize() << " bytes (registro de " << model.getRecordStride()
+     << " bytes, " << model.bytesPerTransition() << " bytes/transición)\n";
+  return os;
+}
@@ -0,0 +1,119 @@
+#ifndef COMPACT_MODEL_H
+#define COMPACT_MODEL_H
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "moves.h"
+#include "turing_machine_model.h"
+
+/**
+ * @brief Representación compacta de una Máquina de Turing para modelos enormes.
+ *
+ * Todo el modelo vive en un único bloque contiguo de memoria (arena):
+ *
+ *   cabecera | flags por estado | índice CSR por estado | registros | nombres
+ *
+ * Cada transición es un registro POD de tamaño fijo (para una máquina de k cintas):
+ *   uint32 destino | k bytes de lectura | k pares (byte escritura, byte movimiento)
+ * redondeado a múltiplo de 4. Los estados son enteros y las transiciones de un
+ * mismo estado son contiguas, de modo que no hay ni una sola reserva de memoria
+ * por transición. Dentro de cada estado los registros se ordenan del más
+ * específico al más general (el comodín va detrás de los símbolos concretos, cinta
+ * a cinta), así la primera coincidencia equivale a la del TransitionMatcher.
+ *
+ * La arena no contiene punteros, por lo que puede copiarse tal cual a disco
+ * (save) y proyectarse en memoria de solo lectura (map), compartida entre
+ * todos los procesos que usan el mismo fichero.
+ */
+class CompactModel {
+ public:
+  static const uint8_t FLAG_ACCEPT = 1;
+  static const uint8_t FLAG_DEAD = 2;
+  CompactModel() : data_(nullptr), size_(0) {}
+  static CompactModel fromModel(const TuringMachineModel& model);
+  static CompactModel map(const std::string& path);
+  void save(const std::string& path, uint64_t sourceHash) const;
+  uint64_t getSourceHash() const { return header().sourceHash; }
+  int getTapeCount() const { return header().tapeCount; }
+  uint32_t getStateCount() const { return header().stateCount; }
+  uint64_t getTransitionCount() const { return header().transitionCount; }
+  uint32_t getInitialState() const { return header().initialState; }
+  uint32_t getRecordStride() const { return header().recordStride; }
+  bool isAccept(uint32_t state) const { return (flags()[state] & FLAG_ACCEPT) != 0; }
+  bool isDead(uint32_t state) const { return (flags()[state] & FLAG_DEAD) != 0; }
+  std::string getStateName(uint32_t state) const;
+  uint64_t firstTransition(uint32_t state) const { return index()[state]; }
+  uint64_t endTransition(uint32_t state) const { return index()[state + 1]; }
+  const uint8_t* record(uint64_t transition) const {
+    return data_ + header().recordsOffset + transition * header().recordStride;
+  }
+  static uint32_t recordTarget(const uint8_t* record);
+  static const uint8_t* recordRead(const uint8_t* record) { return record + 4; }
+  const uint8_t* recordActions(const uint8_t* record) const { return record + 4 + header().tapeCount; }
+  const uint8_t* getData() const { return data_; }
+  uint64_t getByteSize() const { return size_; }
+  double bytesPerTransition() const;
+  friend std::ostream& operator<<(std::ostream& os, const CompactModel& model);
+ private:
+  friend class CompactModelBuilder;
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t tapeCount;
+    uint32_t stateCount;
+    uint32_t initialState;
+    uint64_t transitionCount;
+    uint32_t recordStride;
+    uint32_t reserved;
+    uint64_t flagsOffset;
+    uint64_t indexOffset;
+    uint64_t recordsOffset;
+    uint64_t namesOffset;
+    uint64_t nameDataOffset;
+    uint64_t totalSize;
+    uint64_t sourceHash;
+  };
+  const Header& header() const { return *reinterpret_cast<const Header*>(data_); }
+  bool isConsistent() const;
+  const uint8_t* flags() const { return data_ + header().flagsOffset; }
+  const uint64_t* index() const { return reinterpret_cast<const uint64_t*>(data_ + header().indexOffset); }
+  std::shared_ptr<const void> owner_;
+  const uint8_t* data_;
+  uint64_t size_;
+};
+
+/**
+ * @brief Construye un CompactModel registro a registro.
+ *
+ * Las transiciones se van añadiendo en orden de llegada a un buffer temporal
+ * de registros del mismo tamaño fijo; build() las agrupa por estado origen
+ * (ordenación por cuenta, estable) y las ordena por especificidad.
+ */
+class CompactModelBuilder {
+ public:
+  CompactModelBuilder(const std::vector<std::string>& stateNames, int tapeCount);
+  uint32_t stateIndex(const std::string& name) const;
+  bool hasState(const std::string& name) const { return stateIds_.count(name) > 0; }
+  void setInitial(uint32_t state) { initial_ = state; }
+  void setAccept(uint32_t state) { flags_[state] |= CompactModel::FLAG_ACCEPT; }
+  void setDead(uint32_t state) { flags_[state] |= CompactModel::FLAG_DEAD; }
+  void addTransition(uint32_t from, uint32_t to, const std::vector<char>& read,
+                     const std::vector<char>& write, const std::vector<Moves>& moves);
+  int getTapeCount() const { return tapeCount_; }
+  CompactModel build();
+ private:
+  std::vector<std::string> names_;
+  std::unordered_map<std::string, uint32_t> stateIds_;
+  std::vector<uint8_t> flags_;
+  std::vector<uint32_t> from_;
+  std::vector<uint8_t> pending_;
+  int tapeCount_;
+  uint32_t stride_;
+  uint32_t initial_;
+};
+
+#endif
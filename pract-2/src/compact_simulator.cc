@@ -0,0 +1,157 @@
+#include "compact_simulator.h"
+#include "turing_machine_simulator.h"
+
+/**
+ * @brief Cinta con hueco libre por la izquierda para crecer en O(1) amortizado.
+ *
+ * Las celdas válidas son buffer[begin, end); la posición lógica 0 es begin.
+ */
+struct CompactSimulator::GrowableTape {
+  std::vector<char> buffer;
+  size_t begin;
+  size_t end;
+  size_t head;
+
+  void growLeft() {
+    size_t extra = buffer.size() + 16;
+    std::vector<char> bigger(buffer.size() + extra, '.');
+    std::copy(buffer.begin() + begin, buffer.begin() + end, bigger.begin() + begin + extra);
+    begin += extra;
+    end += extra;
+    head += extra;
+    buffer.swap(bigger);
+  }
+};
+
+/**
+ * @brief Constructor del simulador compacto.
+ * 
+ * @param model Modelo compacto que se va a simular.
+ */
+CompactSimulator::CompactSimulator(const CompactModel& model)
+  : model_(model), maxSteps_(TuringMachineSimulator::DEFAULT_MAX_STEPS) {
+}
+
+/**
+ * @brief Simula la MT sobre una cadena de entrada.
+ * 
+ * @param input Cadena de entrada (se modifica para contener la cinta 0 final al terminar).
+ * @param steps Número de pasos ejecutados (salida).
+ * @return Motivo por el que se detuvo la ejecución.
+ */
+RunStatus CompactSimulator::compute(String& input, long long& steps) const {
+  std::vector<GrowableTape> tapes;
+  RunStatus status = execute(input, steps, tapes);
+  const GrowableTape& result = tapes[0];
+  input = String(std::vector<Symbol>(result.buffer.begin() + result.begin, result.buffer.begin() + result.end));
+  return status;
+}
+
+/**
+ * @brief Simula la MT y añade al buffer la proyección de las cintas finales.
+ * 
+ * Las cintas se leen directamente de los buffers del motor; con el modo solo
+ * veredicto no se extrae nada.
+ * 
+ * @param input Cadena de entrada.
+ * @param steps Número de pasos ejecutados (salida).
+ * @param projection Cintas y modo de salida.
+ * @param out Buffer de salida (se le añade el resultado).
+ * @return Motivo por el que se detuvo la ejecución.
+ */
+RunStatus CompactSimulator::compute(const String& input, long long& steps, const ResultProjection& projection,
+                                    std::string& out) const {
+  std::vector<GrowableTape> tapes;
+  RunStatus status = execute(input, steps, tapes);
+  if (projection.isVerdictOnly()) return status;
+  std::vector<TapeView> views(tapes.size());
+  for (size_t t = 0; t < tapes.size(); ++t) {
+    views[t].cells = tapes[t].buffer.data() + tapes[t].begin;
+    views[t].size = tapes[t].end - tapes[t].begin;
+    views[t].head = tapes[t].head - tapes[t].begin;
+  }
+  projection.write(out, views);
+  return status;
+}
+
+/**
+ * @brief Bucle principal del motor compacto.
+ * 
+ * Para cada paso lee los símbolos bajo los cabezales y recorre los registros
+ * contiguos del estado actual (ya ordenados por especificidad) hasta el primero
+ * que coincide; después escribe, mueve y cambia de estado.
+ * 
+ * @param input Cadena de entrada.
+ * @param steps Número de pasos ejecutados (salida).
+ * @param tapes Cintas finales (salida).
+ * @return Motivo por el que se detuvo la ejecución.
+ */
+RunStatus CompactSimulator::execute(const String& input, long long& steps, std::vector<GrowableTape>& tapes) const {
+  int tapeCount = model_.getTapeCount();
+  tapes.assign(tapeCount, GrowableTape());
+  for (int t = 0; t < tapeCount; ++t) {
+    GrowableTape& tape = tapes[t];
+    if (t == 0) {
+      for (const auto& symbol : input.getSymbols()) tape.buffer.push_back(symbol.getValue());
+    }
+    if (tape.buffer.empty()) tape.buffer.push_back('.');
+    tape.begin = 0;
+    tape.end = tape.buffer.size();
+    tape.head = 0;
+  }
+  std::vector<uint8_t> current(tapeCount);
+  uint32_t state = model_.getInitialState();
+  RunStatus status = RunStatus::RUNNING;
+  steps = 0;
+  while (status == RunStatus::RUNNING) {
+    if (model_.isAccept(state)) {
+      status = RunStatus::ACCEPTED;
+      break;
+    }
+    if (model_.isDead(state)) {
+      status = RunStatus::REJECTED;
+      break;
+    }
+    for (int t = 0; t < tapeCount; ++t) current[t] = tapes[t].buffer[tapes[t].head];
+    const uint8_t* found = nullptr;
+    for (uint64_t i = model_.firstTransition(state); i < model_.endTransition(state); ++i) {
+      const uint8_t* record = model_.record(i);
+      const uint8_t* read = CompactModel::recordRead(record);
+      int t = 0;
+      while (t < tapeCount && (read[t] == current[t] || read[t] == static_cast<uint8_t>(Symbol::WILDCARD))) ++t;
+      if (t == tapeCount) {
+        found = record;
+        break;
+      }
+    }
+    if (found == nullptr) {
+      status = RunStatus::REJECTED;
+      break;
+    }
+    const uint8_t* actions = model_.recordActions(found);
+    for (int t = 0; t < tapeCount; ++t) {
+      GrowableTape& tape = tapes[t];
+      char write = static_cast<char>(actions[2 * t]);
+      if (write != Symbol::WILDCARD) tape.buffer[tape.head] = write;
+      Moves move = static_cast<Moves>(actions[2 * t + 1]);
+      if (move == Moves::LEFT) {
+        if (tape.head == tape.begin) {
+          if (tape.begin == 0) tape.growLeft();
+          tape.buffer[--tape.begin] = '.';
+        }
+        tape.head--;
+      } else if (move == Moves::RIGHT) {
+        tape.head++;
+        if (tape.head == tape.end) {
+          if (tape.end == tape.buffer.size()) tape.buffer.push_back('.');
+          else tape.buffer[tape.end] = '.';
+          tape.end++;
+        }
+      }
+    }
+    state = CompactModel::recordTarget(found);
+    steps++;
+    if (steps > maxSteps_) status = RunStatus::STEP_LIMIT;
+  }
+  return status;
+}
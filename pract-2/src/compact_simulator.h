@@ -0,0 +1,32 @@
+#ifndef COMPACT_SIMULATOR_H
+#define COMPACT_SIMULATOR_H
+
+#include <vector>
+#include "compact_model.h"
+#include "configuration.h"
+#include "result_projection.h"
+#include "string.h"
+
+/**
+ * @brief Motor de ejecución sobre un CompactModel.
+ *
+ * Misma semántica que TuringMachineSimulator::compute() (cintas que crecen
+ * con blancos por ambos extremos, límite de pasos, rechazo en estados muertos,
+ * comodines), pero trabaja con estados enteros y registros de transición
+ * empaquetados, sin traza ni instantáneas. Pensado para modelos enormes.
+ */
+class CompactSimulator {
+ public:
+  explicit CompactSimulator(const CompactModel& model);
+  RunStatus compute(String& input, long long& steps) const;
+  RunStatus compute(const String& input, long long& steps, const ResultProjection& projection,
+                    std::string& out) const;
+  void setMaxSteps(long long maxSteps) { maxSteps_ = maxSteps; }
+ private:
+  struct GrowableTape;
+  RunStatus execute(const String& input, long long& steps, std::vector<GrowableTape>& tapes) const;
+  const CompactModel& model_;
+  long long maxSteps_;
+};
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef CONFIGURATION_H
+#define CONFIGURATION_H
+
+#include <vector>
+#include "state.h"
+#include "symbol.h"
+
+/**
+ * @brief Resultado (o situación actual) de una ejecución de la MT.
+ */
+enum class RunStatus { RUNNING, ACCEPTED, REJECTED, STEP_LIMIT, SUSPENDED };
+
+/**
+ * @brief Configuración instantánea de una Máquina de Turing multicinta.
+ *
+ * Agrupa todo lo necesario para continuar una ejecución en cualquier momento:
+ * estado actual, contenido de las cintas, posición de los cabezales y número
+ * de pasos ejecutados. Sacarla de la pila de compute() permite suspender,
+ * serializar y reanudar una simulación.
+ */
+class Configuration {
+ public:
+  Configuration() : steps_(0) {}
+  const State& getState() const { return state_; }
+  State& getState() { return state_; }
+  void setState(const State& state) { state_ = state; }
+  const std::vector<std::vector<Symbol>>& getTapes() const { return tapes_; }
+  std::vector<std::vector<Symbol>>& getTapes() { return tapes_; }
+  const std::vector<int>& getHeads() const { return heads_; }
+  std::vector<int>& getHeads() { return heads_; }
+  long long getSteps() const { return steps_; }
+  void setSteps(long long steps) { steps_ = steps; }
+  void incrementSteps() { steps_++; }
+ private:
+  State state_;
+  std::vector<std::vector<Symbol>> tapes_;
+  std::vector<int> heads_;
+  long long steps_;
+};
+
+#endif
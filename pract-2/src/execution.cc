@@ -0,0 +1,51 @@
+#include "execution.h"
+
+/**
+ * @brief Crea la ejecución con la configuración inicial de la cadena.
+ * 
+ * @param simulator Simulador de la MT (no se toma su propiedad).
+ * @param index Índice de la cadena en el lote.
+ * @param input Cadena tal como aparece en el fichero (para el resultado).
+ * @param string Cadena de entrada ya convertida a símbolos.
+ */
+Execution::Execution(const TuringMachineSimulator& simulator, uint64_t index, const std::string& input,
+                     const String& string)
+  : simulator_(&simulator),
+    index_(index),
+    input_(input),
+    configuration_(simulator.start(string)),
+    status_(RunStatus::RUNNING),
+    started_(Clock::now()) {
+}
+
+/**
+ * @brief Crea la ejecución de una entrada que llega poco a poco por un descriptor.
+ * 
+ * @param simulator Simulador de la MT (no se toma su propiedad).
+ * @param index Índice de la entrada en el lote.
+ * @param input Origen tal como aparece en el fichero (para el resultado).
+ * @param stream Entrada de la cinta 0 (la ejecución toma su propiedad).
+ */
+Execution::Execution(const TuringMachineSimulator& simulator, uint64_t index, const std::string& input,
+                     std::unique_ptr<StreamTape> stream)
+  : simulator_(&simulator),
+    index_(index),
+    input_(input),
+    configuration_(simulator.start(std::vector<Symbol>())),
+    stream_(std::move(stream)),
+    status_(RunStatus::RUNNING),
+    started_(Clock::now()) {
+}
+
+/**
+ * @brief Avanza la ejecución como mucho quantum pasos.
+ * 
+ * @param quantum Número máximo de transiciones a aplicar.
+ * @return Estado tras el avance (RUNNING si la MT sigue en marcha).
+ */
+RunStatus Execution::step(long long quantum) {
+  if (status_ != RunStatus::RUNNING) return status_;
+  if (stream_) status_ = simulator_->runOnStream(configuration_, *stream_, quantum, false);
+  else status_ = simulator_->step(configuration_, quantum);
+  return status_;
+}
@@ -0,0 +1,48 @@
+#ifndef EXECUTION_H
+#define EXECUTION_H
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "configuration.h"
+#include "stream_tape.h"
+#include "string.h"
+#include "turing_machine_simulator.h"
+
+/**
+ * @brief Ejecución reanudable de una cadena sobre una MT.
+ *
+ * Envuelve la Configuration de TuringMachineSimulator para poder avanzarla a
+ * trozos: se crea (start), se avanza con step(n) tantas veces como haga falta
+ * y, cuando getStatus() deja de ser RUNNING, la configuración final es el
+ * resultado. El simulador no se copia y debe vivir más que la ejecución.
+ * Con una StreamTape la cinta 0 llega poco a poco (--stream-tape) y step()
+ * nunca espera: si falta entrada, devuelve RUNNING sin avanzar y cede el turno.
+ */
+class Execution {
+ public:
+  typedef std::chrono::steady_clock Clock;
+  Execution(const TuringMachineSimulator& simulator, uint64_t index, const std::string& input, const String& string);
+  Execution(const TuringMachineSimulator& simulator, uint64_t index, const std::string& input,
+            std::unique_ptr<StreamTape> stream);
+  RunStatus step(long long quantum);
+  RunStatus getStatus() const { return status_; }
+  bool isFinished() const { return status_ != RunStatus::RUNNING; }
+  long long getSteps() const { return configuration_.getSteps(); }
+  uint64_t getIndex() const { return index_; }
+  const std::string& getInput() const { return input_; }
+  const Configuration& getResult() const { return configuration_; }
+  const StreamTape* getStream() const { return stream_.get(); }
+  Clock::time_point getStarted() const { return started_; }
+ private:
+  const TuringMachineSimulator* simulator_;
+  uint64_t index_;
+  std::string input_;
+  Configuration configuration_;
+  std::unique_ptr<StreamTape> stream_;
+  RunStatus status_;
+  Clock::time_point started_;
+};
+
+#endif
@@ -1,4 +1,6 @@
 #include "file_parser.h"
+#include <cctype>
+#include <memory>
 #include <stdexcept>
 
 /**
@@ -19,10 +21,12 @@ FileParser::~FileParser() {}
  */
 std::vector<std::string> FileParser::parseTokens(const std::string& line) {
 	std::vector<std::string> tokens;
-	std::stringstream stream(line);
-	std::string token;
-	while (stream >> token) {
-		tokens.push_back(token);
+	size_t pos = 0;
+	while (pos < line.size()) {
+		while (pos < line.size() && std::isspace(static_cast<unsigned char>(line[pos]))) pos++;
+		size_t start = pos;
+		while (pos < line.size() && !std::isspace(static_cast<unsigned char>(line[pos]))) pos++;
+		if (pos > start) tokens.push_back(line.substr(start, pos - start));
 	}
 	return tokens;
 }
@@ -41,12 +45,12 @@ std::string FileParser::trim(const std::string& line) {
 }
 
 /**
- * @brief Lee el archivo de la MT y divide su contenido en secciones.
+ * @brief Lee las 6 secciones de cabecera del archivo de la MT.
  * 
  * Parsea el fichero línea por línea, ignorando comentarios (líneas con #)
- * y líneas vacías. Divide el contenido en las secciones correspondientes:
- * estados, alfabetos, estado inicial, símbolo blanco, estados de aceptación
- * y transiciones.
+ * y líneas vacías, hasta completar estados, alfabetos, estado inicial,
+ * símbolo blanco y estados de aceptación. El stream queda posicionado en
+ * la primera línea de transiciones.
  * 
  * @param infile Stream de entrada del fichero ya abierto.
  * @param states Vector donde se guardarán los nombres de los estados.
@@ -55,24 +59,20 @@ std::string FileParser::trim(const std::string& line) {
  * @param initialState String donde se guardará el estado inicial.
  * @param initialStackSymbol String donde se guardará el símbolo blanco.
  * @param acceptStates Vector donde se guardarán los estados de aceptación.
- * @param transitions Vector donde se guardarán las líneas de transiciones.
- * @return true si se leyó correctamente, false en caso contrario.
+ * @return true si se leyeron las 6 secciones, false si el fichero terminó antes.
  */
-bool FileParser::readAndSplitSections(std::ifstream& infile,
+bool FileParser::readHeaderSections(std::istream& infile,
 	std::vector<std::string>& states,
 	std::vector<std::string>& inputAlphabet,
 	std::vector<std::string>& tapeAlphabet,
 	std::string& initialState,
 	std::string& initialStackSymbol,
-	std::vector<std::string>& acceptStates,
-	std::vector<std::string>& transitions)
+	std::vector<std::string>& acceptStates)
 {
 	std::string line;
 	int section = 0;
-	while (std::getline(infile, line)) {
-		size_t comment = line.find('#');
-		if (comment != std::string::npos) line = line.substr(0, comment);
-		line = trim(line);
+	while (section < 6 && std::getline(infile, line)) {
+		line = cleanLine(line);
 		if (line.empty()) continue;
 		switch (section) {
 			case 0: states = parseTokens(line); break;
@@ -81,10 +81,55 @@ bool FileParser::readAndSplitSections(std::ifstream& infile,
 			case 3: initialState = line; break;
 			case 4: initialStackSymbol = line; break;
 			case 5: acceptStates = parseTokens(line); break;
-			default: transitions.push_back(line); break;
 		}
 		section++;
 	}
+	return section == 6;
+}
+
+/**
+ * @brief Quita el comentario (desde #) y los espacios de los extremos de una línea.
+ * 
+ * @param line Línea original.
+ * @return Línea limpia (vacía si solo era comentario o espacios).
+ */
+std::string FileParser::cleanLine(const std::string& line) {
+	size_t comment = line.find('#');
+	if (comment != std::string::npos) return trim(line.substr(0, comment));
+	return trim(line);
+}
+
+/**
+ * @brief Lee el archivo de la MT y divide su contenido en secciones.
+ * 
+ * Lee la cabecera con readHeaderSections() y guarda el resto de líneas no
+ * vacías (sin comentarios) como líneas de transiciones.
+ * 
+ * @param infile Stream de entrada del fichero ya abierto.
+ * @param states Vector donde se guardarán los nombres de los estados.
+ * @param inputAlphabet Vector donde se guardará el alfabeto de entrada.
+ * @param tapeAlphabet Vector donde se guardará el alfabeto de cinta.
+ * @param initialState String donde se guardará el estado inicial.
+ * @param initialStackSymbol String donde se guardará el símbolo blanco.
+ * @param acceptStates Vector donde se guardarán los estados de aceptación.
+ * @param transitions Vector donde se guardarán las líneas de transiciones.
+ * @return true si se leyó correctamente, false en caso contrario.
+ */
+bool FileParser::readAndSplitSections(std::istream& infile,
+	std::vector<std::string>& states,
+	std::vector<std::string>& inputAlphabet,
+	std::vector<std::string>& tapeAlphabet,
+	std::string& initialState,
+	std::string& initialStackSymbol,
+	std::vector<std::string>& acceptStates,
+	std::vector<std::string>& transitions)
+{
+	readHeaderSections(infile, states, inputAlphabet, tapeAlphabet, initialState, initialStackSymbol, acceptStates);
+	std::string line;
+	while (std::getline(infile, line)) {
+		line = cleanLine(line);
+		if (!line.empty()) transitions.push_back(line);
+	}
 	return true;
 }
 
@@ -139,8 +184,15 @@ std::vector<State> FileParser::buildStates(const std::vector<std::string>& state
  * 3. Lee estado destino
  * 4. Lee tripletas intercaladas: escritura0, mov0, lectura1, escritura1, mov1, lectura2, ...
  * 
+ * El comodín '*' (Symbol::WILDCARD) se admite como símbolo de lectura (coincide
+ * con cualquier símbolo) y como símbolo de escritura (mantiene el de la celda).
+ * Una línea "<estado_origen> @<nombre> <argumentos>" es la operación nativa
+ * (Builtin) del estado.
+ * 
  * @param transitions Vector de strings con las líneas de transiciones.
  * @return Vector de objetos Transition construidos.
+ * @throws std::runtime_error si una operación nativa no existe o tiene argumentos inválidos.
+ * @throws std::range_error si un movimiento no es válido (ver parseMove()).
  */
 std::vector<Transition> FileParser::parseTransitionLines(const std::vector<std::string>& transitions) {
 	std::vector<Transition> transitionObjects;
@@ -148,6 +200,10 @@ std::vector<Transition> FileParser::parseTransitionLines(const std::vector<std::
 		std::stringstream stream(transLine);
 		std::string fromState, readSym0Str, toState;
 		stream >> fromState >> readSym0Str >> toState;
+		if (Builtin::isInvocation(readSym0Str)) {
+			transitionObjects.push_back(Transition(State(fromState), Builtin::parse(parseTokens(transLine))));
+			continue;
+		}
 		State from(fromState);
 		State to(toState);
 		std::vector<Symbol> readSymbols;
@@ -157,16 +213,7 @@ std::vector<Transition> FileParser::parseTransitionLines(const std::vector<std::
 		int tapeIndex = 0;
 		if (stream >> writeSymStr >> moveStr) {
 			Symbol writeSymbol = (!writeSymStr.empty()) ? Symbol(writeSymStr[0]) : Symbol('.');
-			Moves move = Moves::STAY;
-			if (!moveStr.empty()) {
-				char m = moveStr[0];
-				if (m == 'L') move = Moves::LEFT;
-				else if (m == 'R') move = Moves::RIGHT;
-				else if (m == 'S') move = Moves::STAY;
-				else { 
-					throw std::range_error("Error: Movimiento inválido '" + moveStr + "' en la transición desde '" + fromState + "' a '" + toState + "'");
-				}
-			}
+			Moves move = parseMove(moveStr, fromState, toState);
 			tapeActions.insert(std::make_pair(tapeIndex, std::make_pair(writeSymbol, move)));
 			tapeIndex++;
 		}
@@ -174,17 +221,7 @@ std::vector<Transition> FileParser::parseTransitionLines(const std::vector<std::
 			Symbol readSym = (!readSymStr.empty()) ? Symbol(readSymStr[0]) : Symbol('.');
 			readSymbols.push_back(readSym);
 			Symbol writeSymbol = (!writeSymStr.empty()) ? Symbol(writeSymStr[0]) : Symbol('.');
-			Moves move = Moves::STAY;
-			if (!moveStr.empty()) {
-				char m = moveStr[0];
-				if (m == 'L') move = Moves::LEFT;
-				else if (m == 'R') move = Moves::RIGHT;
-				else if (m == 'S') move = Moves::STAY;
-				else { 
-					throw std::range_error("Error: Movimiento inválido '" + moveStr + "' en la transición desde '" + fromState + "' a '" + toState + "'");
-				}
-			
-			}
+			Moves move = parseMove(moveStr, fromState, toState);
 			tapeActions.insert(std::make_pair(tapeIndex, std::make_pair(writeSymbol, move)));
 			tapeIndex++;
 		}
@@ -197,34 +234,188 @@ std::vector<Transition> FileParser::parseTransitionLines(const std::vector<std::
 /**
  * @brief Parsea un fichero de definición de máquina de Turing y construye el objeto TuringMachineModel.
  * 
- * Lee el fichero línea por línea, separa las secciones (estados, alfabetos,
- * estado inicial, símbolo blanco, estados de aceptación y transiciones),
- * construye los objetos necesarios (estados, alfabetos, transiciones) y
- * finalmente crea y retorna el objeto TuringMachineModel.
- * 
  * @param filename Ruta al fichero de definición de la MT.
  * @return Objeto TuringMachineModel construido a partir del fichero.
+ * @throws std::runtime_error si no se puede abrir el fichero o la definición no es válida.
  */
 TuringMachineModel FileParser::parseFile(const std::string& filename) {
 	std::ifstream infile(filename);
 	if (!infile.is_open()) {
 		throw std::runtime_error("No se pudo abrir el archivo: " + filename);
 	}
+	return parseStream(infile);
+}
+
+/**
+ * @brief Parsea una definición de MT que ya está en memoria (mismo formato que el fichero).
+ * 
+ * @param text Contenido completo de la definición.
+ * @return Objeto TuringMachineModel construido a partir del texto.
+ */
+TuringMachineModel FileParser::parseBuffer(const std::string& text) {
+	std::istringstream infile(text);
+	return parseStream(infile);
+}
+
+/**
+ * @brief Parsea una definición de MT desde un stream y construye el objeto TuringMachineModel.
+ * 
+ * Lee el stream línea por línea, separa las secciones (estados, alfabetos,
+ * estado inicial, símbolo blanco, estados de aceptación y transiciones),
+ * construye los objetos necesarios (estados, alfabetos, transiciones) y
+ * finalmente crea y retorna el objeto TuringMachineModel.
+ * 
+ * @param infile Stream con la definición de la MT.
+ * @return Objeto TuringMachineModel construido a partir del stream.
+ */
+TuringMachineModel FileParser::parseStream(std::istream& infile) {
 	std::vector<std::string> states, inputAlphabet, tapeAlphabet, transitions, acceptStates;
 	std::string initialState, initialStackSymbol;
 	readAndSplitSections(infile, states, inputAlphabet, tapeAlphabet, initialState, initialStackSymbol, acceptStates, transitions);
-	infile.close();
 	Alphabet inputAlpha = buildAlphabet(inputAlphabet);
-	if(inputAlpha.contains(Symbol('.'))) {
-		throw std::runtime_error("Error: El alfabeto de entrada contiene blanco.");
-	}
 	Alphabet tapeAlpha = buildAlphabet(tapeAlphabet);
-	if(!tapeAlpha.contains(Symbol('.'))) {
-		throw std::runtime_error("Error: El alfabeto de cinta no contiene blanco.");
-	}
+	validateAlphabets(inputAlpha, tapeAlpha);
 	std::vector<State> stateObjects = buildStates(states, acceptStates);
 	State initialStateObj(initialState);
 	std::vector<Transition> transitionObjects = parseTransitionLines(transitions);
 	TuringMachineModel model(stateObjects, transitionObjects, inputAlpha, tapeAlpha, initialState);
 	return model;
 }
+
+/**
+ * @brief Parsea un fichero de MT directamente al formato compacto (CompactModel).
+ * 
+ * Pensado para máquinas con millones de transiciones: las líneas de transición
+ * se leen una a una y se convierten en registros de tamaño fijo sin crear
+ * objetos State ni Transition ni guardar las líneas en memoria. El número de
+ * cintas lo fija la primera transición y todas deben tener el mismo.
+ * 
+ * @param filename Ruta al fichero de definición de la MT.
+ * @return Modelo compacto construido a partir del fichero.
+ */
+CompactModel FileParser::parseCompactFile(const std::string& filename) {
+	std::ifstream infile(filename);
+	if (!infile.is_open()) {
+		throw std::runtime_error("No se pudo abrir el archivo: " + filename);
+	}
+	std::vector<std::string> states, inputAlphabet, tapeAlphabet, acceptStates;
+	std::string initialState, initialStackSymbol;
+	readHeaderSections(infile, states, inputAlphabet, tapeAlphabet, initialState, initialStackSymbol, acceptStates);
+	validateAlphabets(buildAlphabet(inputAlphabet), buildAlphabet(tapeAlphabet));
+	std::unique_ptr<CompactModelBuilder> builder;
+	std::vector<char> read, write;
+	std::vector<Moves> moves;
+	std::vector<std::string> tokens;
+	std::string line;
+	while (std::getline(infile, line)) {
+		line = cleanLine(line);
+		if (line.empty()) continue;
+		tokens = parseTokens(line);
+		if (tokens.size() >= 2 && Builtin::isInvocation(tokens[1])) {
+			throw std::runtime_error("Error: El formato compacto no admite operaciones nativas: '" + line + "'");
+		}
+		if (tokens.size() < 5 || (tokens.size() - 5) % 3 != 0) {
+			throw std::runtime_error("Error: Transición mal formada: '" + line + "'");
+		}
+		int tapeCount = 1 + (tokens.size() - 5) / 3;
+		if (!builder) {
+			builder.reset(new CompactModelBuilder(states, tapeCount));
+			for (const auto& accept : acceptStates) {
+				if (builder->hasState(accept)) builder->setAccept(builder->stateIndex(accept));
+			}
+		}
+		read.clear();
+		write.clear();
+		moves.clear();
+		for (int t = 0; t < tapeCount; ++t) {
+			size_t base = (t == 0) ? 0 : 2 + 3 * t;
+			const std::string& readStr = (t == 0) ? tokens[1] : tokens[base];
+			const std::string& writeStr = (t == 0) ? tokens[3] : tokens[base + 1];
+			const std::string& moveStr = (t == 0) ? tokens[4] : tokens[base + 2];
+			read.push_back(readStr[0]);
+			write.push_back(writeStr[0]);
+			moves.push_back(parseMove(moveStr, tokens[0], tokens[2]));
+		}
+		builder->addTransition(builder->stateIndex(tokens[0]), builder->stateIndex(tokens[2]), read, write, moves);
+	}
+	if (!builder) {
+		builder.reset(new CompactModelBuilder(states, 1));
+		for (const auto& accept : acceptStates) {
+			if (builder->hasState(accept)) builder->setAccept(builder->stateIndex(accept));
+		}
+	}
+	builder->setInitial(builder->stateIndex(initialState));
+	return builder->build();
+}
+
+/**
+ * @brief Parsea solo la cabecera de un fichero de MT e indexa sus transiciones para cargarlas bajo demanda.
+ * 
+ * Pensado para máquinas generadas con cientos de miles de estados de las que
+ * cada entrada usa unos pocos: no se crea ningún objeto State ni Transition,
+ * solo un LazyTransitionIndex con la posición de cada línea de transición
+ * agrupada por estado origen. El modelo resultante parsea las transiciones de
+ * un estado la primera vez que la simulación entra en él (--lazy-load).
+ * 
+ * @param filename Ruta al fichero de definición de la MT.
+ * @return Modelo en modo de carga perezosa.
+ * @throws std::runtime_error si no se puede abrir el fichero o la definición no es válida.
+ */
+TuringMachineModel FileParser::parseLazyFile(const std::string& filename) {
+	std::ifstream infile(filename);
+	if (!infile.is_open()) {
+		throw std::runtime_error("No se pudo abrir el archivo: " + filename);
+	}
+	std::vector<std::string> states, inputAlphabet, tapeAlphabet, acceptStates;
+	std::string initialState, initialStackSymbol;
+	readHeaderSections(infile, states, inputAlphabet, tapeAlphabet, initialState, initialStackSymbol, acceptStates);
+	Alphabet inputAlpha = buildAlphabet(inputAlphabet);
+	Alphabet tapeAlpha = buildAlphabet(tapeAlphabet);
+	validateAlphabets(inputAlpha, tapeAlpha);
+	std::streamoff transitionsStart = infile.good() ? static_cast<std::streamoff>(infile.tellg()) : -1;
+	if (transitionsStart < 0) {
+		infile.clear();
+		infile.seekg(0, std::ios::end);
+		transitionsStart = infile.tellg();
+	}
+	std::shared_ptr<const LazyTransitionIndex> index =
+		std::make_shared<const LazyTransitionIndex>(filename, transitionsStart, states, acceptStates);
+	return TuringMachineModel(index, inputAlpha, tapeAlpha, initialState);
+}
+
+/**
+ * @brief Convierte el token de movimiento (L, R o S) en un valor de Moves.
+ * 
+ * @param moveStr Token de movimiento.
+ * @param fromState Estado origen (para el mensaje de error).
+ * @param toState Estado destino (para el mensaje de error).
+ * @return Movimiento correspondiente.
+ * @throws std::range_error si el movimiento no es válido.
+ */
+Moves FileParser::parseMove(const std::string& moveStr, const std::string& fromState, const std::string& toState) {
+	if (moveStr.empty()) return Moves::STAY;
+	char m = moveStr[0];
+	if (m == 'L') return Moves::LEFT;
+	if (m == 'R') return Moves::RIGHT;
+	if (m == 'S') return Moves::STAY;
+	throw std::range_error("Error: Movimiento inválido '" + moveStr + "' en la transición desde '" + fromState + "' a '" + toState + "'");
+}
+
+/**
+ * @brief Comprueba las restricciones de los alfabetos sobre el símbolo blanco y el comodín.
+ * 
+ * @param inputAlpha Alfabeto de entrada.
+ * @param tapeAlpha Alfabeto de cinta.
+ * @throws std::runtime_error si algún alfabeto no es válido.
+ */
+void FileParser::validateAlphabets(const Alphabet& inputAlpha, const Alphabet& tapeAlpha) {
+	if(inputAlpha.contains(Symbol('.'))) {
+		throw std::runtime_error("Error: El alfabeto de entrada contiene blanco.");
+	}
+	if(!tapeAlpha.contains(Symbol('.'))) {
+		throw std::runtime_error("Error: El alfabeto de cinta no contiene blanco.");
+	}
+	if(tapeAlpha.contains(Symbol(Symbol::WILDCARD))) {
+		throw std::runtime_error("Error: El alfabeto de cinta contiene el comodín '*'.");
+	}
+}
\ No newline at end of file
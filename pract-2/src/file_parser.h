@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include "alphabet.h"
+#include "compact_model.h"
 #include "state.h"
 #include "string.h"
 #include "symbol.h"
@@ -21,7 +22,15 @@ public:
 	~FileParser();
 	std::vector<std::string> parseTokens(const std::string& line);
 	std::string trim(const std::string& s);
-	bool readAndSplitSections(std::ifstream& infile,
+	bool readHeaderSections(std::istream& infile,
+		std::vector<std::string>& states,
+		std::vector<std::string>& inputAlphabet,
+		std::vector<std::string>& tapeAlphabet,
+		std::string& initialState,
+		std::string& initialStackSymbol,
+		std::vector<std::string>& acceptStates);
+	std::string cleanLine(const std::string& line);
+	bool readAndSplitSections(std::istream& infile,
 		std::vector<std::string>& states,
 		std::vector<std::string>& inputAlphabet,
 		std::vector<std::string>& tapeAlphabet,
@@ -33,6 +42,12 @@ public:
 	std::vector<State> buildStates(const std::vector<std::string>& stateNames, const std::vector<std::string>& acceptStates);
 	std::vector<Transition> parseTransitionLines(const std::vector<std::string>& transitions);
 	TuringMachineModel parseFile(const std::string& filename);
+	TuringMachineModel parseStream(std::istream& infile);
+	TuringMachineModel parseBuffer(const std::string& text);
+	CompactModel parseCompactFile(const std::string& filename);
+	TuringMachineModel parseLazyFile(const std::string& filename);
+	Moves parseMove(const std::string& moveStr, const std::string& fromState, const std::string& toState);
+	void validateAlphabets(const Alphabet& inputAlpha, const Alphabet& tapeAlpha);
 
 };
 
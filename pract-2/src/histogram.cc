@@ -0,0 +1,69 @@
+#include "histogram.h"
+#include <algorithm>
+
+/**
+ * @brief Constructor: reserva todas las cubetas de una vez.
+ */
+Histogram::Histogram()
+  : counts_((64 - kSubBits + 2) * kHalf, 0), count_(0), sum_(0), min_(UINT64_MAX), max_(0) {
+}
+
+/**
+ * @brief Calcula la cubeta de un valor.
+ *
+ * Los valores menores que 2^kSubBits tienen cubeta propia; para el resto se
+ * conservan los kSubBits bits más significativos.
+ *
+ * @param value Valor a registrar.
+ * @return Índice de la cubeta.
+ */
+int Histogram::bucketIndex(uint64_t value) {
+  if (value < (uint64_t(1) << kSubBits)) return static_cast<int>(value);
+  int msb = 63 - __builtin_clzll(value);
+  int shift = msb - (kSubBits - 1);
+  return shift * kHalf + static_cast<int>(value >> shift);
+}
+
+/**
+ * @brief Mayor valor que cae en una cubeta.
+ *
+ * @param index Índice de la cubeta.
+ * @return Límite superior (inclusivo) de la cubeta.
+ */
+uint64_t Histogram::bucketUpperBound(int index) {
+  if (index < (1 << kSubBits)) return index;
+  int shift = index / kHalf - 1;
+  uint64_t top = index % kHalf + kHalf;
+  return ((top + 1) << shift) - 1;
+}
+
+/**
+ * @brief Registra un valor.
+ *
+ * @param value Valor a registrar.
+ */
+void Histogram::record(uint64_t value) {
+  counts_[bucketIndex(value)]++;
+  count_++;
+  sum_ += value;
+  min_ = std::min(min_, value);
+  max_ = std::max(max_, value);
+}
+
+/**
+ * @brief Devuelve el cuantil q (entre 0 y 1) de los valores registrados.
+ *
+ * @param q Cuantil pedido.
+ * @return Límite superior de la cubeta que contiene el cuantil (acotado por el máximo real).
+ */
+uint64_t Histogram::quantile(double q) const {
+  if (count_ == 0) return 0;
+  uint64_t rank = static_cast<uint64_t>(q * count_);
+  if (rank >= count_) rank = count_ - 1;
+  uint64_t seen = 0;
+  for (size_t i = 0; i < counts_.size(); ++i) {
+    seen += counts_[i];
+    if (seen > rank) return std::min(bucketUpperBound(i), max_);
+  }
+  return max_;
+}
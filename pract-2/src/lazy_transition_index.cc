@@ -0,0 +1,139 @@
+#include "lazy_transition_index.h"
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+#include "file_parser.h"
+
+/**
+ * @brief Construye el índice recorriendo la sección de transiciones del fichero.
+ *
+ * @param filename Ruta al fichero de definición de la MT.
+ * @param transitionsStart Posición del fichero donde empieza la sección de transiciones.
+ * @param states Estados declarados en la cabecera.
+ * @param acceptStates Estados de aceptación declarados en la cabecera.
+ * @throws std::runtime_error si no se puede abrir el fichero.
+ */
+LazyTransitionIndex::LazyTransitionIndex(const std::string& filename, std::streamoff transitionsStart,
+                                         const std::vector<std::string>& states,
+                                         const std::vector<std::string>& acceptStates)
+  : filename_(filename), declared_(0), tapeCount_(1), file_(filename), loadedStates_(0), loadedLines_(0) {
+  if (!file_.is_open()) {
+    throw std::runtime_error("No se pudo abrir el archivo: " + filename);
+  }
+  for (const auto& state : states) intern(state);
+  declared_ = static_cast<int>(names_.size());
+  for (const auto& accept : acceptStates) {
+    int state = find(accept);
+    if (state >= 0) accept_[state] = true;
+  }
+  FileParser parser;
+  std::vector<uint32_t> lineStates;
+  std::vector<uint64_t> lineOffsets;
+  std::string line;
+  uint64_t offset = static_cast<uint64_t>(transitionsStart);
+  file_.seekg(transitionsStart);
+  while (std::getline(file_, line)) {
+    uint64_t lineOffset = offset;
+    offset += line.size() + 1;
+    line = parser.cleanLine(line);
+    if (line.empty()) continue;
+    size_t end = 0;
+    while (end < line.size() && !std::isspace(static_cast<unsigned char>(line[end]))) end++;
+    int tokens = 0;
+    for (size_t pos = 0; pos < line.size(); ++pos) {
+      bool space = std::isspace(static_cast<unsigned char>(line[pos]));
+      if (!space && (pos == 0 || std::isspace(static_cast<unsigned char>(line[pos - 1])))) tokens++;
+    }
+    size_t second = line.find_first_not_of(" \t", end);
+    if (second != std::string::npos && line[second] == '@') {
+      std::vector<std::string> words = parser.parseTokens(line);
+      if (Builtin::isInvocation(words[1])) tapeCount_ = std::max(tapeCount_, Builtin::parse(words).getMaxTape() + 1);
+    } else if (tokens >= 5) {
+      tapeCount_ = std::max(tapeCount_, 1 + (tokens - 5) / 3);
+    }
+    lineStates.push_back(static_cast<uint32_t>(intern(line.substr(0, end))));
+    lineOffsets.push_back(lineOffset);
+  }
+  first_.assign(names_.size() + 1, 0);
+  for (uint32_t state : lineStates) first_[state + 1]++;
+  for (size_t state = 0; state < names_.size(); ++state) first_[state + 1] += first_[state];
+  std::vector<uint32_t> cursor(first_.begin(), first_.end() - 1);
+  offsets_.resize(lineOffsets.size());
+  for (size_t i = 0; i < lineOffsets.size(); ++i) offsets_[cursor[lineStates[i]]++] = lineOffsets[i];
+  file_.clear();
+}
+
+/**
+ * @brief Devuelve el número de un estado, dándolo de alta si es nuevo.
+ *
+ * @param stateId Identificador del estado.
+ * @return Número del estado.
+ */
+int LazyTransitionIndex::intern(const std::string& stateId) {
+  auto inserted = ids_.insert(std::make_pair(stateId, static_cast<int>(names_.size())));
+  if (inserted.second) {
+    names_.push_back(stateId);
+    accept_.push_back(false);
+  }
+  return inserted.first->second;
+}
+
+/**
+ * @brief Busca el número de un estado.
+ *
+ * @param stateId Identificador del estado.
+ * @return Número del estado, o -1 si no aparece en el fichero.
+ */
+int LazyTransitionIndex::find(const std::string& stateId) const {
+  auto it = ids_.find(stateId);
+  return it != ids_.end() ? it->second : -1;
+}
+
+/**
+ * @brief Relee del fichero y parsea las transiciones que salen de un estado.
+ *
+ * @param state Número del estado origen.
+ * @return Transiciones del estado, en el orden del fichero.
+ * @throws std::runtime_error si el fichero ha cambiado desde que se construyó el índice.
+ * @throws std::range_error si alguna transición tiene un movimiento inválido.
+ */
+std::vector<Transition> LazyTransitionIndex::load(int state) const {
+  FileParser parser;
+  std::vector<std::string> lines;
+  std::string line;
+  for (uint32_t i = first_[state]; i < first_[state + 1]; ++i) {
+    file_.clear();
+    file_.seekg(static_cast<std::streamoff>(offsets_[i]));
+    if (!std::getline(file_, line)) {
+      throw std::runtime_error("No se pudo releer la transición del estado " + names_[state] + " en " + filename_);
+    }
+    line = parser.cleanLine(line);
+    size_t length = names_[state].size();
+    if (line.compare(0, length, names_[state]) != 0 ||
+        (line.size() > length && !std::isspace(static_cast<unsigned char>(line[length])))) {
+      throw std::runtime_error("El fichero " + filename_ + " ha cambiado desde que se indexó (--lazy-load)");
+    }
+    lines.push_back(line);
+  }
+  if (!lines.empty()) ++loadedStates_;
+  loadedLines_ += lines.size();
+  return parser.parseTransitionLines(lines);
+}
+
+/**
+ * @brief Muestra cuántos estados y líneas de transición se han llegado a cargar.
+ *
+ * @param os Stream de salida.
+ * @param index Índice a mostrar.
+ * @return Referencia al stream de salida.
+ */
+std::ostream& operator<<(std::ostream& os, const LazyTransitionIndex& index) {
+  int withTransitions = 0;
+  for (size_t state = 0; state + 1 < index.first_.size(); ++state) {
+    if (index.first_[state + 1] > index.first_[state]) withTransitions++;
+  }
+  os << "Carga perezosa: " << index.loadedStates_ << " de " << withTransitions
+     << " estados con transiciones cargados (" << index.loadedLines_ << " de " << index.offsets_.size()
+     << " líneas de transición parseadas, " << index.declared_ << " estados declarados)";
+  return os;
+}
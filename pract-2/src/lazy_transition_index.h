@@ -0,0 +1,57 @@
+#ifndef LAZY_TRANSITION_INDEX_H
+#define LAZY_TRANSITION_INDEX_H
+
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "transition.h"
+
+/**
+ * @brief Índice de las líneas de transición de un fichero de MT agrupadas por estado origen (--lazy-load).
+ *
+ * Recorre una sola vez la sección de transiciones sin construir objetos
+ * Transition: de cada línea solo mira el primer token (el estado origen) y
+ * cuántos tokens tiene (para el número de cintas; en las operaciones nativas,
+ * las cintas que usan), y guarda su posición en el fichero. Las posiciones se
+ * ordenan por estado de forma estable, así que las de un estado quedan
+ * contiguas y en el orden del fichero. load() relee y parsea con FileParser
+ * solo las líneas de un estado cuando hace falta.
+ *
+ * Los estados se numeran por orden de aparición: primero los declarados en la
+ * cabecera y después los que solo aparecen como origen de alguna transición
+ * (que el modelo no admite como estados, igual que sin --lazy-load).
+ * load() no es seguro entre hilos: comparte el stream del fichero.
+ */
+class LazyTransitionIndex {
+ public:
+  LazyTransitionIndex(const std::string& filename, std::streamoff transitionsStart,
+                      const std::vector<std::string>& states, const std::vector<std::string>& acceptStates);
+  int find(const std::string& stateId) const;
+  const std::string& getName(int state) const { return names_[state]; }
+  bool isDeclared(int state) const { return state < declared_; }
+  bool isAccept(int state) const { return accept_[state]; }
+  int getStateCount() const { return static_cast<int>(names_.size()); }
+  int getDeclaredCount() const { return declared_; }
+  uint64_t getLineCount() const { return offsets_.size(); }
+  int getTapeCount() const { return tapeCount_; }
+  std::vector<Transition> load(int state) const;
+  friend std::ostream& operator<<(std::ostream& os, const LazyTransitionIndex& index);
+ private:
+  int intern(const std::string& stateId);
+  std::string filename_;
+  std::unordered_map<std::string, int> ids_;
+  std::vector<std::string> names_;
+  std::vector<bool> accept_;
+  int declared_;
+  std::vector<uint32_t> first_;
+  std::vector<uint64_t> offsets_;
+  int tapeCount_;
+  mutable std::ifstream file_;
+  mutable uint64_t loadedStates_;
+  mutable uint64_t loadedLines_;
+};
+
+#endif
@@ -0,0 +1,223 @@
+#include "machine_optimizer.h"
+#include <algorithm>
+#include <deque>
+#include <sstream>
+
+namespace {
+
+/**
+ * @brief Clave con los símbolos de lectura de una transición.
+ */
+std::string readKey(const Transition& transition) {
+  std::string key;
+  for (const auto& symbol : transition.getReadSymbols()) key.push_back(symbol.getValue());
+  return key;
+}
+
+/**
+ * @brief Clave con las acciones (escritura y movimiento por cinta) de una transición.
+ */
+std::string actionKey(const Transition& transition) {
+  std::ostringstream key;
+  for (const auto& action : transition.getTapeActions()) {
+    key << action.first << action.second.first << action.second.second << ';';
+  }
+  return key.str();
+}
+
+}  // namespace
+
+/**
+ * @brief Imprime el resumen antes/después de la optimización.
+ *
+ * @param os Stream de salida.
+ * @param summary Resumen a imprimir.
+ * @return Referencia al stream de salida para permitir encadenamiento.
+ */
+std::ostream& operator<<(std::ostream& os, const OptimizationSummary& summary) {
+  os << "Optimización:\n";
+  os << "  Estados:      " << summary.statesBefore << " -> " << summary.statesAfter
+     << " (inalcanzables: " << summary.unreachableStates
+     << ", fusionados: " << summary.mergedStates << ")\n";
+  os << "  Transiciones: " << summary.transitionsBefore << " -> " << summary.transitionsAfter << "\n";
+  os << "  Estados muertos (rechazo anticipado): " << summary.deadStates << "\n";
+  return os;
+}
+
+/**
+ * @brief Aplica las tres pasadas de optimización y devuelve el modelo resultante.
+ *
+ * Las transiciones que salen de estados de aceptación o de estados muertos se
+ * eliminan también, ya que el simulador nunca llega a consultarlas. Se conserva
+ * el orden original de las transiciones de cada estado, de modo que la primera
+ * transición aplicable sigue siendo la misma.
+ *
+ * @param model Modelo original.
+ * @return Modelo optimizado.
+ */
+TuringMachineModel MachineOptimizer::optimize(const TuringMachineModel& model) {
+  summary_ = OptimizationSummary();
+  summary_.statesBefore = model.getStates().size();
+  for (const auto& transPair : model.getTransitions()) summary_.transitionsBefore += transPair.second.size();
+
+  std::set<std::string> reachable = findReachable(model);
+  summary_.unreachableStates = summary_.statesBefore - reachable.size();
+
+  std::map<std::string, std::string> representative = mergeEquivalent(model, reachable);
+  std::set<std::string> kept;
+  std::set<std::string> acceptStates;
+  for (const auto& id : reachable) {
+    if (representative[id] != id) continue;
+    kept.insert(id);
+    if (model.getStateById(id).isAccept()) acceptStates.insert(id);
+  }
+  summary_.mergedStates = reachable.size() - kept.size();
+
+  std::vector<Transition> transitions;
+  for (const auto& id : kept) {
+    if (acceptStates.count(id)) continue;
+    const Transition* builtin = model.getBuiltinFrom(id);
+    if (builtin != nullptr) transitions.push_back(Transition(State(id), builtin->getBuiltin()));
+    for (const auto& transition : model.getTransitionsFrom(id)) {
+      auto it = representative.find(transition.getTo().getId());
+      State to(it != representative.end() ? it->second : transition.getTo().getId());
+      transitions.push_back(Transition(State(id), to, transition.getReadSymbols(), transition.getTapeActions()));
+    }
+  }
+
+  std::set<std::string> dead = findDead(kept, transitions, acceptStates);
+  summary_.deadStates = dead.size();
+  std::vector<Transition> liveTransitions;
+  for (const auto& transition : transitions) {
+    if (!dead.count(transition.getFrom().getId())) liveTransitions.push_back(transition);
+  }
+
+  std::vector<State> states;
+  for (const auto& id : kept) {
+    State state(id);
+    state.setAccept(acceptStates.count(id) > 0);
+    state.setDead(dead.count(id) > 0);
+    states.push_back(state);
+  }
+  summary_.statesAfter = states.size();
+  summary_.transitionsAfter = std::count_if(liveTransitions.begin(), liveTransitions.end(),
+                                            [](const Transition& transition) { return !transition.isBuiltin(); });
+  return TuringMachineModel(states, liveTransitions, model.getStringAlphabet(), model.getTapeAlphabet(),
+                            model.getInitialStateId());
+}
+
+/**
+ * @brief Calcula los estados alcanzables desde el estado inicial (BFS).
+ *
+ * @param model Modelo original.
+ * @return Conjunto de ids de estados alcanzables que existen en el modelo.
+ */
+std::set<std::string> MachineOptimizer::findReachable(const TuringMachineModel& model) const {
+  std::set<std::string> reachable;
+  std::deque<std::string> pending;
+  const std::string& initial = model.getInitialStateId();
+  if (model.getStates().count(initial)) {
+    reachable.insert(initial);
+    pending.push_back(initial);
+  }
+  while (!pending.empty()) {
+    std::string id = pending.front();
+    pending.pop_front();
+    if (model.getStateById(id).isAccept()) continue;
+    for (const auto& transition : model.getTransitionsFrom(id)) {
+      const std::string& to = transition.getTo().getId();
+      if (model.getStates().count(to) && reachable.insert(to).second) pending.push_back(to);
+    }
+  }
+  return reachable;
+}
+
+/**
+ * @brief Agrupa los estados con comportamiento idéntico y elige un representante por grupo.
+ *
+ * Parte de la partición {aceptación, no aceptación} y la refina hasta que es
+ * estable: dos estados siguen juntos si, para cada combinación de símbolos
+ * leídos, la primera transición aplicable escribe y mueve lo mismo y va al
+ * mismo bloque, y tienen la misma operación nativa (o ninguna). Los estados de
+ * aceptación son todos equivalentes porque el simulador se detiene al entrar en ellos.
+ *
+ * @param model Modelo original.
+ * @param states Estados que participan (los alcanzables).
+ * @return Map de cada estado a su representante (el inicial o el menor id del bloque).
+ */
+std::map<std::string, std::string> MachineOptimizer::mergeEquivalent(const TuringMachineModel& model,
+                                                                     const std::set<std::string>& states) const {
+  std::map<std::string, int> block;
+  for (const auto& id : states) block[id] = model.getStateById(id).isAccept() ? 0 : 1;
+  size_t blockCount = 0;
+  while (true) {
+    std::map<std::pair<int, std::string>, int> newBlocks;
+    std::map<std::string, int> refined;
+    for (const auto& id : states) {
+      std::ostringstream signature;
+      if (!model.getStateById(id).isAccept()) {
+        const Transition* builtin = model.getBuiltinFrom(id);
+        if (builtin != nullptr) signature << builtin->getBuiltin() << "\n";
+        std::map<std::string, std::string> firstMatch;
+        for (const auto& transition : model.getTransitionsFrom(id)) {
+          std::string key = readKey(transition);
+          if (firstMatch.count(key)) continue;
+          auto target = block.find(transition.getTo().getId());
+          std::string to = target != block.end() ? std::to_string(target->second) : "?" + transition.getTo().getId();
+          firstMatch[key] = to + "|" + actionKey(transition);
+        }
+        for (const auto& entry : firstMatch) signature << entry.first << "=" << entry.second << "\n";
+      }
+      auto key = std::make_pair(block[id], signature.str());
+      auto it = newBlocks.find(key);
+      if (it == newBlocks.end()) it = newBlocks.insert(std::make_pair(key, (int)newBlocks.size())).first;
+      refined[id] = it->second;
+    }
+    block = refined;
+    if (newBlocks.size() == blockCount) break;
+    blockCount = newBlocks.size();
+  }
+  std::map<int, std::string> blockRepresentative;
+  const std::string& initial = model.getInitialStateId();
+  if (block.count(initial)) blockRepresentative[block[initial]] = initial;
+  for (const auto& id : states) {
+    if (!blockRepresentative.count(block[id])) blockRepresentative[block[id]] = id;
+  }
+  std::map<std::string, std::string> representative;
+  for (const auto& id : states) representative[id] = blockRepresentative[block[id]];
+  return representative;
+}
+
+/**
+ * @brief Calcula los estados desde los que no se puede alcanzar ningún estado de aceptación.
+ *
+ * Recorre el grafo de transiciones al revés desde los estados de aceptación;
+ * los estados no visitados son muertos.
+ *
+ * @param states Estados del modelo optimizado.
+ * @param transitions Transiciones del modelo optimizado.
+ * @param acceptStates Estados de aceptación.
+ * @return Conjunto de estados muertos.
+ */
+std::set<std::string> MachineOptimizer::findDead(const std::set<std::string>& states,
+                                                 const std::vector<Transition>& transitions,
+                                                 const std::set<std::string>& acceptStates) const {
+  std::map<std::string, std::vector<std::string>> predecessors;
+  for (const auto& transition : transitions) {
+    predecessors[transition.getTo().getId()].push_back(transition.getFrom().getId());
+  }
+  std::set<std::string> alive(acceptStates.begin(), acceptStates.end());
+  std::deque<std::string> pending(acceptStates.begin(), acceptStates.end());
+  while (!pending.empty()) {
+    std::string id = pending.front();
+    pending.pop_front();
+    for (const auto& from : predecessors[id]) {
+      if (alive.insert(from).second) pending.push_back(from);
+    }
+  }
+  std::set<std::string> dead;
+  for (const auto& id : states) {
+    if (!alive.count(id)) dead.insert(id);
+  }
+  return dead;
+}
@@ -0,0 +1,49 @@
+#ifndef MACHINE_OPTIMIZER_H
+#define MACHINE_OPTIMIZER_H
+
+#include <map>
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+#include "turing_machine_model.h"
+
+/**
+ * @brief Resumen de lo que ha cambiado una pasada de optimización.
+ */
+struct OptimizationSummary {
+  int statesBefore = 0;
+  int statesAfter = 0;
+  int transitionsBefore = 0;
+  int transitionsAfter = 0;
+  int unreachableStates = 0;
+  int mergedStates = 0;
+  int deadStates = 0;
+};
+
+std::ostream& operator<<(std::ostream& os, const OptimizationSummary& summary);
+
+/**
+ * @brief Pasada de optimización sobre un TuringMachineModel.
+ *
+ * Produce un modelo equivalente en veredicto (aceptada/rechazada) con:
+ * - los estados inalcanzables desde el inicial y sus transiciones eliminados,
+ * - los estados con comportamiento idéntico fusionados (refinamiento de
+ *   particiones al estilo de la minimización de Moore),
+ * - los estados desde los que es imposible alcanzar la aceptación marcados
+ *   como muertos, para que el simulador rechace en cuanto entra en uno.
+ */
+class MachineOptimizer {
+ public:
+  TuringMachineModel optimize(const TuringMachineModel& model);
+  const OptimizationSummary& getSummary() const { return summary_; }
+ private:
+  std::set<std::string> findReachable(const TuringMachineModel& model) const;
+  std::map<std::string, std::string> mergeEquivalent(const TuringMachineModel& model,
+                                                     const std::set<std::string>& states) const;
+  std::set<std::string> findDead(const std::set<std::string>& states, const std::vector<Transition>& transitions,
+                                 const std::set<std::string>& acceptStates) const;
+  OptimizationSummary summary_;
+};
+
+#endif
@@ -0,0 +1,121 @@
+#include "mapped_tape.h"
+#include <algorithm>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+/**
+ * @brief Escribe un bloque completo en un descriptor, reintentando escrituras parciales.
+ */
+void writeAll(int fd, const char* data, size_t size, const std::string& path) {
+  while (size > 0) {
+    ssize_t n = ::write(fd, data, size);
+    if (n < 0) throw std::runtime_error("Error escribiendo la cinta en: " + path);
+    data += n;
+    size -= n;
+  }
+}
+
+/**
+ * @brief Cierra un descriptor al salir de su ámbito, también si se lanza una excepción.
+ */
+class FdCloser {
+ public:
+  explicit FdCloser(int fd) : fd_(fd) {}
+  ~FdCloser() { ::close(fd_); }
+  FdCloser(const FdCloser&) = delete;
+  FdCloser& operator=(const FdCloser&) = delete;
+ private:
+  int fd_;
+};
+
+}  // namespace
+
+/**
+ * @brief Proyecta un fichero de entrada como cinta 0.
+ *
+ * El salto de línea final del fichero (\n o \r\n), si lo hay, no forma parte
+ * de la cinta. Un fichero vacío equivale a la cadena vacía: la cinta contiene
+ * un único blanco.
+ *
+ * @param path Ruta del fichero de entrada.
+ * @throws std::runtime_error si no se puede abrir o proyectar el fichero.
+ */
+MappedTape::MappedTape(const std::string& path) : fd_(-1), data_(nullptr), size_(0), mappedBytes_(0) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) throw std::runtime_error("No se pudo abrir el fichero de cinta: " + path);
+  struct stat info;
+  if (::fstat(fd, &info) != 0) {
+    ::close(fd);
+    throw std::runtime_error("No se pudo consultar el fichero de cinta: " + path);
+  }
+  mappedBytes_ = info.st_size;
+  if (mappedBytes_ > 0) {
+    void* mapping = ::mmap(nullptr, mappedBytes_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+      ::close(fd);
+      throw std::runtime_error("No se pudo proyectar en memoria el fichero de cinta: " + path);
+    }
+    data_ = static_cast<char*>(mapping);
+  }
+  fd_ = fd;
+  size_ = mappedBytes_;
+  dirtyPages_.assign((size_ + kPageSize - 1) / kPageSize, false);
+  if (size_ > 0 && data_[size_ - 1] == '\n') size_--;
+  if (size_ > 0 && data_[size_ - 1] == '\r') size_--;
+  if (size_ == 0) right_.push_back('.');
+}
+
+/**
+ * @brief Libera la proyección (las páginas modificadas se descartan).
+ */
+MappedTape::~MappedTape() {
+  if (data_ != nullptr) ::munmap(data_, mappedBytes_);
+  if (fd_ >= 0) ::close(fd_);
+}
+
+/**
+ * @brief Escribe el contenido completo de la cinta en un fichero.
+ *
+ * Vuelca directamente la extensión izquierda, la zona proyectada y la
+ * extensión derecha, sin construir ninguna copia intermedia de la cinta.
+ * De la zona proyectada solo se leen desde memoria las páginas modificadas;
+ * los tramos intactos se copian del fichero original con sendfile(), así
+ * que nunca se cargan en el proceso páginas que los cabezales no tocaron.
+ *
+ * @param path Ruta del fichero de salida.
+ * @throws std::runtime_error si no se puede escribir el fichero.
+ */
+void MappedTape::writeTo(const std::string& path) const {
+  int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) throw std::runtime_error("No se pudo crear el fichero de cinta: " + path);
+  FdCloser closer(fd);
+  std::vector<char> left(left_.rbegin(), left_.rend());
+  writeAll(fd, left.data(), left.size(), path);
+  int64_t offset = 0;
+  while (offset < size_) {
+    int64_t page = offset / kPageSize;
+    bool dirty = dirtyPages_[page];
+    int64_t runEnd = offset;
+    while (runEnd < size_ && dirtyPages_[runEnd / kPageSize] == dirty) {
+      runEnd = std::min<int64_t>(size_, (runEnd / kPageSize + 1) * kPageSize);
+    }
+    if (dirty) {
+      writeAll(fd, data_ + offset, runEnd - offset, path);
+    } else {
+      off_t source = offset;
+      while (source < runEnd) {
+        ssize_t n = ::sendfile(fd, fd_, &source, runEnd - source);
+        if (n <= 0) throw std::runtime_error("Error copiando la cinta en: " + path);
+      }
+    }
+    offset = runEnd;
+  }
+  writeAll(fd, right_.data(), right_.size(), path);
+  writeAll(fd, "\n", 1, path);
+}
@@ -0,0 +1,56 @@
+#ifndef MAPPED_TAPE_H
+#define MAPPED_TAPE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Cinta respaldada por un fichero proyectado en memoria (mmap).
+ *
+ * El fichero se proyecta con MAP_PRIVATE, así que las escrituras de la MT son
+ * copia-en-escritura: nunca modifican el fichero original y el núcleo solo
+ * carga las páginas que los cabezales llegan a tocar. La cinta puede crecer
+ * por ambos extremos con blancos; esas celdas nuevas viven en dos vectores
+ * aparte (el izquierdo guardado al revés). Las posiciones son lógicas y de 64
+ * bits: la celda 0 es el primer byte del fichero. Se anotan las páginas
+ * modificadas para que, al volcar la cinta, las no modificadas se copien
+ * directamente del fichero original sin pasar por la proyección.
+ */
+class MappedTape {
+ public:
+  explicit MappedTape(const std::string& path);
+  ~MappedTape();
+  MappedTape(const MappedTape&) = delete;
+  MappedTape& operator=(const MappedTape&) = delete;
+  char get(int64_t pos) const {
+    if (pos >= 0 && pos < size_) return data_[pos];
+    if (pos < 0) return left_[-pos - 1];
+    return right_[pos - size_];
+  }
+  void set(int64_t pos, char value) {
+    if (pos >= 0 && pos < size_) {
+      if (data_[pos] == value) return;
+      data_[pos] = value;
+      dirtyPages_[pos / kPageSize] = true;
+    }
+    else if (pos < 0) left_[-pos - 1] = value;
+    else right_[pos - size_] = value;
+  }
+  int64_t begin() const { return -static_cast<int64_t>(left_.size()); }
+  int64_t end() const { return size_ + static_cast<int64_t>(right_.size()); }
+  void extendLeft() { left_.push_back('.'); }
+  void extendRight() { right_.push_back('.'); }
+  void writeTo(const std::string& path) const;
+ private:
+  static const int64_t kPageSize = 4096;
+  int fd_;
+  char* data_;
+  int64_t size_;
+  size_t mappedBytes_;
+  std::vector<char> left_;
+  std::vector<char> right_;
+  std::vector<bool> dirtyPages_;
+};
+
+#endif
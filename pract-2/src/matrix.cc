@@ -0,0 +1,159 @@
+#include "matrix.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+/**
+ * @brief Constructor de la matriz.
+ * 
+ * @param machines Simuladores de las MT (uno por columna, ya configurados).
+ * @param names Nombre de cada MT para la cabecera de la tabla.
+ * @param projection Cintas y modo de salida de cada celda.
+ * @param threads Número de hilos (al menos 1).
+ */
+Matrix::Matrix(const std::vector<const TuringMachineSimulator*>& machines, const std::vector<std::string>& names,
+               const ResultProjection& projection, int threads)
+  : machines_(machines), projection_(projection), threads_(std::max(threads, 1)), rowOffset_(1, 0), seconds_(0) {
+  for (const std::string& name : names) {
+    MatrixColumn column;
+    column.name = name;
+    columns_.push_back(column);
+  }
+}
+
+/**
+ * @brief Lee un fichero de cadenas y añade sus líneas como filas de la matriz.
+ * 
+ * Igual que en el modo normal, se ignoran las líneas vacías y los espacios.
+ * 
+ * @param name Nombre del fichero (primera columna de la tabla).
+ * @param input Stream del fichero ya abierto.
+ */
+void Matrix::addStrings(const std::string& name, std::istream& input) {
+  files_.push_back(name);
+  RunContext context;
+  std::string line;
+  while (std::getline(input, line)) {
+    if (line.empty()) continue;
+    context.load(line);
+    rowFile_.push_back(files_.size() - 1);
+    rowInput_.push_back(line);
+    symbols_.insert(symbols_.end(), context.getInput().begin(), context.getInput().end());
+    rowOffset_.push_back(symbols_.size());
+  }
+}
+
+/**
+ * @brief Ejecuta todas las MT sobre todas las cadenas.
+ */
+void Matrix::run() {
+  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+  const size_t rows = rowInput_.size();
+  const size_t tiles = (rows + kTile - 1) / kTile;
+  cells_.assign(rows * machines_.size(), std::string());
+  std::atomic<size_t> next(0);
+  std::vector<std::vector<MatrixColumn>> partial(threads_, std::vector<MatrixColumn>(machines_.size()));
+  std::vector<std::thread> workers;
+  for (int w = 0; w < threads_; ++w) {
+    workers.emplace_back([&, w] {
+      RunContext context;
+      for (size_t tile = next++; tile < tiles; tile = next++) runTile(tile, context, partial[w]);
+    });
+  }
+  for (std::thread& worker : workers) worker.join();
+  for (size_t m = 0; m < columns_.size(); ++m) {
+    for (int w = 0; w < threads_; ++w) {
+      columns_[m].accepted += partial[w][m].accepted;
+      columns_[m].rejected += partial[w][m].rejected;
+      columns_[m].stepLimit += partial[w][m].stepLimit;
+      columns_[m].errors += partial[w][m].errors;
+      columns_[m].steps += partial[w][m].steps;
+    }
+  }
+  seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+/**
+ * @brief Ejecuta todas las MT sobre un bloque de cadenas y rellena sus celdas.
+ * 
+ * Un error de una MT (p. ej. una transición mal formada) se anota en su celda
+ * sin detener el resto de la matriz.
+ * 
+ * @param tile Índice del bloque.
+ * @param context Memoria de trabajo del hilo.
+ * @param columns Contadores por MT del hilo.
+ */
+void Matrix::runTile(size_t tile, RunContext& context, std::vector<MatrixColumn>& columns) {
+  size_t first = tile * kTile;
+  size_t last = std::min(rowInput_.size(), first + kTile);
+  for (size_t m = 0; m < machines_.size(); ++m) {
+    const TuringMachineSimulator& simulator = *machines_[m];
+    for (size_t row = first; row < last; ++row) {
+      std::string& cell = cells_[row * machines_.size() + m];
+      try {
+        context.load(symbols_.data() + rowOffset_[row], symbols_.data() + rowOffset_[row + 1]);
+        simulator.start(context);
+        RunStatus status = simulator.run(context, false, context.getTrace());
+        columns[m].steps += context.getConfiguration().getSteps();
+        if (status == RunStatus::ACCEPTED) columns[m].accepted++;
+        else if (status == RunStatus::STEP_LIMIT) columns[m].stepLimit++;
+        else columns[m].rejected++;
+        cell.assign(status == RunStatus::ACCEPTED ? "ACEPTADA" : "RECHAZADA");
+        if (!projection_.isVerdictOnly()) {
+          cell.append(" -> ");
+          projection_.write(cell, context.getConfiguration());
+        }
+      } catch (const std::exception& error) {
+        columns[m].errors++;
+        cell.assign("ERROR: ").append(error.what());
+      }
+    }
+  }
+}
+
+/**
+ * @brief Escribe la tabla de resultados separada por tabuladores.
+ * 
+ * La cabecera es "fichero, cadena" seguida del nombre de cada MT; cada fila es
+ * una cadena con el veredicto de cada MT y, salvo con --verdict-only, la
+ * proyección de sus cintas tras " -> ".
+ * 
+ * @param os Stream de salida.
+ */
+void Matrix::write(std::ostream& os) const {
+  os << "fichero\tcadena";
+  for (const MatrixColumn& column : columns_) os << "\t" << column.name;
+  os << "\n";
+  std::string line;
+  for (size_t row = 0; row < rowInput_.size(); ++row) {
+    line.assign(files_[rowFile_[row]]).append("\t").append(rowInput_[row]);
+    for (size_t m = 0; m < machines_.size(); ++m) line.append("\t").append(cells_[row * machines_.size() + m]);
+    line.push_back('\n');
+    os << line;
+  }
+}
+
+/**
+ * @brief Muestra el resumen de la matriz: totales por MT y rendimiento.
+ * 
+ * @param os Stream de salida.
+ * @param matrix Matriz ya ejecutada.
+ * @return Referencia al stream de salida para permitir encadenamiento.
+ */
+std::ostream& operator<<(std::ostream& os, const Matrix& matrix) {
+  uint64_t cells = matrix.cells_.size();
+  os << "Matriz: " << matrix.columns_.size() << " MT x " << matrix.rowInput_.size() << " cadenas de "
+     << matrix.files_.size() << " ficheros = " << cells << " simulaciones en " << matrix.seconds_ << " s";
+  if (matrix.seconds_ > 0) os << " (" << static_cast<uint64_t>(cells / matrix.seconds_) << " simulaciones/s)";
+  os << ", " << matrix.threads_ << " hilos, bloques de " << Matrix::kTile << " cadenas\n";
+  for (size_t m = 0; m < matrix.columns_.size(); ++m) {
+    const MatrixColumn& column = matrix.columns_[m];
+    os << "  " << m + 1 << ". " << column.name << ": " << column.accepted << " aceptadas, "
+       << column.rejected + column.stepLimit << " rechazadas (" << column.stepLimit << " por límite de pasos), "
+       << column.steps << " pasos";
+    if (column.errors > 0) os << ", " << column.errors << " errores";
+    if (m + 1 < matrix.columns_.size()) os << "\n";
+  }
+  return os;
+}
@@ -0,0 +1,63 @@
+#ifndef MATRIX_H
+#define MATRIX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "result_projection.h"
+#include "symbol.h"
+#include "turing_machine_simulator.h"
+
+/**
+ * @brief Resumen de una MT (una columna) en el modo matriz.
+ */
+struct MatrixColumn {
+  std::string name;
+  uint64_t accepted = 0;
+  uint64_t rejected = 0;
+  uint64_t stepLimit = 0;
+  uint64_t errors = 0;
+  long long steps = 0;
+};
+
+/**
+ * @brief Evalúa varias MT sobre las mismas cadenas en una sola ejecución (--matrix).
+ *
+ * Las cadenas de todos los ficheros se leen y se convierten a símbolos una sola
+ * vez, en un único buffer contiguo. La matriz MT × cadena se recorre por
+ * bloques de kTile cadenas que los hilos se reparten con un contador atómico:
+ * cada hilo ejecuta todas las MT sobre su bloque antes de pasar al siguiente,
+ * de modo que las cadenas del bloque siguen en caché mientras se cambia de MT.
+ * Cada hilo reutiliza su propio RunContext; los simuladores no se modifican al
+ * simular y se comparten entre hilos. El resultado es una tabla con una fila
+ * por cadena y una columna por MT.
+ */
+class Matrix {
+ public:
+  static const size_t kTile = 256;
+  Matrix(const std::vector<const TuringMachineSimulator*>& machines, const std::vector<std::string>& names,
+         const ResultProjection& projection, int threads);
+  void addStrings(const std::string& name, std::istream& input);
+  void run();
+  void write(std::ostream& os) const;
+  const std::vector<MatrixColumn>& getColumns() const { return columns_; }
+  friend std::ostream& operator<<(std::ostream& os, const Matrix& matrix);
+ private:
+  void runTile(size_t tile, RunContext& context, std::vector<MatrixColumn>& columns);
+  std::vector<const TuringMachineSimulator*> machines_;
+  const ResultProjection& projection_;
+  int threads_;
+  std::vector<std::string> files_;
+  std::vector<size_t> rowFile_;
+  std::vector<std::string> rowInput_;
+  std::vector<size_t> rowOffset_;
+  std::vector<Symbol> symbols_;
+  std::vector<std::string> cells_;
+  std::vector<MatrixColumn> columns_;
+  double seconds_;
+};
+
+#endif
@@ -0,0 +1,60 @@
+#include "model_cache.h"
+#include <fstream>
+#include <stdexcept>
+#include "file_parser.h"
+#include "machine_optimizer.h"
+
+/**
+ * @brief Huella FNV-1a del contenido del fichero de la MT y de las opciones que cambian el modelo.
+ *
+ * @param mtFile Fichero de la MT.
+ * @param optimize Si el modelo se optimiza con MachineOptimizer.
+ * @return Huella de 64 bits.
+ * @throws std::runtime_error si no se puede leer el fichero.
+ */
+uint64_t ModelCache::sourceHash(const std::string& mtFile, bool optimize) {
+  std::ifstream infile(mtFile, std::ios::binary);
+  if (!infile.is_open()) throw std::runtime_error("No se pudo abrir el archivo: " + mtFile);
+  uint64_t hash = 1469598103934665603ULL;
+  char buffer[65536];
+  while (infile.read(buffer, sizeof(buffer)) || infile.gcount() > 0) {
+    for (std::streamsize i = 0; i < infile.gcount(); ++i) {
+      hash ^= static_cast<unsigned char>(buffer[i]);
+      hash *= 1099511628211ULL;
+    }
+  }
+  hash ^= optimize ? 1 : 0;
+  hash *= 1099511628211ULL;
+  return hash;
+}
+
+/**
+ * @brief Devuelve el modelo compacto de la caché, compilándolo antes si hace falta.
+ *
+ * @param cachePath Fichero de la caché.
+ * @param mtFile Fichero de la MT.
+ * @param optimize Si el modelo se optimiza con MachineOptimizer antes de compilarlo.
+ * @param rebuilt Salida: true si se ha tenido que compilar (la caché no existía o estaba obsoleta).
+ * @return Modelo compacto proyectado desde la caché.
+ */
+CompactModel ModelCache::load(const std::string& cachePath, const std::string& mtFile, bool optimize, bool& rebuilt) {
+  uint64_t hash = sourceHash(mtFile, optimize);
+  rebuilt = false;
+  try {
+    CompactModel cached = CompactModel::map(cachePath);
+    if (cached.getSourceHash() == hash) return cached;
+  } catch (const std::runtime_error&) {
+    // No existe o no es válida: se compila de nuevo.
+  }
+  FileParser parser;
+  CompactModel compiled;
+  if (optimize) {
+    MachineOptimizer optimizer;
+    compiled = CompactModel::fromModel(optimizer.optimize(parser.parseFile(mtFile)));
+  } else {
+    compiled = parser.parseCompactFile(mtFile);
+  }
+  compiled.save(cachePath, hash);
+  rebuilt = true;
+  return CompactModel::map(cachePath);
+}
@@ -0,0 +1,23 @@
+#ifndef MODEL_CACHE_H
+#define MODEL_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include "compact_model.h"
+
+/**
+ * @brief Caché en disco del modelo compacto compilado (--model-cache).
+ *
+ * El primer proceso que la necesita parsea la MT, construye el CompactModel y
+ * lo guarda; los demás (p. ej. los shards de un mismo lote en el mismo host)
+ * proyectan ese fichero en memoria de solo lectura y comparten sus páginas sin
+ * reparsear nada. La caché se invalida sola si cambia el fichero de la MT o la
+ * opción --optimize, porque su huella se guarda en la cabecera.
+ */
+class ModelCache {
+ public:
+  static CompactModel load(const std::string& cachePath, const std::string& mtFile, bool optimize, bool& rebuilt);
+  static uint64_t sourceHash(const std::string& mtFile, bool optimize);
+};
+
+#endif
@@ -0,0 +1,101 @@
+#include "perf_counters.h"
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+const char* const kEventNames[] = {"cycles", "instructions", "branch_misses", "l1d_misses", "llc_misses"};
+
+/**
+ * @brief Abre un contador del hilo actual en cualquier CPU, sin contar el núcleo ni el hipervisor.
+ *
+ * @return Descriptor del contador, o -1 (con errno) si no se pudo abrir.
+ */
+int openCounter(uint32_t type, uint64_t config) {
+  struct perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+}
+
+}  // namespace
+
+/**
+ * @brief Suma otra muestra evento a evento.
+ */
+PerfCounters::Sample& PerfCounters::Sample::operator+=(const Sample& other) {
+  for (int i = 0; i < EVENT_COUNT; ++i) values[i] += other.values[i];
+  return *this;
+}
+
+/**
+ * @brief Constructor: abre los contadores y toma la primera lectura de referencia.
+ */
+PerfCounters::PerfCounters() : available_(0) {
+  const uint32_t types[EVENT_COUNT] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE,
+                                       PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE};
+  const uint64_t configs[EVENT_COUNT] = {
+    PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES,
+    PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+    PERF_COUNT_HW_CACHE_MISSES};
+  for (int i = 0; i < EVENT_COUNT; ++i) {
+    fds_[i] = openCounter(types[i], configs[i]);
+    if (fds_[i] < 0) {
+      if (error_.empty()) error_ = std::strerror(errno);
+      continue;
+    }
+    available_++;
+    last_.values[i] = readScaled(static_cast<Event>(i));
+  }
+}
+
+/**
+ * @brief Destructor: cierra los contadores abiertos.
+ */
+PerfCounters::~PerfCounters() {
+  for (int fd : fds_) {
+    if (fd >= 0) close(fd);
+  }
+}
+
+/**
+ * @brief Devuelve lo contado desde la lectura anterior (o desde el constructor).
+ *
+ * @param delta Muestra donde se escriben los incrementos (0 en los eventos no disponibles).
+ */
+void PerfCounters::readDelta(Sample& delta) {
+  for (int i = 0; i < EVENT_COUNT; ++i) {
+    if (fds_[i] < 0) {
+      delta.values[i] = 0;
+      continue;
+    }
+    uint64_t value = readScaled(static_cast<Event>(i));
+    delta.values[i] = value >= last_.values[i] ? value - last_.values[i] : 0;
+    last_.values[i] = value;
+  }
+}
+
+/**
+ * @brief Lee el valor acumulado de un contador, escalado si ha estado multiplexado.
+ */
+uint64_t PerfCounters::readScaled(Event event) const {
+  uint64_t data[3];
+  if (read(fds_[event], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data[2] == 0) return 0;
+  if (data[1] == data[2]) return data[0];
+  return static_cast<uint64_t>(static_cast<double>(data[0]) * data[1] / data[2]);
+}
+
+/**
+ * @brief Nombre del evento en las métricas (etiqueta event).
+ */
+const char* PerfCounters::eventName(Event event) {
+  return kEventNames[event];
+}
@@ -0,0 +1,46 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Contadores hardware del hilo actual leídos con perf_event_open (Linux).
+ *
+ * Abre un contador independiente por evento (ciclos, instrucciones, fallos de
+ * predicción de saltos y fallos de L1 de datos y de último nivel), solo en
+ * espacio de usuario, de modo que basta con perf_event_paranoid <= 2. Si un
+ * evento no existe en la máquina (o en una VM sin PMU virtualizada) se omite
+ * sin afectar a los demás; si no se abre ninguno, isAvailable() es false y
+ * getError() dice por qué. Si el núcleo multiplexa los contadores, los valores
+ * se escalan con el tiempo que cada uno ha estado activo.
+ *
+ * Cada lectura cuesta una llamada al sistema por evento, así que solo se usa
+ * con --perf-counters.
+ */
+class PerfCounters {
+ public:
+  enum Event { CYCLES, INSTRUCTIONS, BRANCH_MISSES, L1D_MISSES, LLC_MISSES, EVENT_COUNT };
+  struct Sample {
+    Sample() { for (uint64_t& value : values) value = 0; }
+    Sample& operator+=(const Sample& other);
+    uint64_t values[EVENT_COUNT];
+  };
+  PerfCounters();
+  ~PerfCounters();
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+  bool isAvailable() const { return available_ > 0; }
+  bool isOpen(Event event) const { return fds_[event] >= 0; }
+  const std::string& getError() const { return error_; }
+  void readDelta(Sample& delta);
+  static const char* eventName(Event event);
+ private:
+  uint64_t readScaled(Event event) const;
+  int fds_[EVENT_COUNT];
+  int available_;
+  Sample last_;
+  std::string error_;
+};
+
+#endif
@@ -0,0 +1,132 @@
+#include "pipeline.h"
+#include <sstream>
+#include <thread>
+#include "blocking_queue.h"
+#include "result_projection.h"
+
+namespace {
+
+// Cadenas en vuelo como máximo entre dos etapas consecutivas.
+const size_t kQueueCapacity = 64;
+
+}  // namespace
+
+/**
+ * @brief Constructor del pipeline.
+ * 
+ * @param stages Simuladores de cada etapa, en orden (no se toma su propiedad).
+ * @param names Nombre de cada etapa para las estadísticas (p. ej. su fichero de MT).
+ */
+Pipeline::Pipeline(const std::vector<const TuringMachineSimulator*>& stages, const std::vector<std::string>& names)
+  : stages_(stages), stats_(stages.size()) {
+  for (size_t i = 0; i < stats_.size() && i < names.size(); ++i) stats_[i].name = names[i];
+}
+
+/**
+ * @brief Ejecuta una etapa sobre una cadena.
+ * 
+ * La primera etapa parte de la cadena de entrada; las demás toman la cinta 0
+ * final de la etapa anterior moviéndola a su configuración inicial, como si
+ * la leyeran de FileOut.txt con --output-mode trim: sin los blancos de los
+ * extremos y con el cabezal en su primera celda.
+ * 
+ * @param stage Índice de la etapa.
+ * @param item Cadena en curso (se actualiza con la nueva configuración y veredicto).
+ */
+void Pipeline::runStage(int stage, PipelineItem& item) {
+  StageStats& stats = stats_[stage];
+  if (!item.error.empty() || (stage > 0 && item.status != RunStatus::ACCEPTED)) {
+    stats.skipped++;
+    return;
+  }
+  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+  try {
+    const TuringMachineSimulator& simulator = *stages_[stage];
+    if (stage == 0) {
+      std::vector<Symbol> symbols;
+      for (char c : item.input) {
+        if (c != ' ' && c != '\n' && c != '\r') symbols.push_back(Symbol(c));
+      }
+      item.configuration = simulator.start(std::move(symbols));
+    } else {
+      std::vector<Symbol>& tape0 = item.configuration.getTapes()[0];
+      size_t begin, end;
+      trimmedRange(reinterpret_cast<const char*>(tape0.data()), tape0.size(), begin, end);
+      tape0.erase(tape0.begin() + end, tape0.end());
+      tape0.erase(tape0.begin(), tape0.begin() + begin);
+      item.configuration = simulator.start(std::move(tape0));
+    }
+    std::ostringstream unused;
+    item.status = simulator.run(item.configuration, false, unused);
+    item.stoppedAt = stage;
+    item.steps += item.configuration.getSteps();
+    stats.strings++;
+    stats.steps += item.configuration.getSteps();
+    if (item.status == RunStatus::ACCEPTED) stats.accepted++;
+    else stats.rejected++;
+  } catch (const std::exception& error) {
+    item.error = "etapa " + std::to_string(stage + 1) + ": " + error.what();
+  }
+  stats.busySeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+/**
+ * @brief Procesa todo el lote a través de las etapas.
+ * 
+ * Un hilo lee las cadenas, otro por etapa las simula y el hilo llamante
+ * recibe cada cadena terminada, en el orden del fichero, a través de sink.
+ * Las líneas vacías se ignoran, igual que en el modo normal.
+ * 
+ * @param inputs Stream con una cadena por línea.
+ * @param sink Función que recibe cada cadena al salir de la última etapa.
+ */
+void Pipeline::run(std::istream& inputs, const Sink& sink) {
+  int stageCount = stages_.size();
+  std::vector<std::unique_ptr<BlockingQueue<ItemPtr>>> queues;
+  for (int i = 0; i <= stageCount; ++i) queues.emplace_back(new BlockingQueue<ItemPtr>(kQueueCapacity));
+  std::vector<std::thread> threads;
+  threads.emplace_back([&inputs, &queues] {
+    std::string line;
+    uint64_t index = 0;
+    while (std::getline(inputs, line)) {
+      if (line.empty()) continue;
+      ItemPtr item(new PipelineItem());
+      item->index = index++;
+      item->input = line;
+      item->status = RunStatus::RUNNING;
+      item->stoppedAt = 0;
+      item->steps = 0;
+      item->started = std::chrono::steady_clock::now();
+      queues[0]->push(std::move(item));
+    }
+    queues[0]->push(ItemPtr());
+  });
+  for (int stage = 0; stage < stageCount; ++stage) {
+    threads.emplace_back([this, stage, &queues] {
+      while (true) {
+        ItemPtr item = queues[stage]->pop();
+        if (item) runStage(stage, *item);
+        bool done = !item;
+        queues[stage + 1]->push(std::move(item));
+        if (done) break;
+      }
+    });
+  }
+  while (ItemPtr item = queues[stageCount]->pop()) sink(*item);
+  for (auto& thread : threads) thread.join();
+}
+
+/**
+ * @brief Imprime las estadísticas de una etapa.
+ * 
+ * @param os Stream de salida.
+ * @param stats Estadísticas de la etapa.
+ * @return Referencia al stream de salida para permitir encadenamiento.
+ */
+std::ostream& operator<<(std::ostream& os, const StageStats& stats) {
+  os << stats.name << ": " << stats.strings << " cadenas (" << stats.accepted << " aceptadas, "
+     << stats.rejected << " rechazadas, " << stats.skipped << " sin ejecutar), " << stats.steps
+     << " pasos, " << stats.busySeconds << " s ocupada";
+  if (stats.busySeconds > 0) os << ", " << static_cast<long long>(stats.steps / stats.busySeconds) << " pasos/s";
+  return os;
+}
@@ -0,0 +1,70 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "configuration.h"
+#include "turing_machine_simulator.h"
+
+/**
+ * @brief Una cadena del lote mientras recorre las etapas del pipeline.
+ *
+ * La configuración de la última etapa ejecutada viaja con la cadena; la cinta 0
+ * final de una etapa se mueve (sin copiarse) a la configuración inicial de la
+ * siguiente.
+ */
+struct PipelineItem {
+  uint64_t index;
+  std::string input;
+  Configuration configuration;
+  RunStatus status;
+  int stoppedAt;
+  long long steps;
+  std::chrono::steady_clock::time_point started;
+  std::string error;
+};
+
+/**
+ * @brief Estadísticas de una etapa del pipeline.
+ */
+struct StageStats {
+  std::string name;
+  uint64_t strings = 0;
+  uint64_t accepted = 0;
+  uint64_t rejected = 0;
+  uint64_t skipped = 0;
+  long long steps = 0;
+  double busySeconds = 0;
+};
+
+std::ostream& operator<<(std::ostream& os, const StageStats& stats);
+
+/**
+ * @brief Encadena varias MT sobre la cinta 0 y las ejecuta en paralelo por etapas.
+ *
+ * Cada etapa tiene su propio hilo y se comunica con la siguiente mediante una
+ * BlockingQueue acotada, de modo que cadenas distintas ocupan etapas distintas
+ * al mismo tiempo y el orden del lote se conserva. Una cadena continúa a la
+ * siguiente etapa solo si la actual la acepta; si no, atraviesa las restantes
+ * sin ejecutarse y su resultado es la configuración de la etapa que la rechazó.
+ */
+class Pipeline {
+ public:
+  typedef std::function<void(PipelineItem&)> Sink;
+  Pipeline(const std::vector<const TuringMachineSimulator*>& stages, const std::vector<std::string>& names);
+  void run(std::istream& inputs, const Sink& sink);
+  const std::vector<StageStats>& getStats() const { return stats_; }
+ private:
+  typedef std::unique_ptr<PipelineItem> ItemPtr;
+  void runStage(int stage, PipelineItem& item);
+  std::vector<const TuringMachineSimulator*> stages_;
+  std::vector<StageStats> stats_;
+};
+
+#endif
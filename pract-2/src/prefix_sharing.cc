@@ -0,0 +1,150 @@
+#include "prefix_sharing.h"
+#include <algorithm>
+#include <sstream>
+
+/**
+ * @brief Constructor.
+ * 
+ * @param simulator Simulador de la MT (con su límite de pasos ya configurado).
+ */
+PrefixSharing::PrefixSharing(const TuringMachineSimulator& simulator)
+  : simulator_(simulator), offsets_(1, 0), nodes_(0), simulatedSteps_(0), stringSteps_(0) {
+}
+
+/**
+ * @brief Añade una entrada al lote.
+ * 
+ * @param index Posición de la entrada en el fichero de cadenas (se devuelve en el Sink).
+ * @param input Símbolos de la entrada.
+ */
+void PrefixSharing::add(uint64_t index, const std::vector<Symbol>& input) {
+  indices_.push_back(index);
+  symbols_.insert(symbols_.end(), input.begin(), input.end());
+  offsets_.push_back(symbols_.size());
+}
+
+/**
+ * @brief Simula todas las entradas y entrega cada resultado al Sink.
+ * 
+ * Los resultados llegan en el orden del recorrido del trie, no en el del
+ * fichero; el índice de cada entrada permite reordenarlos.
+ * 
+ * @param sink Función que recibe el índice, el veredicto y la configuración final de cada entrada.
+ */
+void PrefixSharing::run(const Sink& sink) {
+  order_.resize(indices_.size());
+  for (size_t i = 0; i < order_.size(); ++i) order_[i] = i;
+  std::sort(order_.begin(), order_.end(), [this](size_t a, size_t b) {
+    const Symbol* first = symbols_.data();
+    return std::lexicographical_compare(first + offsets_[a], first + offsets_[a + 1],
+                                        first + offsets_[b], first + offsets_[b + 1],
+                                        [](const Symbol& x, const Symbol& y) { return x.getValue() < y.getValue(); });
+  });
+  if (order_.empty()) return;
+  std::vector<Node> pending(1);
+  pending[0].first = 0;
+  pending[0].last = order_.size();
+  pending[0].depth = 0;
+  pending[0].status = RunStatus::RUNNING;
+  pending[0].configuration = simulator_.start(String(std::vector<Symbol>()));
+  while (!pending.empty()) {
+    Node node = std::move(pending.back());
+    pending.pop_back();
+    expand(node, pending, sink);
+  }
+}
+
+/**
+ * @brief Procesa un nodo del trie: termina sus entradas o lo ramifica por el siguiente símbolo.
+ * 
+ * Un nodo en marcha (RUNNING) tiene el cabezal 0 justo después de su prefijo,
+ * sobre el blanco que añadió runToTapeEnd(). Las entradas que acaban en el
+ * prefijo (van primero, por el orden) continúan con esa misma configuración;
+ * para cada símbolo siguiente, el blanco se sustituye por el símbolo y se
+ * simula hasta salir también de él o detenerse.
+ * 
+ * @param node Nodo a procesar (su configuración se mueve a la última rama).
+ * @param pending Pila de nodos pendientes.
+ * @param sink Destino de los resultados.
+ */
+void PrefixSharing::expand(Node& node, std::vector<Node>& pending, const Sink& sink) {
+  if (node.status != RunStatus::RUNNING || node.configuration.getSteps() > simulator_.getMaxSteps() ||
+      node.last - node.first == 1) {
+    for (size_t i = node.first; i < node.last; ++i) finish(node, order_[i], sink);
+    return;
+  }
+  size_t i = node.first;
+  if (length(order_[i]) == node.depth) {
+    Configuration configuration = node.configuration;
+    std::ostringstream unused;
+    RunStatus status = simulator_.run(configuration, false, unused);
+    simulatedSteps_ += configuration.getSteps() - node.configuration.getSteps();
+    for (; i < node.last && length(order_[i]) == node.depth; ++i) {
+      stringSteps_ += configuration.getSteps();
+      sink(indices_[order_[i]], status, configuration);
+    }
+  }
+  while (i < node.last) {
+    char symbol = symbolAt(order_[i], node.depth);
+    size_t j = i + 1;
+    while (j < node.last && symbolAt(order_[j], node.depth) == symbol) j++;
+    Node child;
+    child.first = i;
+    child.last = j;
+    child.depth = node.depth + 1;
+    if (j == node.last) child.configuration = std::move(node.configuration);
+    else child.configuration = node.configuration;
+    long long steps = child.configuration.getSteps();
+    child.configuration.getTapes()[0].back() = Symbol(symbol);
+    child.status = simulator_.runToTapeEnd(child.configuration, read_);
+    simulatedSteps_ += child.configuration.getSteps() - steps;
+    nodes_++;
+    pending.push_back(std::move(child));
+    i = j;
+  }
+}
+
+/**
+ * @brief Completa la configuración de un nodo con el resto de una entrada y la termina.
+ * 
+ * @param node Nodo del trie que contiene la entrada.
+ * @param entry Entrada a terminar.
+ * @param sink Destino del resultado.
+ */
+void PrefixSharing::finish(const Node& node, size_t entry, const Sink& sink) {
+  Configuration configuration = node.configuration;
+  std::vector<Symbol>& tape0 = configuration.getTapes()[0];
+  const Symbol* begin = symbols_.data() + offsets_[entry];
+  const Symbol* end = symbols_.data() + offsets_[entry + 1];
+  RunStatus status = node.status;
+  if (status == RunStatus::RUNNING) {
+    tape0.pop_back();
+    tape0.insert(tape0.end(), begin + node.depth, end);
+    if (configuration.getHeads()[0] == (int)tape0.size()) tape0.push_back(Symbol('.'));
+    if (configuration.getSteps() > simulator_.getMaxSteps()) {
+      status = RunStatus::STEP_LIMIT;
+    } else {
+      long long steps = configuration.getSteps();
+      std::ostringstream unused;
+      status = simulator_.run(configuration, false, unused);
+      simulatedSteps_ += configuration.getSteps() - steps;
+    }
+  } else {
+    tape0.insert(tape0.end(), begin + node.depth, end);
+  }
+  stringSteps_ += configuration.getSteps();
+  sink(indices_[entry], status, configuration);
+}
+
+/**
+ * @brief Muestra cuántos pasos se han simulado frente a los que suman todas las entradas.
+ */
+std::ostream& operator<<(std::ostream& os, const PrefixSharing& sharing) {
+  os << "Prefijos compartidos: " << sharing.indices_.size() << " cadenas, " << sharing.nodes_
+     << " nodos del trie simulados, " << sharing.simulatedSteps_ << " pasos simulados de "
+     << sharing.stringSteps_;
+  if (sharing.stringSteps_ > 0) {
+    os << " (" << 100.0 * (sharing.stringSteps_ - sharing.simulatedSteps_) / sharing.stringSteps_ << " % ahorrado)";
+  }
+  return os;
+}
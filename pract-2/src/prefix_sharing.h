@@ -0,0 +1,60 @@
+#ifndef PREFIX_SHARING_H
+#define PREFIX_SHARING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <vector>
+#include "configuration.h"
+#include "symbol.h"
+#include "turing_machine_simulator.h"
+
+/**
+ * @brief Ejecución de un lote compartiendo los prefijos comunes de las entradas (--prefix-sharing).
+ *
+ * Mientras el cabezal 0 no pasa del final de un prefijo, la ejecución es la
+ * misma para todas las entradas que empiezan por él. Las entradas se ordenan
+ * (lo que equivale a recorrer su trie en profundidad) y cada nodo del trie se
+ * simula una sola vez con TuringMachineSimulator::runToTapeEnd(): cuando el
+ * cabezal 0 sale del prefijo, la configuración se copia para cada símbolo
+ * siguiente y la simulación continúa en cada rama. Si la MT se detiene antes,
+ * todas las entradas del subárbol comparten veredicto y pasos, y su cinta 0 es
+ * la del nodo seguida del resto de cada entrada. Las entradas que quedan solas
+ * en su rama se terminan con run() normal.
+ *
+ * Es exacto: veredicto, pasos y cintas coinciden con simular cada entrada por
+ * separado. Los nodos pendientes se guardan en una pila explícita, así que la
+ * profundidad del trie no está limitada por la pila del programa.
+ */
+class PrefixSharing {
+ public:
+  typedef std::function<void(uint64_t index, RunStatus status, const Configuration& configuration)> Sink;
+  explicit PrefixSharing(const TuringMachineSimulator& simulator);
+  void add(uint64_t index, const std::vector<Symbol>& input);
+  void run(const Sink& sink);
+  friend std::ostream& operator<<(std::ostream& os, const PrefixSharing& sharing);
+ private:
+  struct Node {
+    size_t first;
+    size_t last;
+    size_t depth;
+    RunStatus status;
+    Configuration configuration;
+  };
+  size_t length(size_t entry) const { return offsets_[entry + 1] - offsets_[entry]; }
+  char symbolAt(size_t entry, size_t position) const { return symbols_[offsets_[entry] + position].getValue(); }
+  void expand(Node& node, std::vector<Node>& pending, const Sink& sink);
+  void finish(const Node& node, size_t entry, const Sink& sink);
+  const TuringMachineSimulator& simulator_;
+  std::vector<uint64_t> indices_;
+  std::vector<size_t> offsets_;
+  std::vector<Symbol> symbols_;
+  std::vector<size_t> order_;
+  std::vector<Symbol> read_;
+  uint64_t nodes_;
+  long long simulatedSteps_;
+  long long stringSteps_;
+};
+
+#endif
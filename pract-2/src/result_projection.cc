@@ -0,0 +1,127 @@
+#include "result_projection.h"
+#include <stdexcept>
+
+static_assert(sizeof(Symbol) == 1, "Symbol debe ocupar un byte para ver la cinta como char");
+
+/**
+ * @brief Crea una vista sobre una cinta del simulador.
+ * 
+ * @param tape Cinta (vector de símbolos de un byte).
+ * @param head Posición del cabezal en la cinta.
+ * @return Vista que apunta al almacenamiento de la cinta.
+ */
+TapeView makeTapeView(const std::vector<Symbol>& tape, int head) {
+  TapeView view;
+  view.cells = tape.empty() ? "" : reinterpret_cast<const char*>(tape.data());
+  view.size = tape.size();
+  view.head = head < 0 ? 0 : head;
+  return view;
+}
+
+/**
+ * @brief Calcula el tramo de una cinta sin los blancos de los extremos (el del modo TRIM).
+ * 
+ * @param cells Celdas de la cinta.
+ * @param size Número de celdas.
+ * @param begin Primera celda no blanca (salida).
+ * @param end Posición siguiente a la última celda no blanca (salida); begin == end si todo es blanco.
+ */
+void trimmedRange(const char* cells, size_t size, size_t& begin, size_t& end) {
+  begin = 0;
+  end = size;
+  while (begin < end && cells[begin] == '.') begin++;
+  while (end > begin && cells[end - 1] == '.') end--;
+}
+
+/**
+ * @brief Convierte el nombre de un modo (full, trim, span) en su valor.
+ * 
+ * @param name Nombre del modo.
+ * @return Modo correspondiente.
+ * @throws std::invalid_argument si el nombre no es válido.
+ */
+ResultProjection::Mode ResultProjection::parseMode(const std::string& name) {
+  if (name == "full") return Mode::FULL;
+  if (name == "trim") return Mode::TRIM;
+  if (name == "span") return Mode::SPAN;
+  throw std::invalid_argument("Modo de salida desconocido: " + name);
+}
+
+/**
+ * @brief Comprueba que todas las cintas seleccionadas existen en una máquina.
+ * 
+ * Se llama al cargar cada MT, para que una cinta inexistente en --output-tapes
+ * sea un error y no una columna vacía en todos los resultados.
+ * 
+ * @param tapeCount Número de cintas de la máquina.
+ * @param machine Nombre de la máquina (para el mensaje de error).
+ * @throws std::runtime_error si alguna cinta seleccionada no existe.
+ */
+void ResultProjection::checkTapes(int tapeCount, const std::string& machine) const {
+  if (verdictOnly_) return;
+  for (int index : tapes_) {
+    if (index < 0 || index >= tapeCount) {
+      throw std::runtime_error("--output-tapes: la cinta " + std::to_string(index) + " no existe en " + machine +
+                               " (tiene " + std::to_string(tapeCount) + (tapeCount == 1 ? " cinta)" : " cintas)"));
+    }
+  }
+}
+
+/**
+ * @brief Añade al buffer la proyección de las cintas seleccionadas.
+ * 
+ * Las cintas seleccionadas que la máquina no tiene (solo posible si no se ha
+ * llamado a checkTapes()) se escriben vacías.
+ * 
+ * @param out Buffer de salida (se le añade el resultado).
+ * @param tapes Vistas de todas las cintas de la máquina, indexadas por número de cinta.
+ */
+void ResultProjection::write(std::string& out, const std::vector<TapeView>& tapes) const {
+  bool first = true;
+  for (int index : tapes_) {
+    if (!first) out.append(" | ");
+    first = false;
+    if (index < 0 || index >= (int)tapes.size()) continue;
+    writeTape(out, tapes[index]);
+  }
+}
+
+/**
+ * @brief Añade al buffer la proyección de las cintas de una configuración final.
+ * 
+ * Construye las vistas de una en una, sin reservar un vector de vistas por cadena.
+ * 
+ * @param out Buffer de salida (se añade al final).
+ * @param configuration Configuración de la que se toman las cintas y cabezales.
+ */
+void ResultProjection::write(std::string& out, const Configuration& configuration) const {
+  const std::vector<std::vector<Symbol>>& tapes = configuration.getTapes();
+  bool first = true;
+  for (int index : tapes_) {
+    if (!first) out.append(" | ");
+    first = false;
+    if (index < 0 || index >= (int)tapes.size()) continue;
+    writeTape(out, makeTapeView(tapes[index], configuration.getHeads()[index]));
+  }
+}
+
+/**
+ * @brief Añade al buffer el tramo de una cinta que selecciona el modo.
+ * 
+ * @param out Buffer de salida (se le añade el tramo).
+ * @param tape Vista de la cinta.
+ */
+void ResultProjection::writeTape(std::string& out, const TapeView& tape) const {
+  size_t begin = 0;
+  size_t end = tape.size;
+  if (mode_ == Mode::TRIM) {
+    trimmedRange(tape.cells, tape.size, begin, end);
+  } else if (mode_ == Mode::SPAN) {
+    if (tape.head >= tape.size || tape.cells[tape.head] == '.') return;
+    begin = tape.head;
+    end = tape.head + 1;
+    while (begin > 0 && tape.cells[begin - 1] != '.') begin--;
+    while (end < tape.size && tape.cells[end] != '.') end++;
+  }
+  out.append(tape.cells + begin, end - begin);
+}
@@ -0,0 +1,53 @@
+#ifndef RESULT_PROJECTION_H
+#define RESULT_PROJECTION_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "configuration.h"
+#include "symbol.h"
+
+/**
+ * @brief Vista de solo lectura sobre una cinta ya existente (sin copiarla).
+ */
+struct TapeView {
+  const char* cells;
+  size_t size;
+  size_t head;
+};
+
+TapeView makeTapeView(const std::vector<Symbol>& tape, int head);
+void trimmedRange(const char* cells, size_t size, size_t& begin, size_t& end);
+
+/**
+ * @brief Decide qué parte de las cintas finales se escribe como resultado.
+ *
+ * - Qué cintas se emiten (por defecto solo la 0), separadas por " | ".
+ * - FULL: la cinta completa, incluidos los blancos de relleno (comportamiento original).
+ * - TRIM: sin los blancos de los extremos.
+ * - SPAN: solo el tramo sin blancos que rodea al cabezal.
+ * - Modo solo veredicto: no se extrae ninguna cinta.
+ *
+ * El resultado se añade directamente desde el almacenamiento de la cinta al
+ * buffer de salida, sin construir objetos String intermedios.
+ */
+class ResultProjection {
+ public:
+  enum class Mode { FULL, TRIM, SPAN };
+  ResultProjection() : tapes_(1, 0), mode_(Mode::FULL), verdictOnly_(false) {}
+  ResultProjection(const std::vector<int>& tapes, Mode mode, bool verdictOnly)
+    : tapes_(tapes), mode_(mode), verdictOnly_(verdictOnly) {}
+  static Mode parseMode(const std::string& name);
+  bool isVerdictOnly() const { return verdictOnly_; }
+  const std::vector<int>& getTapes() const { return tapes_; }
+  void checkTapes(int tapeCount, const std::string& machine) const;
+  void write(std::string& out, const std::vector<TapeView>& tapes) const;
+  void write(std::string& out, const Configuration& configuration) const;
+ private:
+  void writeTape(std::string& out, const TapeView& tape) const;
+  std::vector<int> tapes_;
+  Mode mode_;
+  bool verdictOnly_;
+};
+
+#endif
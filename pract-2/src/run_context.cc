@@ -0,0 +1,23 @@
+#include "run_context.h"
+
+/**
+ * @brief Carga una línea del fichero de cadenas como entrada, reutilizando el buffer.
+ * 
+ * Igual que en el modo normal, se ignoran los espacios y los saltos de línea.
+ * 
+ * @param line Línea del fichero de cadenas.
+ */
+void RunContext::load(const std::string& line) {
+  input_.clear();
+  for (char c : line) {
+    if (c != ' ' && c != '\n' && c != '\r') input_.push_back(Symbol(c));
+  }
+}
+
+/**
+ * @brief Vacía el stream de la traza para la siguiente cadena.
+ */
+void RunContext::resetTrace() {
+  trace_.str(std::string());
+  trace_.clear();
+}
@@ -0,0 +1,35 @@
+#ifndef RUN_CONTEXT_H
+#define RUN_CONTEXT_H
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include "configuration.h"
+#include "symbol.h"
+
+/**
+ * @brief Memoria de trabajo reutilizable entre las cadenas de un lote.
+ *
+ * Agrupa todo lo que antes se creaba y destruía en cada cadena: la entrada ya
+ * convertida a símbolos, la configuración (cintas y cabezales), el buffer de
+ * símbolos leídos en cada paso y el stream de la traza. Entre cadenas se
+ * vacía en lugar de liberarse, así que, una vez que las cintas han alcanzado
+ * su tamaño máximo, simular una cadena no reserva memoria dinámica.
+ */
+class RunContext {
+ public:
+  void load(const std::string& line);
+  void load(const Symbol* begin, const Symbol* end) { input_.assign(begin, end); }
+  const std::vector<Symbol>& getInput() const { return input_; }
+  Configuration& getConfiguration() { return configuration_; }
+  std::vector<Symbol>& getReadBuffer() { return read_; }
+  std::ostringstream& getTrace() { return trace_; }
+  void resetTrace();
+ private:
+  std::vector<Symbol> input_;
+  Configuration configuration_;
+  std::vector<Symbol> read_;
+  std::ostringstream trace_;
+};
+
+#endif
@@ -0,0 +1,150 @@
+#include "scheduler.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * @brief Orden del montículo de SRF: arriba la ejecución con menos pasos (a igualdad, la más antigua).
+ */
+bool laterThan(const std::unique_ptr<Execution>& a, const std::unique_ptr<Execution>& b) {
+  if (a->getSteps() != b->getSteps()) return a->getSteps() > b->getSteps();
+  return a->getIndex() > b->getIndex();
+}
+
+}  // namespace
+
+/**
+ * @brief Constructor del planificador.
+ * 
+ * @param simulator Simulador de la MT (no se toma su propiedad).
+ * @param policy Política de reparto entre ejecuciones en vuelo.
+ * @param quantum Pasos que avanza una ejecución cada vez que se le da turno.
+ * @param maxInFlight Número máximo de ejecuciones en vuelo a la vez.
+ * @throws std::invalid_argument si quantum o maxInFlight no son positivos.
+ */
+Scheduler::Scheduler(const TuringMachineSimulator& simulator, Policy policy, long long quantum, size_t maxInFlight)
+  : simulator_(simulator), policy_(policy), quantum_(quantum), maxInFlight_(maxInFlight),
+    quanta_(0), preemptions_(0), finished_(0), yields_(0), idleRounds_(0), consecutiveYields_(0) {
+  if (quantum_ <= 0 || maxInFlight_ == 0) {
+    throw std::invalid_argument("El quantum y el número de ejecuciones en vuelo deben ser positivos");
+  }
+}
+
+/**
+ * @brief Convierte el nombre de una política (fair o srf) en su valor.
+ * 
+ * @throws std::invalid_argument si el nombre no es válido.
+ */
+Scheduler::Policy Scheduler::parsePolicy(const std::string& name) {
+  if (name == "fair") return Policy::FAIR;
+  if (name == "srf") return Policy::SRF;
+  throw std::invalid_argument("--schedule debe ser fair o srf: " + name);
+}
+
+/**
+ * @brief Pone una cadena en vuelo (con su configuración inicial, aún sin pasos).
+ * 
+ * @param index Índice de la cadena en el lote.
+ * @param input Cadena tal como aparece en el fichero.
+ * @param string Cadena de entrada ya convertida a símbolos.
+ */
+void Scheduler::admit(uint64_t index, const std::string& input, const String& string) {
+  push(ExecutionPtr(new Execution(simulator_, index, input, string)));
+}
+
+/**
+ * @brief Pone en vuelo una entrada que llega poco a poco por un descriptor (--stream-tape).
+ * 
+ * @param index Índice de la entrada en el lote.
+ * @param input Origen tal como aparece en el fichero.
+ * @param stream Entrada de la cinta 0.
+ */
+void Scheduler::admit(uint64_t index, const std::string& input, std::unique_ptr<StreamTape> stream) {
+  push(ExecutionPtr(new Execution(simulator_, index, input, std::move(stream))));
+}
+
+/**
+ * @brief Da un quantum a la siguiente ejecución según la política.
+ * 
+ * Si la ejecución termina se entrega al sink y se libera; si no, vuelve a la cola.
+ * Si no ha avanzado (espera entrada) cuenta como cesión, y cuando han cedido
+ * todas las ejecuciones en vuelo seguidas se espera a que llegue entrada a alguna.
+ * 
+ * @param sink Función que recibe cada ejecución terminada.
+ * @return false si no había ninguna ejecución en vuelo.
+ */
+bool Scheduler::runQuantum(const Sink& sink) {
+  if (inFlight() == 0) return false;
+  ExecutionPtr execution = pop();
+  long long before = execution->getSteps();
+  execution->step(quantum_);
+  quanta_++;
+  if (execution->isFinished()) {
+    finished_++;
+    consecutiveYields_ = 0;
+    sink(*execution);
+  } else if (execution->getStream() != nullptr && execution->getSteps() == before) {
+    yields_++;
+    push(std::move(execution));
+    if (++consecutiveYields_ >= inFlight()) {
+      std::vector<const StreamTape*> waiting;
+      for (const ExecutionPtr& pending : queue_) waiting.push_back(pending->getStream());
+      StreamTape::waitAny(waiting);
+      idleRounds_++;
+      consecutiveYields_ = 0;
+    }
+  } else {
+    preemptions_++;
+    consecutiveYields_ = 0;
+    push(std::move(execution));
+  }
+  return true;
+}
+
+/**
+ * @brief Devuelve una ejecución en vuelo a la cola (FAIR) o al montículo (SRF).
+ */
+void Scheduler::push(ExecutionPtr execution) {
+  if (policy_ == Policy::FAIR) {
+    queue_.push_back(std::move(execution));
+  } else {
+    heap_.push_back(std::move(execution));
+    std::push_heap(heap_.begin(), heap_.end(), laterThan);
+  }
+}
+
+/**
+ * @brief Saca la ejecución a la que le toca el turno.
+ */
+Scheduler::ExecutionPtr Scheduler::pop() {
+  ExecutionPtr execution;
+  if (policy_ == Policy::FAIR) {
+    execution = std::move(queue_.front());
+    queue_.pop_front();
+  } else {
+    std::pop_heap(heap_.begin(), heap_.end(), laterThan);
+    execution = std::move(heap_.back());
+    heap_.pop_back();
+  }
+  return execution;
+}
+
+/**
+ * @brief Muestra las estadísticas del planificador (cuantos, expulsiones, ejecuciones terminadas).
+ * 
+ * @param os Stream de salida.
+ * @param scheduler Planificador.
+ * @return Referencia al stream de salida para permitir encadenamiento.
+ */
+std::ostream& operator<<(std::ostream& os, const Scheduler& scheduler) {
+  os << "Planificador " << (scheduler.policy_ == Scheduler::Policy::FAIR ? "fair" : "srf")
+     << " (quantum " << scheduler.quantum_ << " pasos, " << scheduler.maxInFlight_ << " en vuelo): "
+     << scheduler.finished_ << " cadenas, " << scheduler.quanta_ << " cuantos, "
+     << scheduler.preemptions_ << " expulsiones";
+  if (scheduler.yields_ > 0) {
+    os << ", " << scheduler.yields_ << " cesiones por falta de entrada (" << scheduler.idleRounds_
+       << " esperas con todas paradas)";
+  }
+  return os;
+}
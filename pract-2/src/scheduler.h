@@ -0,0 +1,61 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "execution.h"
+
+/**
+ * @brief Planificador cooperativo de ejecuciones por cuantos de pasos (--schedule).
+ *
+ * Mantiene hasta maxInFlight ejecuciones en vuelo y las avanza de quantum en
+ * quantum pasos en el hilo llamante, de modo que una cadena de miles de
+ * millones de pasos no retrasa a las cortas que llegan detrás. Políticas:
+ *  - FAIR: turno rotatorio; todas las ejecuciones reciben el mismo reparto.
+ *  - SRF: primero la que menos le queda. Como los pasos restantes de una MT no
+ *    se conocen, se estiman por los ya consumidos (la que menos pasos lleva va
+ *    primero): una cadena nueva se ejecuta enseguida y, si es corta, termina
+ *    en su primer quantum.
+ * Las ejecuciones terminadas se entregan al sink en orden de finalización.
+ * Una ejecución con StreamTape que se queda sin entrada cede el turno sin
+ * avanzar; si todas las que están en vuelo ceden seguidas, se espera con
+ * poll() a que llegue algo a alguna (solo con FAIR: SRF volvería a elegir
+ * siempre la misma).
+ */
+class Scheduler {
+ public:
+  enum class Policy { FAIR, SRF };
+  typedef std::function<void(Execution&)> Sink;
+  Scheduler(const TuringMachineSimulator& simulator, Policy policy, long long quantum, size_t maxInFlight);
+  static Policy parsePolicy(const std::string& name);
+  void admit(uint64_t index, const std::string& input, const String& string);
+  void admit(uint64_t index, const std::string& input, std::unique_ptr<StreamTape> stream);
+  bool isFull() const { return inFlight() >= maxInFlight_; }
+  bool runQuantum(const Sink& sink);
+  void drain(const Sink& sink) { while (runQuantum(sink)) {} }
+  friend std::ostream& operator<<(std::ostream& os, const Scheduler& scheduler);
+ private:
+  typedef std::unique_ptr<Execution> ExecutionPtr;
+  size_t inFlight() const { return policy_ == Policy::FAIR ? queue_.size() : heap_.size(); }
+  void push(ExecutionPtr execution);
+  ExecutionPtr pop();
+  const TuringMachineSimulator& simulator_;
+  Policy policy_;
+  long long quantum_;
+  size_t maxInFlight_;
+  std::deque<ExecutionPtr> queue_;
+  std::vector<ExecutionPtr> heap_;
+  uint64_t quanta_;
+  uint64_t preemptions_;
+  uint64_t finished_;
+  uint64_t yields_;
+  uint64_t idleRounds_;
+  size_t consecutiveYields_;
+};
+
+#endif
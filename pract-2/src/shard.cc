@@ -0,0 +1,141 @@
+#include "shard.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+
+namespace {
+
+uint64_t fnv1a(const std::string& text) {
+  uint64_t hash = 1469598103934665603ULL;
+  for (unsigned char c : text) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+/**
+ * @brief Lee la siguiente línea "<índice>\t<resultado>" de un fichero de shard.
+ */
+bool readShardLine(std::istream& in, uint64_t& index, std::string& line, const std::string& path) {
+  std::string raw;
+  if (!std::getline(in, raw)) return false;
+  size_t tab = raw.find('\t');
+  if (tab == std::string::npos || tab == 0 || raw.find_first_not_of("0123456789") != tab) {
+    throw std::runtime_error("Línea de shard mal formada en " + path + ": " + raw);
+  }
+  index = std::strtoull(raw.c_str(), nullptr, 10);
+  line = raw.substr(tab + 1);
+  return true;
+}
+
+}  // namespace
+
+/**
+ * @brief Construye un shard a partir de "i/N" y del modo de reparto.
+ * 
+ * @param spec Shard en formato "i/N" con 0 <= i < N.
+ * @param mode "line" (por posición en el fichero) o "hash" (por contenido).
+ * @return Shard configurado.
+ * @throws std::invalid_argument si el formato no es válido.
+ */
+Shard Shard::parse(const std::string& spec, const std::string& mode) {
+  size_t slash = spec.find('/');
+  if (slash == std::string::npos || slash == 0 || slash + 1 == spec.size() ||
+      spec.find_first_not_of("0123456789/") != std::string::npos || spec.find('/', slash + 1) != std::string::npos) {
+    throw std::invalid_argument("--shard espera i/N (p. ej. 0/4): " + spec);
+  }
+  Shard shard;
+  shard.index_ = std::strtoul(spec.substr(0, slash).c_str(), nullptr, 10);
+  shard.count_ = std::strtoul(spec.substr(slash + 1).c_str(), nullptr, 10);
+  if (shard.count_ == 0 || shard.index_ >= shard.count_) {
+    throw std::invalid_argument("--shard i/N requiere 0 <= i < N: " + spec);
+  }
+  if (mode == "line") shard.mode_ = Mode::LINE;
+  else if (mode == "hash") shard.mode_ = Mode::HASH;
+  else throw std::invalid_argument("--shard-by debe ser line o hash: " + mode);
+  return shard;
+}
+
+/**
+ * @brief Indica si una cadena le corresponde a este shard.
+ * 
+ * @param lineIndex Índice global de la cadena (entre las líneas no vacías).
+ * @param line Cadena tal como aparece en el fichero.
+ * @return true si este shard debe procesarla.
+ */
+bool Shard::owns(uint64_t lineIndex, const std::string& line) const {
+  if (count_ <= 1) return true;
+  uint64_t key = mode_ == Mode::LINE ? lineIndex : fnv1a(line);
+  return key % count_ == index_;
+}
+
+/**
+ * @brief Fichero de resultados del shard: FileOut-<i>-of-<N>.txt (FileOut.txt sin shards).
+ */
+std::string Shard::getOutputPath() const {
+  if (count_ <= 1) return "FileOut.txt";
+  return "FileOut-" + std::to_string(index_) + "-of-" + std::to_string(count_) + ".txt";
+}
+
+/**
+ * @brief Prefijo de cada línea de resultado del shard ("<índice>\t"; vacío sin shards).
+ */
+std::string Shard::linePrefix(uint64_t lineIndex) const {
+  if (count_ <= 1) return std::string();
+  return std::to_string(lineIndex) + "\t";
+}
+
+/**
+ * @brief Junta los ficheros de varios shards en el orden original de las cadenas.
+ * 
+ * Cada fichero ya está ordenado por índice, así que basta una mezcla de k vías
+ * con una cola de prioridad (memoria proporcional al número de shards, no al
+ * de cadenas). Comprueba que no falte ni se repita ningún índice.
+ * 
+ * @param shardFiles Ficheros FileOut-<i>-of-<N>.txt.
+ * @param outputPath Fichero de salida (normalmente FileOut.txt).
+ * @return 0 si todo fue bien, 1 si falta o se repite alguna cadena o un fichero no se puede leer.
+ */
+int Shard::merge(const std::vector<std::string>& shardFiles, const std::string& outputPath) {
+  typedef std::pair<uint64_t, size_t> Head;
+  std::vector<std::unique_ptr<std::ifstream>> inputs;
+  std::vector<std::string> pending(shardFiles.size());
+  std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heads;
+  try {
+    for (size_t i = 0; i < shardFiles.size(); ++i) {
+      inputs.emplace_back(new std::ifstream(shardFiles[i]));
+      if (!inputs[i]->is_open()) {
+        std::cerr << "No se pudo abrir el fichero de shard: " << shardFiles[i] << std::endl;
+        return 1;
+      }
+      uint64_t index;
+      if (readShardLine(*inputs[i], index, pending[i], shardFiles[i])) heads.push(Head(index, i));
+    }
+    std::ofstream output(outputPath, std::ios::trunc);
+    uint64_t expected = 0;
+    while (!heads.empty()) {
+      Head head = heads.top();
+      heads.pop();
+      if (head.first != expected) {
+        std::cerr << (head.first < expected ? "Cadena repetida: " : "Falta la cadena ")
+                  << (head.first < expected ? head.first : expected) << " (¿falta algún shard?)" << std::endl;
+        return 1;
+      }
+      output << pending[head.second] << "\n";
+      expected++;
+      uint64_t index;
+      if (readShardLine(*inputs[head.second], index, pending[head.second], shardFiles[head.second])) {
+        heads.push(Head(index, head.second));
+      }
+    }
+    std::cout << expected << " resultados juntados en " << outputPath << "\n";
+  } catch (const std::runtime_error& error) {
+    std::cerr << error.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
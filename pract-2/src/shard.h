@@ -0,0 +1,34 @@
+#ifndef SHARD_H
+#define SHARD_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Partición determinista del fichero de cadenas entre N procesos (--shard i/N).
+ *
+ * Cada cadena (línea no vacía) tiene un índice global en el fichero. Con el
+ * reparto por línea el shard i se queda con los índices congruentes con i
+ * módulo N; con el reparto por contenido, con las cadenas cuyo hash FNV-1a es
+ * congruente con i (la misma cadena cae siempre en el mismo shard). Cada shard
+ * escribe sus resultados en su propio fichero, con el índice global delante de
+ * cada línea, y merge() los vuelve a juntar en el orden original de FileOut.txt.
+ */
+class Shard {
+ public:
+  enum class Mode { LINE, HASH };
+  Shard() : index_(0), count_(1), mode_(Mode::LINE) {}
+  static Shard parse(const std::string& spec, const std::string& mode);
+  bool isEnabled() const { return count_ > 1; }
+  bool owns(uint64_t lineIndex, const std::string& line) const;
+  std::string getOutputPath() const;
+  std::string linePrefix(uint64_t lineIndex) const;
+  static int merge(const std::vector<std::string>& shardFiles, const std::string& outputPath);
+ private:
+  uint32_t index_;
+  uint32_t count_;
+  Mode mode_;
+};
+
+#endif
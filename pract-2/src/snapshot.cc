@@ -0,0 +1,204 @@
+#include "snapshot.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+const char kMagic[8] = {'P', 'T', 'M', 'S', 'N', 'A', 'P', '1'};
+
+void putU64(std::string& out, uint64_t value) {
+  for (int i = 0; i < 8; ++i) out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+}
+
+void putString(std::string& out, const std::string& value) {
+  putU64(out, value.size());
+  out.append(value);
+}
+
+/**
+ * @brief Lector secuencial sobre el contenido de una instantánea.
+ */
+class Reader {
+ public:
+  Reader(const std::string& data, size_t pos, const std::string& path) : data_(data), path_(path), pos_(pos) {}
+  uint64_t u64() {
+    need(8);
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) value |= static_cast<uint64_t>(static_cast<unsigned char>(data_[pos_ + i])) << (8 * i);
+    pos_ += 8;
+    return value;
+  }
+  std::string str() {
+    uint64_t len = u64();
+    need(len);
+    std::string value = data_.substr(pos_, len);
+    pos_ += len;
+    return value;
+  }
+  void need(uint64_t n) {
+    if (n > data_.size() - pos_) {
+      throw std::runtime_error("Instantánea truncada o corrupta: " + path_);
+    }
+  }
+ private:
+  const std::string& data_;
+  const std::string& path_;
+  size_t pos_;
+};
+
+// Directorio que contiene path, para sincronizar la entrada del rename().
+std::string parentDirectory(const std::string& path) {
+  size_t slash = path.find_last_of('/');
+  if (slash == std::string::npos) return ".";
+  return slash == 0 ? "/" : path.substr(0, slash);
+}
+
+}  // namespace
+
+/**
+ * @brief Guarda la instantánea en disco de forma atómica.
+ *
+ * Escribe primero en "<path>.tmp", fuerza el volcado con fsync y después lo
+ * renombra sobre el fichero final. rename() es atómico en POSIX, por lo que
+ * un fallo a mitad de escritura nunca deja corrupta la última instantánea buena.
+ * Si el fsync falla no se renombra, y tras el rename se sincroniza también el
+ * directorio para que el cambio de nombre sobreviva a una caída.
+ *
+ * @param path Ruta del fichero de instantánea.
+ * @throws std::runtime_error si no se puede escribir el fichero.
+ */
+void Snapshot::save(const std::string& path) const {
+  std::string out(kMagic, sizeof(kMagic));
+  putU64(out, fingerprint_);
+  putU64(out, inputIndex_);
+  putU64(out, resultOffset_);
+  putString(out, input_);
+  putString(out, configuration_.getState().getId());
+  putU64(out, static_cast<uint64_t>(configuration_.getSteps()));
+  const auto& tapes = configuration_.getTapes();
+  const auto& heads = configuration_.getHeads();
+  putU64(out, tapes.size());
+  for (size_t t = 0; t < tapes.size(); ++t) {
+    putU64(out, static_cast<uint64_t>(static_cast<int64_t>(heads[t])));
+    putU64(out, tapes[t].size());
+    for (const auto& symbol : tapes[t]) out.push_back(symbol.getValue());
+  }
+  const std::string tmpPath = path + ".tmp";
+  int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) throw std::runtime_error("No se pudo crear la instantánea: " + tmpPath);
+  size_t written = 0;
+  while (written < out.size()) {
+    ssize_t n = ::write(fd, out.data() + written, out.size() - written);
+    if (n < 0) {
+      ::close(fd);
+      throw std::runtime_error("Error escribiendo la instantánea: " + tmpPath);
+    }
+    written += n;
+  }
+  if (::fsync(fd) != 0) {
+    ::close(fd);
+    ::unlink(tmpPath.c_str());
+    throw std::runtime_error("Error volcando la instantánea a disco: " + tmpPath);
+  }
+  ::close(fd);
+  if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+    throw std::runtime_error("No se pudo renombrar la instantánea a: " + path);
+  }
+  const std::string directory = parentDirectory(path);
+  int dirFd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+  if (dirFd < 0) throw std::runtime_error("No se pudo abrir el directorio de la instantánea: " + directory);
+  int synced = ::fsync(dirFd);
+  ::close(dirFd);
+  if (synced != 0) throw std::runtime_error("Error volcando a disco el directorio de la instantánea: " + directory);
+}
+
+/**
+ * @brief Carga una instantánea guardada con save().
+ *
+ * El estado se recupera solo por su id; el simulador vuelve a resolverlo en
+ * el modelo para recuperar el flag de aceptación. Las cintas se comprueban
+ * contra la MT (la huella no basta si el fichero se ha editado a mano): tantas
+ * como cintas tiene la MT, ninguna vacía y cada cabezal dentro de la suya.
+ *
+ * @param path Ruta del fichero de instantánea.
+ * @param tapeCount Número de cintas de la MT con la que se va a reanudar.
+ * @return Instantánea leída.
+ * @throws std::runtime_error si el fichero no existe o no es una instantánea válida.
+ */
+Snapshot Snapshot::load(const std::string& path, int tapeCount) {
+  std::ifstream infile(path, std::ios::binary);
+  if (!infile.is_open()) {
+    throw std::runtime_error("No se pudo abrir la instantánea: " + path);
+  }
+  std::string data((std::istreambuf_iterator<char>(infile)), std::istreambuf_iterator<char>());
+  if (data.size() < sizeof(kMagic) || data.compare(0, sizeof(kMagic), kMagic, sizeof(kMagic)) != 0) {
+    throw std::runtime_error("El fichero no es una instantánea válida: " + path);
+  }
+  Reader reader(data, sizeof(kMagic), path);
+  Snapshot snapshot;
+  snapshot.fingerprint_ = reader.u64();
+  snapshot.inputIndex_ = reader.u64();
+  snapshot.resultOffset_ = reader.u64();
+  snapshot.input_ = reader.str();
+  snapshot.configuration_.setState(State(reader.str()));
+  snapshot.configuration_.setSteps(static_cast<long long>(reader.u64()));
+  uint64_t savedTapes = reader.u64();
+  if (savedTapes != static_cast<uint64_t>(tapeCount)) {
+    throw std::runtime_error("La instantánea " + path + " tiene " + std::to_string(savedTapes) +
+                             " cintas y la MT " + std::to_string(tapeCount));
+  }
+  auto& tapes = snapshot.configuration_.getTapes();
+  auto& heads = snapshot.configuration_.getHeads();
+  for (uint64_t t = 0; t < savedTapes; ++t) {
+    int64_t head = static_cast<int64_t>(reader.u64());
+    std::string cells = reader.str();
+    if (cells.empty() || head < 0 || static_cast<uint64_t>(head) >= cells.size()) {
+      throw std::runtime_error("Cinta " + std::to_string(t) + " vacía o con el cabezal fuera de ella en la instantánea: " +
+                               path);
+    }
+    heads.push_back(static_cast<int>(head));
+    tapes.push_back(std::vector<Symbol>(cells.begin(), cells.end()));
+  }
+  return snapshot;
+}
+
+/**
+ * @brief Comprueba que el estado y los símbolos de la instantánea existen en la MT.
+ *
+ * La huella solo garantiza que la MT es la misma, no que el resto del fichero
+ * sea coherente con ella. En una ejecución real las cintas solo pueden
+ * contener símbolos del alfabeto de cinta, de la cadena de entrada (que no se
+ * valida contra el alfabeto) o escritos por alguna transición u operación nativa.
+ *
+ * @param model MT con la que se va a reanudar.
+ * @throws std::runtime_error si el estado no existe o alguna celda tiene un símbolo que la MT no puede producir.
+ */
+void Snapshot::checkModel(const TuringMachineModel& model) const {
+  model.getStateById(configuration_.getState().getId());
+  std::set<char> symbols(input_.begin(), input_.end());
+  for (const Symbol& symbol : model.getTapeAlphabet().getSymbols()) symbols.insert(symbol.getValue());
+  for (const auto& transPair : model.getTransitions()) {
+    for (const auto& transition : transPair.second) {
+      for (const auto& action : transition.getTapeActions()) {
+        if (action.second.first.getValue() != Symbol::WILDCARD) symbols.insert(action.second.first.getValue());
+      }
+    }
+  }
+  for (const auto& builtinPair : model.getBuiltins()) {
+    if (builtinPair.second.getBuiltin().getKind() == Builtin::Kind::INCREMENT) symbols.insert('0');
+  }
+  const auto& tapes = configuration_.getTapes();
+  for (size_t t = 0; t < tapes.size(); ++t) {
+    for (const Symbol& symbol : tapes[t]) {
+      if (symbols.count(symbol.getValue()) == 0) {
+        throw std::runtime_error("La cinta " + std::to_string(t) + " de la instantánea tiene el símbolo '" +
+                                 std::string(1, symbol.getValue()) + "', que la MT no puede escribir");
+      }
+    }
+  }
+}
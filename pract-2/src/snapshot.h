@@ -0,0 +1,41 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstdint>
+#include <string>
+#include "configuration.h"
+#include "turing_machine_model.h"
+
+/**
+ * @brief Instantánea en disco de una ejecución suspendida.
+ *
+ * Además de la configuración de la MT guarda la posición dentro del lote de
+ * cadenas (índice de la cadena y tamaño de FileOut.txt en ese momento) y la
+ * huella del modelo, para poder reanudar en otra máquina y comprobar que se
+ * usa la misma MT. El formato es binario, little-endian y de tamaño fijo por
+ * campo, de forma que no depende de la arquitectura del host.
+ */
+class Snapshot {
+ public:
+  Snapshot() : fingerprint_(0), inputIndex_(0), resultOffset_(0) {}
+  Snapshot(uint64_t fingerprint, uint64_t inputIndex, uint64_t resultOffset,
+           const std::string& input, const Configuration& configuration)
+    : fingerprint_(fingerprint), inputIndex_(inputIndex), resultOffset_(resultOffset),
+      input_(input), configuration_(configuration) {}
+  uint64_t getFingerprint() const { return fingerprint_; }
+  uint64_t getInputIndex() const { return inputIndex_; }
+  uint64_t getResultOffset() const { return resultOffset_; }
+  const std::string& getInput() const { return input_; }
+  const Configuration& getConfiguration() const { return configuration_; }
+  void save(const std::string& path) const;
+  static Snapshot load(const std::string& path, int tapeCount);
+  void checkModel(const TuringMachineModel& model) const;
+ private:
+  uint64_t fingerprint_;
+  uint64_t inputIndex_;
+  uint64_t resultOffset_;
+  std::string input_;
+  Configuration configuration_;
+};
+
+#endif
@@ -6,17 +6,20 @@
 
 class State {
   public:
-  State() : initial_(false), accept_(false), id("") {}
-  State(const std::string& id) : initial_(false), accept_(false), id(id) {}
+  State() : initial_(false), accept_(false), dead_(false), id("") {}
+  State(const std::string& id) : initial_(false), accept_(false), dead_(false), id(id) {}
   const std::string& getId() const { return id; }
   void setAccept(bool accept) { accept_ = accept; }
   bool isAccept() const { return accept_; }
+  void setDead(bool dead) { dead_ = dead; }
+  bool isDead() const { return dead_; }
   friend std::ostream& operator<<(std::ostream& os, const State& state);
   bool operator==(const State& other) const { return id == other.id; }
-  void operator=(const State& other) { id = other.id; initial_ = other.initial_; accept_ = other.accept_; }
+  void operator=(const State& other) { id = other.id; initial_ = other.initial_; accept_ = other.accept_; dead_ = other.dead_; }
   private:
    bool initial_;
    bool accept_; 
+   bool dead_;
    std::string id = "";
 };
 
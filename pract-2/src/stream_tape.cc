@@ -0,0 +1,150 @@
+#include "stream_tape.h"
+#include <cerrno>
+#include <stdexcept>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Abre el origen de la cinta 0.
+ *
+ * Al empezar la cinta es un único blanco provisional: ni siquiera la primera
+ * celda se conoce hasta que llega algo o se acaba la entrada. Una FIFO se abre
+ * sin esperar a que aparezca quien escribe (la espera es la de fill()), para
+ * que el planificador pueda abrir varias a la vez.
+ *
+ * @param path Ruta del fichero o FIFO, o "-" para la entrada estándar.
+ * @param follow Si es true, el final de un fichero normal no es el fin de la entrada (tail -f).
+ * @param chunk Bytes que se piden en cada lectura.
+ * @throws std::runtime_error si no se puede abrir el origen.
+ */
+StreamTape::StreamTape(const std::string& path, bool follow, size_t chunk)
+  : path_(path), fd_(-1), ownsFd_(path != "-"), regular_(false), follow_(follow), pending_(true), ended_(false),
+    buffer_(chunk > 0 ? chunk : kChunk), received_(0), reads_(0), waits_(0) {
+  fd_ = ownsFd_ ? ::open(path.c_str(), O_RDONLY | O_NONBLOCK) : STDIN_FILENO;
+  if (fd_ < 0) throw std::runtime_error("No se pudo abrir la entrada de la cinta: " + path);
+  if (ownsFd_) ::fcntl(fd_, F_SETFL, ::fcntl(fd_, F_GETFL) & ~O_NONBLOCK);
+  struct stat info;
+  regular_ = ::fstat(fd_, &info) == 0 && S_ISREG(info.st_mode);
+}
+
+/**
+ * @brief Cierra el descriptor (salvo la entrada estándar).
+ */
+StreamTape::~StreamTape() {
+  if (ownsFd_ && fd_ >= 0) ::close(fd_);
+}
+
+/**
+ * @brief Comprueba con poll() si el descriptor tiene datos (o el fin) sin llegar a leer.
+ *
+ * @param timeoutMs Milisegundos de espera (-1 para esperar lo que haga falta, 0 para no esperar).
+ * @return true si una lectura no se bloquearía.
+ */
+bool StreamTape::readable(int timeoutMs) const {
+  struct pollfd request;
+  request.fd = fd_;
+  request.events = POLLIN;
+  request.revents = 0;
+  while (true) {
+    int ready = ::poll(&request, 1, timeoutMs);
+    if (ready >= 0) return ready > 0;
+    if (errno != EINTR) throw std::runtime_error("Error esperando la entrada de la cinta: " + path_);
+  }
+}
+
+/**
+ * @brief Sustituye el blanco provisional del final de la cinta por lo siguiente que llegue.
+ *
+ * Con block espera hasta que llega algo o se acaba la entrada; sin block,
+ * si no hay nada disponible devuelve WAIT sin tocar la cinta, para que la
+ * ejecución ceda el turno. Todo lo recibido en una lectura se añade a la vez.
+ *
+ * @param tape Cinta 0 de la simulación; su última celda es el blanco provisional.
+ * @param block Si es true, espera a que haya datos.
+ * @return DATA si la celda provisional ya tiene su símbolo, WAIT si todavía no ha
+ *         llegado nada, END si la entrada se acabó y la celda queda en blanco.
+ * @throws std::runtime_error si falla la lectura.
+ */
+StreamTape::Fill StreamTape::fill(std::vector<Symbol>& tape, bool block) {
+  if (!pending_) return ended_ ? Fill::END : Fill::DATA;
+  while (true) {
+    if (!regular_ && !readable(0)) {
+      ++waits_;
+      if (!block) return Fill::WAIT;
+      readable(-1);
+    }
+    ssize_t bytes = ::read(fd_, buffer_.data(), buffer_.size());
+    if (bytes < 0) {
+      if (errno == EINTR) continue;
+      throw std::runtime_error("Error leyendo la entrada de la cinta: " + path_);
+    }
+    ++reads_;
+    if (bytes == 0) {
+      if (regular_ && follow_) {
+        ++waits_;
+        if (!block) return Fill::WAIT;
+        ::usleep(kFollowPollMs * 1000);
+        continue;
+      }
+      ended_ = true;
+      pending_ = false;
+      return Fill::END;
+    }
+    for (ssize_t i = 0; i < bytes; ++i) {
+      char c = buffer_[i];
+      if (c == '\n' || c == '\r') continue;
+      if (pending_) {
+        tape.back() = Symbol(c);
+        pending_ = false;
+      } else {
+        tape.push_back(Symbol(c));
+      }
+      ++received_;
+    }
+    if (!pending_) return Fill::DATA;
+  }
+}
+
+/**
+ * @brief Espera hasta que alguna de las entradas tenga datos (o se acabe).
+ *
+ * La usa el planificador cuando todas las ejecuciones en vuelo están esperando
+ * entrada, en lugar de dar vueltas sin avanzar. Los ficheros seguidos con
+ * follow no se pueden esperar con poll(), así que con alguno de ellos la
+ * espera es como mucho de kFollowPollMs.
+ *
+ * @param tapes Entradas de las ejecuciones que esperan.
+ */
+void StreamTape::waitAny(const std::vector<const StreamTape*>& tapes) {
+  std::vector<struct pollfd> requests;
+  bool following = false;
+  for (const StreamTape* tape : tapes) {
+    if (tape->ended_) continue;
+    if (tape->regular_) {
+      following = following || tape->follow_;
+      continue;
+    }
+    struct pollfd request;
+    request.fd = tape->fd_;
+    request.events = POLLIN;
+    request.revents = 0;
+    requests.push_back(request);
+  }
+  if (requests.empty() && !following) return;
+  while (::poll(requests.data(), requests.size(), following ? kFollowPollMs : -1) < 0 && errno == EINTR) {}
+}
+
+/**
+ * @brief Muestra lo recibido por la entrada y cuántas veces hubo que esperarla.
+ *
+ * @param os Stream de salida.
+ * @param tape Entrada a mostrar.
+ * @return Referencia al stream de salida.
+ */
+std::ostream& operator<<(std::ostream& os, const StreamTape& tape) {
+  os << "Entrada " << tape.path_ << ": " << tape.received_ << " símbolos recibidos en " << tape.reads_
+     << " lecturas, " << tape.waits_ << " esperas" << (tape.ended_ ? ", fin de la entrada" : ", sin llegar al fin");
+  return os;
+}
@@ -0,0 +1,56 @@
+#ifndef STREAM_TAPE_H
+#define STREAM_TAPE_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "symbol.h"
+
+/**
+ * @brief Entrada de la cinta 0 que llega poco a poco por un descriptor de fichero (--stream-tape).
+ *
+ * La cinta 0 de la simulación solo contiene lo recibido hasta el momento. Cuando
+ * el cabezal 0 pasa del último símbolo recibido, el simulador deja en la cinta un
+ * blanco provisional (isPending()) y fill() lo sustituye por lo siguiente que
+ * llegue, o lo deja como blanco definitivo al llegar el fin de la entrada. Los
+ * saltos de línea (\n y \r) no forman parte de la cinta.
+ *
+ * El origen es un fichero, una FIFO o la entrada estándar ("-"). En una tubería
+ * el fin de la entrada es que se cierre el extremo de escritura; en un fichero
+ * normal es su final, salvo con follow, que lo sigue como tail -f (el fin no
+ * llega nunca y la MT tiene que decidir por su cuenta o agotar los pasos).
+ */
+class StreamTape {
+ public:
+  enum class Fill { DATA, WAIT, END };
+  static const size_t kChunk = 4096;
+  StreamTape(const std::string& path, bool follow, size_t chunk = kChunk);
+  ~StreamTape();
+  StreamTape(const StreamTape&) = delete;
+  StreamTape& operator=(const StreamTape&) = delete;
+  Fill fill(std::vector<Symbol>& tape, bool block);
+  bool isPending() const { return pending_; }
+  void setPending() { pending_ = !ended_; }
+  bool isEnded() const { return ended_; }
+  uint64_t getReceived() const { return received_; }
+  const std::string& getPath() const { return path_; }
+  static void waitAny(const std::vector<const StreamTape*>& tapes);
+  friend std::ostream& operator<<(std::ostream& os, const StreamTape& tape);
+ private:
+  static const int kFollowPollMs = 20;
+  bool readable(int timeoutMs) const;
+  std::string path_;
+  int fd_;
+  bool ownsFd_;
+  bool regular_;
+  bool follow_;
+  bool pending_;
+  bool ended_;
+  std::vector<char> buffer_;
+  uint64_t received_;
+  uint64_t reads_;
+  uint64_t waits_;
+};
+
+#endif
@@ -15,3 +15,6 @@ std::ostream& operator<<(std::ostream& os, const Symbol& symbol) {
 	return os;
 }
 #include "symbol.h"
+
+// Definición del miembro estático (necesaria si se usa por referencia).
+const char Symbol::WILDCARD;
@@ -5,6 +5,8 @@
 
 class Symbol {
   public:
+  // Comodín: en lectura coincide con cualquier símbolo; en escritura deja la celda como está.
+  static const char WILDCARD = '*';
   Symbol(char value) : value(value) {}
   Symbol(const Symbol& sym) : value(sym.getValue()) {}
   char getValue() const { return value; }
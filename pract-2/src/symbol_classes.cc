@@ -0,0 +1,23 @@
+#include "symbol_classes.h"
+
+/**
+ * @brief Calcula las clases de cada cinta a partir de los símbolos que leen las transiciones.
+ * 
+ * Las transiciones con un número de símbolos de lectura distinto al de cintas
+ * se ignoran (el TransitionMatcher tampoco las inserta), igual que el comodín.
+ * 
+ * @param transitions Transiciones que parten del estado.
+ * @param tapeCount Número de cintas de la máquina.
+ */
+SymbolClasses::SymbolClasses(const std::vector<Transition>& transitions, int tapeCount)
+  : map_(tapeCount * kSymbols, 0), counts_(tapeCount, 1) {
+  for (const Transition& transition : transitions) {
+    const std::vector<Symbol>& read = transition.getReadSymbols();
+    if ((int)read.size() != tapeCount) continue;
+    for (int t = 0; t < tapeCount; ++t) {
+      char symbol = read[t].getValue();
+      uint8_t& symbolClass = map_[t * kSymbols + static_cast<uint8_t>(symbol)];
+      if (symbol != Symbol::WILDCARD && symbolClass == 0) symbolClass = counts_[t]++;
+    }
+  }
+}
@@ -0,0 +1,33 @@
+#ifndef SYMBOL_CLASSES_H
+#define SYMBOL_CLASSES_H
+
+#include <cstdint>
+#include <vector>
+#include "transition.h"
+
+/**
+ * @brief Clases de equivalencia de símbolos por cinta para las transiciones de un estado.
+ *
+ * Dos símbolos son equivalentes en la cinta t si ninguna transición del estado
+ * los distingue al leer esa cinta, igual que las clases de bytes de los
+ * autómatas de expresiones regulares. Cada símbolo que alguna transición lee
+ * en la cinta t es su propia clase (1, 2, ... por orden de aparición) y todos
+ * los demás caen en la clase 0, con la que solo puede coincidir el comodín.
+ * La consulta es un acceso a un mapa de 256 entradas por cinta, así que las
+ * tablas que se indexan por clase tienen el tamaño de lo que el estado
+ * distingue, no el del alfabeto de cinta.
+ */
+class SymbolClasses {
+ public:
+  static const int kSymbols = 256;
+  SymbolClasses() {}
+  SymbolClasses(const std::vector<Transition>& transitions, int tapeCount);
+  uint8_t classOf(int tape, char symbol) const { return map_[tape * kSymbols + static_cast<uint8_t>(symbol)]; }
+  int getClassCount(int tape) const { return counts_[tape]; }
+  bool operator<(const SymbolClasses& other) const { return map_ < other.map_; }
+ private:
+  std::vector<uint8_t> map_;
+  std::vector<int> counts_;
+};
+
+#endif
@@ -0,0 +1,176 @@
+#include "tm_api.h"
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "batch_runner.h"
+
+/**
+ * @brief MT cargada a través de la API C: el BatchRunner con su motor y los buffers de salida.
+ */
+struct tm_machine {
+  explicit tm_machine(const BatchOptions& options) : runner(options) {}
+  BatchRunner runner;
+  std::vector<std::string> outputs;
+};
+
+namespace {
+
+thread_local std::string lastError;
+
+int fail(const std::string& message) {
+  lastError = message;
+  return -1;
+}
+
+/**
+ * @brief Motor que corresponde a las opciones de carga TM_LOAD_*.
+ */
+BatchOptions optionsFor(unsigned flags) {
+  BatchOptions options;
+  options.optimize = (flags & TM_LOAD_OPTIMIZE) != 0;
+  options.compact = (flags & TM_LOAD_COMPACT) != 0;
+  options.lazyLoad = (flags & TM_LOAD_LAZY) != 0;
+  options.fuseChains = (flags & TM_LOAD_FUSE_CHAINS) != 0;
+  if (options.compact) options.transitionsOnly = "TM_LOAD_COMPACT";
+  if (options.lazyLoad && (options.optimize || options.compact || options.fuseChains)) {
+    throw std::runtime_error("TM_LOAD_LAZY no admite TM_LOAD_OPTIMIZE, TM_LOAD_COMPACT ni TM_LOAD_FUSE_CHAINS");
+  }
+  if (options.compact && options.fuseChains) {
+    throw std::runtime_error("TM_LOAD_COMPACT no admite TM_LOAD_FUSE_CHAINS");
+  }
+  return options;
+}
+
+/**
+ * @brief Simula una cadena y deja la proyección de sus cintas en output.
+ */
+void simulate(tm_machine& machine, const char* input, size_t size, tm_result& result, std::string& output) {
+  std::vector<Symbol> symbols;
+  symbols.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    if (input[i] != ' ' && input[i] != '\n' && input[i] != '\r') symbols.push_back(Symbol(input[i]));
+  }
+  long long steps = 0;
+  output.clear();
+  RunStatus status = machine.runner.simulate(symbols, steps, output);
+  result.status = status == RunStatus::ACCEPTED ? TM_ACCEPTED
+                : status == RunStatus::STEP_LIMIT ? TM_STEP_LIMIT : TM_REJECTED;
+  result.steps = steps;
+}
+
+}  // namespace
+
+extern "C" {
+
+/**
+ * @brief Versión de la API C (TM_API_VERSION con la que se compiló la biblioteca).
+ */
+int tm_api_version(void) {
+  return TM_API_VERSION;
+}
+
+/**
+ * @brief Mensaje del último error ocurrido en el hilo llamante.
+ */
+const char* tm_last_error(void) {
+  return lastError.c_str();
+}
+
+/**
+ * @brief Carga una MT desde un fichero con el motor que eligen las opciones TM_LOAD_*.
+ *
+ * @return La MT cargada, o NULL si el fichero no existe, no es válido o las opciones no son compatibles.
+ */
+tm_machine* tm_load_file(const char* path, unsigned flags) {
+  try {
+    std::unique_ptr<tm_machine> machine(new tm_machine(optionsFor(flags)));
+    machine->runner.loadFile(path);
+    return machine.release();
+  } catch (const std::exception& error) {
+    fail(error.what());
+    return nullptr;
+  }
+}
+
+/**
+ * @brief Carga una MT desde una definición en memoria, con el mismo formato que el fichero.
+ *
+ * @return La MT cargada, o NULL si la definición no es válida o se pidió TM_LOAD_LAZY.
+ */
+tm_machine* tm_load_buffer(const char* text, size_t size, unsigned flags) {
+  try {
+    std::unique_ptr<tm_machine> machine(new tm_machine(optionsFor(flags)));
+    machine->runner.loadBuffer(std::string(text, size));
+    return machine.release();
+  } catch (const std::exception& error) {
+    fail(error.what());
+    return nullptr;
+  }
+}
+
+/**
+ * @brief Libera una MT cargada (y los resultados que apuntan a sus buffers).
+ */
+void tm_free(tm_machine* machine) {
+  delete machine;
+}
+
+/**
+ * @brief Número de cintas de la MT.
+ */
+int tm_tape_count(const tm_machine* machine) {
+  return machine->runner.getTapeCount();
+}
+
+/**
+ * @brief Elige qué cintas (y qué tramo) se devuelven en tm_result::output.
+ *
+ * @return 0, o -1 si alguna cinta está fuera de rango o el modo no es válido.
+ */
+int tm_set_output(tm_machine* machine, const int* tapes, size_t tape_count, const char* mode, int verdict_only) {
+  try {
+    std::vector<int> selected(tapes, tapes + tape_count);
+    for (int tape : selected) {
+      if (tape < 0 || tape >= tm_tape_count(machine)) {
+        return fail("Cinta fuera de rango: " + std::to_string(tape));
+      }
+    }
+    if (selected.empty()) selected.push_back(0);
+    machine->runner.setProjection(ResultProjection(selected, ResultProjection::parseMode(mode != nullptr ? mode : "full"),
+                                                   verdict_only != 0));
+    return 0;
+  } catch (const std::exception& error) {
+    return fail(error.what());
+  }
+}
+
+/**
+ * @brief Simula una cadena en memoria (los espacios y saltos de línea se ignoran).
+ */
+int tm_simulate(tm_machine* machine, const char* input, size_t size, long long max_steps, tm_result* result) {
+  return tm_simulate_batch(machine, &input, &size, 1, max_steps, result);
+}
+
+/**
+ * @brief Simula un lote de cadenas; results[i] corresponde a inputs[i].
+ *
+ * Las salidas de todo el lote siguen siendo válidas hasta la siguiente llamada.
+ */
+int tm_simulate_batch(tm_machine* machine, const char* const* inputs, const size_t* sizes, size_t count,
+                      long long max_steps, tm_result* results) {
+  try {
+    machine->runner.setMaxSteps(max_steps > 0 ? max_steps : TuringMachineSimulator::DEFAULT_MAX_STEPS);
+    machine->outputs.resize(count);
+    for (size_t i = 0; i < count; ++i) simulate(*machine, inputs[i], sizes[i], results[i], machine->outputs[i]);
+    for (size_t i = 0; i < count; ++i) {
+      results[i].output = machine->outputs[i].data();
+      results[i].output_size = machine->outputs[i].size();
+    }
+    return 0;
+  } catch (const std::exception& error) {
+    return fail(error.what());
+  }
+}
+
+}  // extern "C"
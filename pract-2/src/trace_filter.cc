@@ -0,0 +1,107 @@
+#include "trace_filter.h"
+#include <climits>
+#include <cstdlib>
+#include <fnmatch.h>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * @brief Divide una lista separada por comas, ignorando elementos vacíos.
+ */
+std::vector<std::string> splitList(const std::string& list) {
+  std::vector<std::string> items;
+  size_t start = 0;
+  while (start <= list.size()) {
+    size_t comma = list.find(',', start);
+    if (comma == std::string::npos) comma = list.size();
+    if (comma > start) items.push_back(list.substr(start, comma - start));
+    start = comma + 1;
+  }
+  return items;
+}
+
+/**
+ * @brief Convierte un número de paso, comprobando que sea un entero no negativo.
+ */
+long long parseStep(const std::string& text, const std::string& range) {
+  if (text.empty() || text.find_first_not_of("0123456789") != std::string::npos) {
+    throw std::invalid_argument("Rango de pasos no válido: " + range);
+  }
+  return std::atoll(text.c_str());
+}
+
+}  // namespace
+
+/**
+ * @brief Construye un filtro a partir de los valores de las opciones --trace-*.
+ * 
+ * @param steps Rangos de pasos separados por comas: "N", "N-M" o "N-" (hasta el final).
+ * @param states Estados separados por comas.
+ * @param writes Símbolos de escritura separados por comas.
+ * @param pattern Patrón de cadenas con comodines de shell ('*', '?', '[...]').
+ * @param sampleEvery Trazar solo los pasos múltiplos de este número (1 para todos).
+ * @return Filtro configurado (las opciones vacías no filtran).
+ * @throws std::invalid_argument si algún valor está mal formado.
+ */
+TraceFilter TraceFilter::parse(const std::string& steps, const std::string& states, const std::string& writes,
+                               const std::string& pattern, long long sampleEvery) {
+  TraceFilter filter;
+  for (const auto& range : splitList(steps)) {
+    size_t dash = range.find('-');
+    if (dash == std::string::npos) {
+      long long step = parseStep(range, range);
+      filter.addStepRange(step, step);
+    } else {
+      long long first = parseStep(range.substr(0, dash), range);
+      long long last = dash + 1 == range.size() ? LLONG_MAX : parseStep(range.substr(dash + 1), range);
+      if (last < first) throw std::invalid_argument("Rango de pasos no válido: " + range);
+      filter.addStepRange(first, last);
+    }
+  }
+  for (const auto& state : splitList(states)) filter.addState(state);
+  for (const auto& symbol : splitList(writes)) {
+    if (symbol.size() != 1) throw std::invalid_argument("Símbolo de escritura no válido: " + symbol);
+    filter.addWriteSymbol(symbol[0]);
+  }
+  filter.setStringPattern(pattern);
+  if (sampleEvery < 1) throw std::invalid_argument("--trace-sample debe ser un número positivo");
+  filter.setSampleEvery(sampleEvery);
+  return filter;
+}
+
+/**
+ * @brief Indica si se debe trazar una cadena del lote.
+ * 
+ * @param input Cadena de entrada tal como aparece en el fichero.
+ * @return true si no hay patrón o la cadena lo cumple.
+ */
+bool TraceFilter::matchesString(const std::string& input) const {
+  return stringPattern_.empty() || fnmatch(stringPattern_.c_str(), input.c_str(), 0) == 0;
+}
+
+/**
+ * @brief Indica si un paso cae en alguno de los rangos.
+ * 
+ * @param step Número de paso.
+ * @return true si está dentro de algún rango.
+ */
+bool TraceFilter::inStepRanges(long long step) const {
+  for (const auto& range : stepRanges_) {
+    if (step >= range.first && step <= range.second) return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Indica si la transición escribe alguno de los símbolos filtrados.
+ * 
+ * @param transition Transición aplicada en el paso.
+ * @return true si alguna cinta escribe un símbolo filtrado.
+ */
+bool TraceFilter::writesFiltered(const Transition& transition) const {
+  for (const auto& action : transition.getTapeActions()) {
+    if (writeSymbols_.test(static_cast<unsigned char>(action.second.first.getValue()))) return true;
+  }
+  return false;
+}
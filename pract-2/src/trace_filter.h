@@ -0,0 +1,54 @@
+#ifndef TRACE_FILTER_H
+#define TRACE_FILTER_H
+
+#include <bitset>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "state.h"
+#include "transition.h"
+
+/**
+ * @brief Filtro de la traza de ejecución (--trace-*).
+ *
+ * Decide qué cadenas se trazan (patrón con comodines de shell, evaluado una
+ * sola vez por cadena) y, dentro de ellas, qué pasos se imprimen: rangos de
+ * pasos, estados concretos, transiciones que escriben ciertos símbolos y un
+ * muestreo de 1 de cada N pasos. Todos los criterios dados deben cumplirse.
+ * Las comprobaciones van de la más barata (comparar enteros) a la más cara
+ * (buscar el estado), así que un paso descartado cuesta muy poco.
+ */
+class TraceFilter {
+ public:
+  TraceFilter() : sampleEvery_(1), stepFilter_(false) {}
+  void addStepRange(long long first, long long last) {
+    stepRanges_.push_back(std::make_pair(first, last));
+    stepFilter_ = true;
+  }
+  void addState(const std::string& state) { states_.insert(state); stepFilter_ = true; }
+  void addWriteSymbol(char symbol) { writeSymbols_.set(static_cast<unsigned char>(symbol)); stepFilter_ = true; }
+  void setStringPattern(const std::string& pattern) { stringPattern_ = pattern; }
+  void setSampleEvery(long long every) { sampleEvery_ = every; stepFilter_ = stepFilter_ || every > 1; }
+  bool matchesString(const std::string& input) const;
+  bool matchesStep(long long step, const State& state, const Transition& transition, bool found) const {
+    if (!stepFilter_) return true;
+    if (sampleEvery_ > 1 && step % sampleEvery_ != 0) return false;
+    if (!stepRanges_.empty() && !inStepRanges(step)) return false;
+    if (writeSymbols_.any() && !(found && writesFiltered(transition))) return false;
+    return states_.empty() || states_.count(state.getId()) > 0;
+  }
+  static TraceFilter parse(const std::string& steps, const std::string& states, const std::string& writes,
+                           const std::string& pattern, long long sampleEvery);
+ private:
+  bool inStepRanges(long long step) const;
+  bool writesFiltered(const Transition& transition) const;
+  std::vector<std::pair<long long, long long>> stepRanges_;
+  std::unordered_set<std::string> states_;
+  std::bitset<256> writeSymbols_;
+  std::string stringPattern_;
+  long long sampleEvery_;
+  bool stepFilter_;
+};
+
+#endif
@@ -28,7 +28,7 @@ void TracePrinter::printHeader(std::ostream& os) const {
  * @param heads Vector con las posiciones de los cabezales.
  * @param tapeCount Número total de cintas.
  */
-void TracePrinter::printStep(std::ostream& os, int step, 
+void TracePrinter::printStep(std::ostream& os, long long step, 
                              const State& currentState,
                              const std::vector<Symbol>& currentRead, 
                              const Transition& tr, bool foundTransition,
@@ -50,6 +50,11 @@ void TracePrinter::printStep(std::ostream& os, int step,
     os << "|  Transicion: " << std::setw(76) << std::left 
        << (currentState.getId() + " -> " + tr.getTo().getId()) << "|\n";
     os << "|  Acciones:";
+    if (tr.isBuiltin()) {
+      std::ostringstream builtinStr;
+      builtinStr << "    operacion nativa " << tr.getBuiltin();
+      os << std::setw(79) << std::left << builtinStr.str() << "|\n";
+    }
     for (int t = 0; t < tapeCount; ++t) {
       const auto& actions = tr.getTapeActions();
       auto it = actions.find(t);
@@ -20,7 +20,7 @@
 class TracePrinter {
  public:
   void printHeader(std::ostream& os) const;
-  void printStep(std::ostream& os, int step, 
+  void printStep(std::ostream& os, long long step, 
                 const State& currentState,
                 const std::vector<Symbol>& currentRead, 
                 const Transition& tr, bool foundTransition,
@@ -13,6 +13,16 @@ Transition::Transition(const State& from, const State& to, const std::vector<Sym
   : from(from), to(to), readSymbols(readSymbols), tapeActions(tapeActions) {
 }
 
+/**
+ * @brief Constructor de la operación nativa de un estado.
+ * 
+ * @param from Estado que invoca la operación (también es el destino).
+ * @param builtin Operación nativa.
+ */
+Transition::Transition(const State& from, const Builtin& builtin)
+  : from(from), to(from), builtin(std::make_shared<const Builtin>(builtin)) {
+}
+
 
 /**
  * @brief Operador de salida para imprimir una transición.
@@ -25,6 +35,10 @@ Transition::Transition(const State& from, const State& to, const std::vector<Sym
  * @return Referencia al stream de salida para permitir encadenamiento.
  */
 std::ostream& operator<<(std::ostream& os, const Transition& t){
+  if (t.isBuiltin()) {
+    os << "Transition(" << t.getFrom() << " -> " << t.getTo() << ", builtin: " << t.getBuiltin() << ")";
+    return os;
+  }
   os << "Transition(" << t.getFrom() << " -> " << t.getTo() 
      << ", read: [";
   const auto& readSyms = t.getReadSymbols();
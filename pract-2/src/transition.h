@@ -4,7 +4,9 @@
 #include "state.h"
 #include "symbol.h"
 #include "moves.h"
+#include "builtin.h"
 #include <map>
+#include <memory>
 #include <vector>
 
 /**
@@ -13,21 +15,28 @@
  * Estructura optimizada usando map para acciones por cinta:
  * - Lee símbolos de todas las cintas (readSymbols)
  * - Para cada cinta: escribe símbolo y mueve cabeza (tapeActions)
+ *
+ * Una transición también puede ser la operación nativa (Builtin) de un estado:
+ * va del estado a sí mismo y no tiene lecturas ni acciones propias.
  */
 class Transition {
   public:
     Transition(const State& from, const State& to, const std::vector<Symbol>& readSymbols,
                const std::map<int, std::pair<Symbol, Moves>>& tapeActions);
+    Transition(const State& from, const Builtin& builtin);
     const State& getFrom() const { return from; }
     const State& getTo() const { return to; }
     const std::vector<Symbol>& getReadSymbols() const { return readSymbols; }
     const std::map<int, std::pair<Symbol, Moves>>& getTapeActions() const { return tapeActions; }  
+    bool isBuiltin() const { return builtin != nullptr; }
+    const Builtin& getBuiltin() const { return *builtin; }
     friend std::ostream& operator<<(std::ostream& os, const Transition& t);   
   private:
     State from;
     State to;
     std::vector<Symbol> readSymbols;
     std::map<int, std::pair<Symbol, Moves>> tapeActions;
+    std::shared_ptr<const Builtin> builtin;
 };
 
 #endif
\ No newline at end of file
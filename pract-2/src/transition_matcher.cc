@@ -0,0 +1,125 @@
+#include "transition_matcher.h"
+
+/**
+ * @brief Compila las transiciones de un estado en el árbol de decisión.
+ * 
+ * Las transiciones cuyo número de símbolos de lectura no coincide con el
+ * número de cintas no se insertan; se recuerda la primera para que el
+ * simulador pueda informar del error al entrar en el estado.
+ * 
+ * @param transitions Transiciones que parten del estado, en orden de fichero.
+ * @param tapeCount Número de cintas de la máquina.
+ * @param classes Clases de símbolos del estado (calculadas con las mismas transiciones).
+ */
+TransitionMatcher::TransitionMatcher(const std::vector<Transition>& transitions, int tapeCount,
+                                     const std::shared_ptr<const SymbolClasses>& classes)
+  : classes_(classes), nodes_(1), malformed_(-1), tapeCount_(tapeCount) {
+  for (size_t i = 0; i < transitions.size(); ++i) {
+    const auto& readSyms = transitions[i].getReadSymbols();
+    if ((int)readSyms.size() != tapeCount_) {
+      if (malformed_ < 0) malformed_ = i;
+      continue;
+    }
+    int node = 0;
+    for (int t = 0; t < tapeCount_; ++t) node = childFor(node, t, readSyms[t].getValue(), true);
+    if (nodes_[node].transition < 0) nodes_[node].transition = i;
+  }
+  buildTables();
+}
+
+/**
+ * @brief Devuelve (creándolo si se pide) el hijo de un nodo para un símbolo.
+ * 
+ * @param node Índice del nodo padre.
+ * @param tape Cinta del nivel del nodo padre.
+ * @param symbol Símbolo de lectura (o Symbol::WILDCARD).
+ * @param create Si es true crea el hijo cuando no existe.
+ * @return Índice del hijo, o -1 si no existe y no se ha creado.
+ */
+int TransitionMatcher::childFor(int node, int tape, char symbol, bool create) {
+  if (symbol == Symbol::WILDCARD) {
+    if (nodes_[node].wildcard < 0 && create) {
+      nodes_.push_back(Node());
+      nodes_[node].wildcard = nodes_.size() - 1;
+    }
+    return nodes_[node].wildcard;
+  }
+  uint8_t symbolClass = classes_->classOf(tape, symbol);
+  for (const auto& child : nodes_[node].children) {
+    if (child.first == symbolClass) return child.second;
+  }
+  if (!create) return -1;
+  nodes_.push_back(Node());
+  int child = nodes_.size() - 1;
+  nodes_[node].children.push_back(std::make_pair(symbolClass, child));
+  return child;
+}
+
+/**
+ * @brief Pasa los hijos de cada nodo interno a tablas densas indexadas por clase, si caben.
+ * 
+ * Cada nodo del nivel t necesita getClassCount(t) celdas (la de la clase 0
+ * siempre vale -1). Si el total supera kMaxTableCells se mantienen las listas.
+ */
+void TransitionMatcher::buildTables() {
+  std::vector<int> depths(nodes_.size(), 0);
+  size_t cells = 0;
+  for (size_t node = 0; node < nodes_.size(); ++node) {
+    for (const auto& child : nodes_[node].children) depths[child.second] = depths[node] + 1;
+    if (nodes_[node].wildcard >= 0) depths[nodes_[node].wildcard] = depths[node] + 1;
+    if (depths[node] < tapeCount_) cells += classes_->getClassCount(depths[node]);
+  }
+  if (cells > kMaxTableCells) return;
+  table_.reserve(cells);
+  for (size_t node = 0; node < nodes_.size(); ++node) {
+    if (depths[node] == tapeCount_) continue;
+    nodes_[node].table = table_.size();
+    table_.resize(table_.size() + classes_->getClassCount(depths[node]), -1);
+    for (const auto& child : nodes_[node].children) table_[nodes_[node].table + child.first] = child.second;
+    std::vector<std::pair<uint8_t, int>>().swap(nodes_[node].children);
+  }
+}
+
+/**
+ * @brief Busca la transición más específica para los símbolos leídos.
+ * 
+ * @param read Símbolos bajo los cabezales, uno por cinta.
+ * @return Índice de la transición en el vector del estado, o -1 si no hay ninguna.
+ */
+int TransitionMatcher::match(const std::vector<Symbol>& read) const {
+  if (nodes_.empty()) return -1;
+  return matchFrom(0, 0, read);
+}
+
+/**
+ * @brief Búsqueda recursiva: primero el hijo de la clase del símbolo y, si falla, el comodín.
+ * 
+ * @param node Nodo actual.
+ * @param tape Cinta correspondiente al nivel del nodo.
+ * @param read Símbolos bajo los cabezales.
+ * @return Índice de la transición encontrada, o -1.
+ */
+int TransitionMatcher::matchFrom(int node, int tape, const std::vector<Symbol>& read) const {
+  const Node& current = nodes_[node];
+  if (tape == tapeCount_) return current.transition;
+  uint8_t symbolClass = classes_->classOf(tape, read[tape].getValue());
+  if (symbolClass != 0) {
+    int child = -1;
+    if (current.table >= 0) {
+      child = table_[current.table + symbolClass];
+    } else {
+      for (const auto& entry : current.children) {
+        if (entry.first == symbolClass) {
+          child = entry.second;
+          break;
+        }
+      }
+    }
+    if (child >= 0) {
+      int found = matchFrom(child, tape + 1, read);
+      if (found >= 0) return found;
+    }
+  }
+  if (current.wildcard >= 0) return matchFrom(current.wildcard, tape + 1, read);
+  return -1;
+}
@@ -0,0 +1,57 @@
+#ifndef TRANSITION_MATCHER_H
+#define TRANSITION_MATCHER_H
+
+#include <memory>
+#include <utility>
+#include <vector>
+#include "symbol.h"
+#include "symbol_classes.h"
+#include "transition.h"
+
+/**
+ * @brief Árbol de decisión (trie por cinta) con las transiciones de un estado.
+ *
+ * El nivel i del árbol corresponde al símbolo leído en la cinta i. Cada nodo
+ * tiene hijos por clase de símbolo (SymbolClasses: cada símbolo que el estado
+ * lee en esa cinta es una clase) y, opcionalmente, un hijo comodín
+ * (Symbol::WILDCARD) que acepta cualquier símbolo. La búsqueda traduce el
+ * símbolo a su clase con el mapa de 256 entradas y prueba primero el hijo
+ * concreto y después el comodín, por lo que gana la transición más específica
+ * (comparando cinta a cinta). Un símbolo que el estado no distingue (clase 0)
+ * va directo al comodín. Si dos transiciones tienen el mismo patrón de lectura
+ * se queda la primera del fichero, igual que la búsqueda lineal.
+ *
+ * Si caben en kMaxTableCells, los hijos de cada nodo se guardan en una tabla
+ * densa indexada por clase (un acceso por cinta); si no (estados con muchas
+ * combinaciones de símbolos en varias cintas), en una lista de pares (clase, hijo).
+ * Guarda índices en el vector de transiciones del estado (no punteros), para
+ * que el modelo pueda copiarse sin invalidar el árbol.
+ */
+class TransitionMatcher {
+ public:
+  static const size_t kMaxTableCells = 4096;
+  TransitionMatcher() : malformed_(-1), tapeCount_(0) {}
+  TransitionMatcher(const std::vector<Transition>& transitions, int tapeCount,
+                    const std::shared_ptr<const SymbolClasses>& classes);
+  int match(const std::vector<Symbol>& read) const;
+  int getMalformed() const { return malformed_; }
+  bool isDense() const { return !table_.empty(); }
+ private:
+  struct Node {
+    Node() : table(-1), wildcard(-1), transition(-1) {}
+    std::vector<std::pair<uint8_t, int>> children;
+    int table;
+    int wildcard;
+    int transition;
+  };
+  int childFor(int node, int tape, char symbol, bool create);
+  void buildTables();
+  int matchFrom(int node, int tape, const std::vector<Symbol>& read) const;
+  std::shared_ptr<const SymbolClasses> classes_;
+  std::vector<Node> nodes_;
+  std::vector<int> table_;
+  int malformed_;
+  int tapeCount_;
+};
+
+#endif
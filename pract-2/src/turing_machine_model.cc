@@ -1,5 +1,8 @@
 #include "turing_machine_model.h"
+#include <algorithm>
 #include <iostream>
+#include <memory>
+#include <sstream>
 #include <stdexcept>
 
 // Inicializar vector estático vacío para transiciones
@@ -9,8 +12,12 @@ const std::vector<Transition> TuringMachineModel::emptyTransitions_;
  * @brief Constructor que construye el modelo a partir de vectores.
  * 
  * Toma los vectores de estados y transiciones del parser y los convierte en estructuras
- * de datos optimizadas: un unordered_map para acceso O(1) a estados por id, y un map
- * que indexa las transiciones por estado origen para búsqueda eficiente.
+ * de datos optimizadas: un unordered_map para acceso O(1) a estados por id, un map
+ * que indexa las transiciones por estado origen y, por cada estado, un árbol de
+ * decisión (TransitionMatcher) que resuelve la transición aplicable sin recorrerlas todas.
+ * Las clases de símbolos de cada estado (SymbolClasses) se comparten entre los
+ * estados que distinguen los mismos símbolos en cada cinta. Las operaciones
+ * nativas se guardan aparte y cuentan para el número de cintas con las que usan.
  * 
  * @param states Vector de estados obtenidos del parser.
  * @param transitions Vector de transiciones obtenidas del parser.
@@ -25,10 +32,130 @@ TuringMachineModel::TuringMachineModel(std::vector<State> states, std::vector<Tr
     statesMap_[state.getId()] = state;
   }
   for (const auto& transition : transitions) {
+    if (transition.isBuiltin()) {
+      addBuiltin(transition);
+      tapeCount_ = std::max(tapeCount_, transition.getBuiltin().getMaxTape() + 1);
+      continue;
+    }
     transitionsMap_[transition.getFrom().getId()].push_back(transition);
+    for (const auto& actionPair : transition.getTapeActions()) {
+      tapeCount_ = std::max(tapeCount_, actionPair.first + 1);
+    }
+  }
+  ClassPool classPool;
+  for (const auto& transPair : transitionsMap_) addMatcher(transPair.first, transPair.second, classPool);
+}
+
+/**
+ * @brief Constructor del modo de carga perezosa (--lazy-load).
+ * 
+ * No carga ningún estado ni transición: el número de cintas lo da el índice y
+ * el resto se va cargando del fichero con loadState() al consultarlo.
+ * 
+ * @param lazyIndex Índice de las líneas de transición del fichero de la MT.
+ * @param stringAlphabet Alfabeto de entrada de la MT.
+ * @param tapeAlphabet Alfabeto de cinta de la MT.
+ * @param initialStateId Identificador del estado inicial.
+ */
+TuringMachineModel::TuringMachineModel(std::shared_ptr<const LazyTransitionIndex> lazyIndex, Alphabet stringAlphabet,
+                                       Alphabet tapeAlphabet, const std::string& initialStateId)
+  : lazyIndex_(lazyIndex), loaded_(lazyIndex->getStateCount(), false), tapeCount_(lazyIndex->getTapeCount()),
+    stringAlphabet_(stringAlphabet), tapeAlphabet_(tapeAlphabet), initialStateId_(initialStateId) {}
+
+/**
+ * @brief Guarda la operación nativa de un estado, restringida al alfabeto de cinta.
+ * 
+ * @param builtin Transición con la operación nativa.
+ * @throws std::runtime_error si el estado ya tiene otra.
+ */
+void TuringMachineModel::addBuiltin(const Transition& builtin) const {
+  const std::string& stateId = builtin.getFrom().getId();
+  Transition restricted(builtin.getFrom(), builtin.getBuiltin().restrictedTo(tapeAlphabet_));
+  if (!builtinsMap_.insert(std::make_pair(stateId, restricted)).second) {
+    throw std::runtime_error("Error: El estado '" + stateId + "' tiene más de una operación nativa");
+  }
+}
+
+/**
+ * @brief Construye el árbol de decisión de un estado, compartiendo sus clases de símbolos.
+ * 
+ * @param stateId Identificador del estado origen.
+ * @param transitions Transiciones del estado (ya guardadas en transitionsMap_).
+ * @param classPool Clases de símbolos ya creadas, para reutilizarlas entre estados.
+ */
+void TuringMachineModel::addMatcher(const std::string& stateId, const std::vector<Transition>& transitions,
+                                    ClassPool& classPool) const {
+  SymbolClasses classes(transitions, tapeCount_);
+  std::shared_ptr<const SymbolClasses>& shared = classPool[classes];
+  if (!shared) shared = std::make_shared<const SymbolClasses>(classes);
+  matchers_[stateId] = TransitionMatcher(transitions, tapeCount_, shared);
+}
+
+/**
+ * @brief Carga del fichero las transiciones de un estado si todavía no se han cargado.
+ * 
+ * La operación nativa del estado, si la tiene, se carga a la vez.
+ * 
+ * @param stateId Identificador del estado origen.
+ * @return true si el estado tiene transiciones (sin contar la operación nativa) y se acaban de cargar.
+ */
+bool TuringMachineModel::loadState(const std::string& stateId) const {
+  int state = lazyIndex_->find(stateId);
+  if (state < 0 || loaded_[state]) return false;
+  loaded_[state] = true;
+  std::vector<Transition> transitions = lazyIndex_->load(state);
+  auto builtins = std::stable_partition(transitions.begin(), transitions.end(),
+                                        [](const Transition& transition) { return !transition.isBuiltin(); });
+  for (auto it = builtins; it != transitions.end(); ++it) addBuiltin(*it);
+  transitions.erase(builtins, transitions.end());
+  if (transitions.empty()) return false;
+  std::vector<Transition>& stored = transitionsMap_[stateId];
+  stored.swap(transitions);
+  addMatcher(stateId, stored, classPool_);
+  return true;
+}
+
+/**
+ * @brief Carga todos los estados declarados y todas las transiciones que falten.
+ */
+void TuringMachineModel::loadAll() const {
+  for (int state = 0; state < lazyIndex_->getStateCount(); ++state) {
+    const std::string& id = lazyIndex_->getName(state);
+    if (lazyIndex_->isDeclared(state)) getStateById(id);
+    loadState(id);
   }
 }
 
+/**
+ * @brief Obtiene todos los estados de la máquina, indexados por id.
+ * 
+ * @return Map de estados (en modo perezoso, tras cargarlos todos).
+ */
+const std::unordered_map<std::string, State>& TuringMachineModel::getStates() const {
+  if (lazyIndex_) loadAll();
+  return statesMap_;
+}
+
+/**
+ * @brief Obtiene todas las transiciones de la máquina, agrupadas por estado origen.
+ * 
+ * @return Map de transiciones (en modo perezoso, tras cargarlas todas).
+ */
+const std::map<std::string, std::vector<Transition>>& TuringMachineModel::getTransitions() const {
+  if (lazyIndex_) loadAll();
+  return transitionsMap_;
+}
+
+/**
+ * @brief Obtiene las operaciones nativas de la máquina, indexadas por estado.
+ * 
+ * @return Map de estado -> operación nativa (en modo perezoso, tras cargarlas todas).
+ */
+const std::map<std::string, Transition>& TuringMachineModel::getBuiltins() const {
+  if (lazyIndex_) loadAll();
+  return builtinsMap_;
+}
+
 /**
  * @brief Obtiene el estado inicial de la máquina.
  * 
@@ -42,6 +169,8 @@ const State& TuringMachineModel::getInitialState() const {
 /**
  * @brief Busca un estado por su identificador.
  * 
+ * En modo perezoso, un estado declarado en la cabecera se crea la primera vez que se busca.
+ * 
  * @param id Identificador del estado.
  * @return Referencia al estado.
  * @throws std::runtime_error si el estado no existe.
@@ -51,6 +180,13 @@ const State& TuringMachineModel::getStateById(const std::string& id) const {
   if (it != statesMap_.end()) {
     return it->second;
   }
+  int state = lazyIndex_ ? lazyIndex_->find(id) : -1;
+  if (state >= 0 && lazyIndex_->isDeclared(state)) {
+    State& loaded = statesMap_[id];
+    loaded = State(id);
+    loaded.setAccept(lazyIndex_->isAccept(state));
+    return loaded;
+  }
   throw std::runtime_error("Estado no encontrado: " + id);
 }
 
@@ -62,6 +198,7 @@ const State& TuringMachineModel::getStateById(const std::string& id) const {
  */
 const std::vector<Transition>& TuringMachineModel::getTransitionsFrom(const std::string& stateId) const {
   auto it = transitionsMap_.find(stateId);
+  if (it == transitionsMap_.end() && lazyIndex_ && loadState(stateId)) it = transitionsMap_.find(stateId);
   if (it != transitionsMap_.end()) {
     return it->second;
   }
@@ -69,24 +206,83 @@ const std::vector<Transition>& TuringMachineModel::getTransitionsFrom(const std:
 }
 
 /**
- * @brief Determina el número de cintas necesarias según las transiciones.
+ * @brief Obtiene la operación nativa de un estado.
  * 
- * Analiza todas las transiciones y toma el número de cinta más alto usado
- * en las acciones (tapeActions) para determinar cuántas cintas necesita la máquina.
+ * @param stateId Identificador del estado.
+ * @return Transición con la operación nativa, o nullptr si el estado no tiene.
+ */
+const Transition* TuringMachineModel::getBuiltinFrom(const std::string& stateId) const {
+  if (lazyIndex_) loadState(stateId);
+  auto it = builtinsMap_.find(stateId);
+  return it != builtinsMap_.end() ? &it->second : nullptr;
+}
+
+/**
+ * @brief Busca la transición aplicable desde un estado para los símbolos leídos.
  * 
- * @return Número de cintas que debe usar la simulación.
+ * Si el estado tiene una operación nativa y se cumple su condición, es esa.
+ * Si no, usa el árbol de decisión del estado: se prueba antes el símbolo concreto que
+ * el comodín en cada cinta, de modo que gana la transición más específica.
+ * En modo perezoso, la primera consulta de un estado carga sus transiciones.
+ * 
+ * @param stateId Identificador del estado actual.
+ * @param read Símbolos bajo los cabezales, uno por cinta.
+ * @return Puntero a la transición aplicable, o nullptr si no hay ninguna.
+ * @throws std::runtime_error si el estado tiene transiciones con un número de
+ *         símbolos de lectura distinto al número de cintas.
  */
-int TuringMachineModel::determineTapeCount() const {
-  int tapeCount = 1;
-  for (const auto& statePair : transitionsMap_) {
-    for (const auto& transition : statePair.second) {
-      const auto& actions = transition.getTapeActions();
-      for (const auto& actionPair : actions) {
-        tapeCount = std::max(tapeCount, actionPair.first + 1);
-      }
-    }
+const Transition* TuringMachineModel::findTransition(const std::string& stateId, const std::vector<Symbol>& read) const {
+  auto it = matchers_.find(stateId);
+  if (it == matchers_.end() && lazyIndex_ && loadState(stateId)) it = matchers_.find(stateId);
+  if (!builtinsMap_.empty()) {
+    auto builtin = builtinsMap_.find(stateId);
+    if (builtin != builtinsMap_.end() && builtin->second.getBuiltin().holds(read)) return &builtin->second;
+  }
+  if (it == matchers_.end()) return nullptr;
+  const std::vector<Transition>& transitions = transitionsMap_.find(stateId)->second;
+  if (it->second.getMalformed() >= 0) {
+    const Transition& bad = transitions[it->second.getMalformed()];
+    throw std::runtime_error(
+      "Error: La transición desde el estado '" + stateId +
+      "' tiene " + std::to_string(bad.getReadSymbols().size()) + " símbolos de lectura, " +
+      "pero la máquina tiene " + std::to_string(tapeCount_) + " cintas"
+    );
+  }
+  int index = it->second.match(read);
+  return index >= 0 ? &transitions[index] : nullptr;
+}
+
+/**
+ * @brief Calcula una huella (FNV-1a de 64 bits) de la definición de la máquina.
+ * 
+ * Se calcula sobre una representación canónica (estado inicial, estados de
+ * aceptación ordenados y transiciones en el orden del map), de forma que no
+ * depende del orden de iteración del unordered_map de estados. Se usa para
+ * comprobar que una instantánea se reanuda con la misma MT que la generó.
+ * 
+ * @return Huella de 64 bits del modelo.
+ */
+uint64_t TuringMachineModel::fingerprint() const {
+  if (lazyIndex_) loadAll();
+  std::ostringstream canonical;
+  canonical << initialStateId_ << "\n";
+  std::vector<std::string> acceptIds;
+  for (const auto& statePair : statesMap_) {
+    if (statePair.second.isAccept()) acceptIds.push_back(statePair.first);
+  }
+  std::sort(acceptIds.begin(), acceptIds.end());
+  for (const auto& id : acceptIds) canonical << id << " ";
+  canonical << "\n";
+  for (const auto& transPair : transitionsMap_) {
+    for (const auto& transition : transPair.second) canonical << transition << "\n";
+  }
+  for (const auto& builtinPair : builtinsMap_) canonical << builtinPair.second << "\n";
+  uint64_t hash = 1469598103934665603ULL;
+  for (char c : canonical.str()) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
   }
-  return tapeCount;
+  return hash;
 }
 
 /**
@@ -100,11 +296,13 @@ int TuringMachineModel::determineTapeCount() const {
  * @return Referencia al stream de salida para permitir encadenamiento.
  */
 std::ostream& operator<<(std::ostream& os, const TuringMachineModel& model) {
+  if (model.lazyIndex_) model.loadAll();
   os << "States:\n";
   for (const auto& statePair : model.statesMap_) {
     const State& state = statePair.second;
     os << state;
     if (state.isAccept()) os << " (accept)";
+    if (state.isDead()) os << " (dead)";
     os << std::endl;
   }
   os << "String Alphabet: " << model.stringAlphabet_ << std::endl;
@@ -115,5 +313,6 @@ std::ostream& operator<<(std::ostream& os, const TuringMachineModel& model) {
       os << transition << std::endl;
     }
   }
+  for (const auto& builtinPair : model.builtinsMap_) os << builtinPair.second << std::endl;
   return os;
 }
@@ -1,12 +1,16 @@
 #ifndef TURING_MACHINE_MODEL_H
 #define TURING_MACHINE_MODEL_H
 
+#include <cstdint>
 #include <vector>
 #include <unordered_map>
 #include <map>
+#include <memory>
 #include "alphabet.h"
+#include "lazy_transition_index.h"
 #include "state.h"
 #include "transition.h"
+#include "transition_matcher.h"
 
 /**
  * @brief Modelo de una Máquina de Turing multicinta.
@@ -14,24 +18,52 @@
  * Representa la definición formal de una MT: conjunto de estados, transiciones
  * y alfabetos. Se encarga únicamente de almacenar y proporcionar acceso a la
  * estructura de la máquina, sin responsabilidad sobre la simulación.
+ *
+ * Con un LazyTransitionIndex (--lazy-load) el modelo empieza vacío y cada estado
+ * y sus transiciones se cargan del fichero la primera vez que se consultan; las
+ * consultas de la máquina entera (getStates, getTransitions, fingerprint, <<)
+ * cargan antes todo lo que falte. En ese modo las consultas no son seguras entre hilos.
+ *
+ * Las operaciones nativas (Builtin) se guardan aparte, una como mucho por estado:
+ * no aparecen en getTransitions() ni en getTransitionsFrom(), pero findTransition()
+ * devuelve la del estado antes que cualquier otra transición mientras se cumple su condición.
  */
 class TuringMachineModel {
  public:
   TuringMachineModel() = default;
   TuringMachineModel(std::vector<State> states, std::vector<Transition> transitions, 
                      Alphabet stringAlphabet, Alphabet tapeAlphabet, const std::string& initialStateId);
-  const std::unordered_map<std::string, State>& getStates() const { return statesMap_; }
-  const std::map<std::string, std::vector<Transition>>& getTransitions() const { return transitionsMap_; }
+  TuringMachineModel(std::shared_ptr<const LazyTransitionIndex> lazyIndex, Alphabet stringAlphabet,
+                     Alphabet tapeAlphabet, const std::string& initialStateId);
+  const std::unordered_map<std::string, State>& getStates() const;
+  const std::map<std::string, std::vector<Transition>>& getTransitions() const;
+  const std::map<std::string, Transition>& getBuiltins() const;
   const Alphabet& getStringAlphabet() const { return stringAlphabet_; }
   const Alphabet& getTapeAlphabet() const { return tapeAlphabet_; }
+  const std::string& getInitialStateId() const { return initialStateId_; }
   const State& getInitialState() const;
   const State& getStateById(const std::string& id) const;
   const std::vector<Transition>& getTransitionsFrom(const std::string& stateId) const;
-  int determineTapeCount() const;
+  const Transition* getBuiltinFrom(const std::string& stateId) const;
+  const Transition* findTransition(const std::string& stateId, const std::vector<Symbol>& read) const;
+  int determineTapeCount() const { return tapeCount_; }
+  uint64_t fingerprint() const;
+  const LazyTransitionIndex* getLazyIndex() const { return lazyIndex_.get(); }
   friend std::ostream& operator<<(std::ostream& os, const TuringMachineModel& model);
  private:
-  std::unordered_map<std::string, State> statesMap_;
-  std::map<std::string, std::vector<Transition>> transitionsMap_;
+  typedef std::map<SymbolClasses, std::shared_ptr<const SymbolClasses>> ClassPool;
+  void addBuiltin(const Transition& builtin) const;
+  void addMatcher(const std::string& stateId, const std::vector<Transition>& transitions, ClassPool& classPool) const;
+  bool loadState(const std::string& stateId) const;
+  void loadAll() const;
+  mutable std::unordered_map<std::string, State> statesMap_;
+  mutable std::map<std::string, std::vector<Transition>> transitionsMap_;
+  mutable std::unordered_map<std::string, TransitionMatcher> matchers_;
+  mutable std::map<std::string, Transition> builtinsMap_;
+  std::shared_ptr<const LazyTransitionIndex> lazyIndex_;
+  mutable std::vector<bool> loaded_;
+  mutable ClassPool classPool_;
+  int tapeCount_ = 1;
   Alphabet stringAlphabet_;
   Alphabet tapeAlphabet_;
   std::string initialStateId_;
@@ -1,4 +1,7 @@
 #include "turing_machine_simulator.h"
+#include <algorithm>
+#include <limits>
+#include <sstream>
 #include <stdexcept>
 
 // Inicializar transición estática vacía
@@ -12,7 +15,8 @@ const Transition TuringMachineSimulator::emptyTransition_(
  * @param model Referencia al modelo de la MT que se va a simular.
  */
 TuringMachineSimulator::TuringMachineSimulator(const TuringMachineModel& model)
-  : model_(model) {
+  : model_(model), maxSteps_(DEFAULT_MAX_STEPS), checkpointer_(nullptr), traceFilter_(nullptr),
+    fusion_(nullptr) {
 }
 
 /**
@@ -29,45 +33,278 @@ TuringMachineSimulator::TuringMachineSimulator(const TuringMachineModel& model)
  * @return true si la cadena es aceptada, false en caso contrario.
  */
 bool TuringMachineSimulator::compute(String& input, bool trace, std::ostream& os) const {
-  int tapeCount = model_.determineTapeCount();
-  std::vector<std::vector<Symbol>> tapes;
-  std::vector<int> heads;
-  initializeTapes(input, tapeCount, tapes, heads);
-  State currentState;
+  Configuration configuration = start(input);
+  RunStatus status = run(configuration, trace, os);
+  flattenResult(input, configuration.getTapes());
+  return status == RunStatus::ACCEPTED;
+}
+
+/**
+ * @brief Construye la configuración inicial de la MT para una cadena de entrada.
+ * 
+ * @param input Cadena de entrada que se coloca en la cinta 0.
+ * @return Configuración con el estado inicial, las cintas inicializadas y 0 pasos.
+ * @throws std::runtime_error si el estado inicial no existe en el modelo.
+ */
+Configuration TuringMachineSimulator::start(const String& input) const {
+  Configuration configuration;
+  initializeTapes(input.getSymbols(), model_.determineTapeCount(), configuration.getTapes(), configuration.getHeads());
   try {
-    currentState = model_.getInitialState();
+    configuration.setState(model_.getInitialState());
   } catch (const std::exception& e) {
     throw std::runtime_error("No se pudo obtener el estado inicial de la máquina: " + std::string(e.what()));
   }
-  bool accepted = false;
-  int steps = 0;
-  const int MAX_STEPS = 50;
-  if (trace) tracePrinter_.printHeader(os);
+  return configuration;
+}
+
+/**
+ * @brief Prepara la configuración de un RunContext para la entrada que tiene cargada.
+ * 
+ * Equivale a start(String) pero reinicia la configuración del contexto en su
+ * sitio: las cintas se vacían y se rellenan conservando su capacidad, así que
+ * en un lote no se reserva memoria nueva por cadena.
+ * 
+ * @param context Contexto con la entrada ya cargada (RunContext::load()).
+ * @throws std::runtime_error si el estado inicial no existe en el modelo.
+ */
+void TuringMachineSimulator::start(RunContext& context) const {
+  Configuration& configuration = context.getConfiguration();
+  initializeTapes(context.getInput(), model_.determineTapeCount(), configuration.getTapes(), configuration.getHeads());
+  configuration.setSteps(0);
+  try {
+    configuration.setState(model_.getInitialState());
+  } catch (const std::exception& e) {
+    throw std::runtime_error("No se pudo obtener el estado inicial de la máquina: " + std::string(e.what()));
+  }
+}
+
+/**
+ * @brief Construye la configuración inicial tomando posesión de una cinta ya existente.
+ * 
+ * La cinta (p. ej. la cinta 0 final de otra MT) pasa a ser la cinta 0 sin copiarse
+ * ni volver a parsearse; el resto de cintas empiezan en blanco.
+ * 
+ * @param tape0 Contenido de la cinta 0 (se mueve a la configuración).
+ * @return Configuración con el estado inicial, las cintas inicializadas y 0 pasos.
+ * @throws std::runtime_error si el estado inicial no existe en el modelo.
+ */
+Configuration TuringMachineSimulator::start(std::vector<Symbol>&& tape0) const {
+  Configuration configuration = start(String(std::vector<Symbol>()));
+  if (!tape0.empty()) configuration.getTapes()[0].swap(tape0);
+  return configuration;
+}
+
+/**
+ * @brief Ejecuta la MT desde una configuración hasta que se detiene.
+ * 
+ * Sirve tanto para ejecuciones nuevas (configuración creada con start()) como
+ * para reanudar una instantánea. Se detiene al aceptar, al no encontrar
+ * transición aplicable, al entrar en un estado muerto (marcado por
+ * MachineOptimizer), al superar el límite de pasos o, si hay un Checkpointer,
+ * cuando se pide la suspensión; en ese caso la configuración queda lista para
+ * continuar con otra llamada a run().
+ * Con un TraceFilter solo se imprimen los pasos que lo cumplen.
+ * Con una ChainFusion (y sin traza ni Checkpointer) las transiciones que
+ * inician una cadena determinista se aplican como una superinstrucción,
+ * siempre que quepa entera en el quantum y en el límite de pasos; si no, se
+ * avanza eslabón a eslabón, de modo que pasos, veredicto y cintas no cambian.
+ * Las operaciones nativas (Builtin) se ejecutan igual, con tantas iteraciones
+ * de golpe como quepan (una sola con traza o Checkpointer).
+ * 
+ * @param configuration Configuración de partida (se modifica durante la ejecución).
+ * @param trace Si es true, imprime el trazo de ejecución en el stream os.
+ * @param os Stream de salida donde se imprimirá el trazo (si trace es true).
+ * @return Motivo por el que se detuvo la ejecución.
+ */
+RunStatus TuringMachineSimulator::run(Configuration& configuration, bool trace, std::ostream& os) const {
+  std::vector<Symbol> currentRead;
+  return advance(configuration, currentRead, std::numeric_limits<long long>::max(), trace, os);
+}
+
+/**
+ * @brief Ejecuta la MT sobre la configuración de un RunContext.
+ * 
+ * Igual que run(Configuration&), pero el buffer de símbolos leídos es el del
+ * contexto, de modo que el bucle de simulación no reserva memoria por paso.
+ * 
+ * @param context Contexto preparado con start(RunContext&) o con una instantánea.
+ * @param trace Si es true, imprime el trazo de ejecución en el stream os.
+ * @param os Stream de salida donde se imprimirá el trazo (si trace es true).
+ * @return Motivo por el que se detuvo la ejecución.
+ */
+RunStatus TuringMachineSimulator::run(RunContext& context, bool trace, std::ostream& os) const {
+  return advance(context.getConfiguration(), context.getReadBuffer(), std::numeric_limits<long long>::max(),
+                 trace, os);
+}
+
+/**
+ * @brief Ejecuta como mucho quantum pasos desde una configuración.
+ * 
+ * Es run() troceado: la semántica (veredicto, límite de pasos, cintas) es la
+ * misma, pero si la MT sigue en marcha tras quantum transiciones devuelve
+ * RUNNING y la configuración queda lista para la siguiente llamada. Permite
+ * intercalar muchas ejecuciones en el mismo hilo (ver Scheduler).
+ * 
+ * @param configuration Configuración de partida (se modifica durante la ejecución).
+ * @param quantum Número máximo de transiciones a aplicar en esta llamada.
+ * @return RUNNING si se agotó el quantum, o el motivo por el que se detuvo la MT.
+ */
+RunStatus TuringMachineSimulator::step(Configuration& configuration, long long quantum) const {
+  std::ostringstream unused;
+  std::vector<Symbol> currentRead;
+  return advance(configuration, currentRead, quantum, false, unused);
+}
+
+/**
+ * @brief Ejecuta hasta que el cabezal 0 sale por la derecha de la cinta 0.
+ * 
+ * Sirve para simular un prefijo común a varias entradas (ver PrefixSharing):
+ * mientras el cabezal 0 no pasa del final de la cinta 0, lo que venga después
+ * no influye en la ejecución. En cuanto un paso lleva el cabezal 0 más allá
+ * del final (y la cinta crece con un blanco), se detiene y devuelve RUNNING,
+ * aunque ese paso supere el límite de pasos: lo comprueba quien continúe.
+ * Nunca usa la ChainFusion, que podría saltarse ese paso.
+ * 
+ * @param configuration Configuración de partida (se modifica durante la ejecución).
+ * @param currentRead Buffer para los símbolos leídos en cada paso (se reutiliza).
+ * @return RUNNING si el cabezal 0 salió por la derecha, o el motivo por el que se detuvo la MT.
+ */
+RunStatus TuringMachineSimulator::runToTapeEnd(Configuration& configuration, std::vector<Symbol>& currentRead) const {
+  std::ostringstream unused;
+  bool tapeEnd = false;
+  return advance(configuration, currentRead, std::numeric_limits<long long>::max(), false, unused, &tapeEnd);
+}
+
+/**
+ * @brief Ejecuta la MT con la cinta 0 alimentada poco a poco desde una StreamTape (--stream-tape).
+ * 
+ * La configuración de partida es la de start() con la entrada vacía: la cinta 0
+ * es el blanco provisional de tape0. Mientras la entrada no se acaba, se simula
+ * deteniéndose cada vez que el cabezal 0 pasa del último símbolo recibido
+ * (como runToTapeEnd()) y se pide el siguiente a tape0. Si el paso que se salió
+ * ya supera el límite o lleva a un estado de parada, se decide sin esperar a la
+ * entrada. Con la entrada acabada es run() (con la ChainFusion, si la hay).
+ * Los pasos y el veredicto son los de run() con la entrada completa; la cinta 0
+ * solo tiene lo recibido hasta decidir.
+ * 
+ * @param configuration Configuración de partida o de una llamada anterior (se modifica).
+ * @param tape0 Entrada de la cinta 0.
+ * @param quantum Número máximo de transiciones a aplicar en esta llamada.
+ * @param block Si es true, espera a la entrada; si es false, devuelve RUNNING en
+ *        cuanto haga falta un símbolo que todavía no ha llegado (tape0.isPending()).
+ * @return RUNNING si se agotó el quantum o falta entrada, o el motivo por el que se detuvo la MT.
+ */
+RunStatus TuringMachineSimulator::runOnStream(Configuration& configuration, StreamTape& tape0, long long quantum,
+                                              bool block) const {
+  std::ostringstream unused;
+  std::vector<Symbol> currentRead;
+  while (true) {
+    const State& state = configuration.getState();
+    if (tape0.isPending() && !state.isAccept() && !state.isDead() &&
+        tape0.fill(configuration.getTapes()[0], block) == StreamTape::Fill::WAIT) {
+      return RunStatus::RUNNING;
+    }
+    bool tapeEnd = false;
+    long long before = configuration.getSteps();
+    RunStatus status = advance(configuration, currentRead, quantum, false, unused, tape0.isEnded() ? nullptr : &tapeEnd);
+    if (status != RunStatus::RUNNING || !tapeEnd) return status;
+    if (configuration.getSteps() > maxSteps_) return RunStatus::STEP_LIMIT;
+    tape0.setPending();
+    quantum -= configuration.getSteps() - before;
+    if (quantum <= 0) return RunStatus::RUNNING;
+  }
+}
+
+/**
+ * @brief Bucle de simulación común a run(), step(), runToTapeEnd() y runOnStream().
+ * 
+ * @param configuration Configuración de partida (se modifica durante la ejecución).
+ * @param currentRead Buffer para los símbolos leídos en cada paso (se reutiliza).
+ * @param quantum Número máximo de transiciones a aplicar.
+ * @param trace Si es true, imprime el trazo de ejecución en el stream os.
+ * @param os Stream de salida del trazo.
+ * @param tapeEnd Si no es nullptr, devuelve RUNNING tras el paso que hace crecer la cinta 0 por
+ *        la derecha y lo indica poniéndolo a true.
+ * @return RUNNING si se agotó el quantum (o se salió de la cinta 0), o el motivo por el que se detuvo la MT.
+ */
+RunStatus TuringMachineSimulator::advance(Configuration& configuration, std::vector<Symbol>& currentRead,
+                                          long long quantum, bool trace, std::ostream& os,
+                                          bool* tapeEnd) const {
+  std::vector<std::vector<Symbol>>& tapes = configuration.getTapes();
+  std::vector<int>& heads = configuration.getHeads();
+  State& currentState = configuration.getState();
+  currentState = model_.getStateById(currentState.getId());
+  int tapeCount = tapes.size();
+  bool bulk = !trace && checkpointer_ == nullptr && tapeEnd == nullptr;
+  bool fuse = fusion_ != nullptr && bulk;
+  if (trace && configuration.getSteps() == 0) tracePrinter_.printHeader(os);
   while (true) {
     if (currentState.isAccept()) {
-      accepted = true;
       if (trace) tracePrinter_.printAcceptedMessage(os);
-      break;
+      return RunStatus::ACCEPTED;
     }
-    auto currentRead = readCurrentSymbols(tapes, heads);
+    if (currentState.isDead()) {
+      if (trace) tracePrinter_.printRejectedMessage(os);
+      return RunStatus::REJECTED;
+    }
+    if (checkpointer_ != nullptr && checkpointer_->suspendRequested()) {
+      return RunStatus::SUSPENDED;
+    }
+    if (quantum-- == 0) return RunStatus::RUNNING;
+    readCurrentSymbols(tapes, heads, currentRead);
     bool foundTransition = false;
-    const Transition& transition = findApplicableTransition(currentState, tapes, heads, foundTransition);
-    if (trace) {
-      tracePrinter_.printStep(os, steps, currentState, currentRead, transition, foundTransition, tapes, heads, tapeCount);
+    const Transition& transition = findApplicableTransition(currentState, currentRead, foundTransition);
+    if (trace && (traceFilter_ == nullptr ||
+                  traceFilter_->matchesStep(configuration.getSteps(), currentState, transition, foundTransition))) {
+      tracePrinter_.printStep(os, configuration.getSteps(), currentState, currentRead, transition, foundTransition, tapes, heads, tapeCount);
     }
     if (!foundTransition) {
       if (trace) tracePrinter_.printRejectedMessage(os);
-      break;
+      return RunStatus::REJECTED;
     }
-    applyTransition(transition, tapes, heads, currentState);
-    steps++;
-    if (steps > MAX_STEPS) {
+    size_t tape0Size = tapes[0].size();
+    const ChainFusion::Superinstruction* chain = fuse ? fusion_->find(transition) : nullptr;
+    if (transition.isBuiltin()) {
+      long long iterations = transition.getBuiltin().run(tapes, heads, bulk ? builtinBudget(configuration, quantum) : 1);
+      quantum -= iterations - 1;
+      configuration.setSteps(configuration.getSteps() + iterations);
+    } else if (chain != nullptr && chain->length - 1 <= quantum && chain->length - 1 <= maxSteps_ - configuration.getSteps()) {
+      ChainFusion::apply(*chain, tapes, heads);
+      currentState = chain->target;
+      quantum -= chain->length - 1;
+      configuration.setSteps(configuration.getSteps() + chain->length);
+    } else {
+      applyTransition(transition, tapes, heads, currentState);
+      configuration.incrementSteps();
+    }
+    if (tapeEnd != nullptr && tapes[0].size() > tape0Size && heads[0] == (int)tapes[0].size() - 1) {
+      *tapeEnd = true;
+      return RunStatus::RUNNING;
+    }
+    if (configuration.getSteps() > maxSteps_) {
       if (trace) tracePrinter_.printMaxStepsMessage(os);
-      break;
+      return RunStatus::STEP_LIMIT;
     }
+    if (checkpointer_ != nullptr) checkpointer_->onStep(configuration);
   }
-  flattenResult(input, tapes);
-  return accepted;
+}
+
+/**
+ * @brief Calcula cuántas iteraciones de una operación nativa se pueden ejecutar de golpe.
+ * 
+ * Como una superinstrucción de ChainFusion: la primera iteración es el paso en
+ * curso y el resto tienen que caber en lo que queda de quantum; además se puede
+ * llegar hasta el paso que supera el límite, para que STEP_LIMIT salte en el
+ * mismo paso (y con las mismas cintas) que con las transiciones a mano.
+ * 
+ * @param configuration Configuración actual.
+ * @param quantum Transiciones que quedan en la llamada tras el paso en curso.
+ * @return Número máximo de iteraciones (al menos 1).
+ */
+long long TuringMachineSimulator::builtinBudget(const Configuration& configuration, long long quantum) const {
+  long long budget = std::min(quantum, maxSteps_ - configuration.getSteps());
+  if (budget < 0) return 1;
+  return budget < std::numeric_limits<long long>::max() ? budget + 1 : budget;
 }
 
 /**
@@ -75,19 +312,20 @@ bool TuringMachineSimulator::compute(String& input, bool trace, std::ostream& os
  * 
  * Crea el número especificado de cintas, coloca la cadena de entrada en la cinta 0,
  * e inicializa las demás cintas con un símbolo blanco. Todas las cabezas comienzan
- * en la posición 0.
+ * en la posición 0. Las cintas que ya existían se vacían sin liberar su memoria.
  * 
- * @param input Cadena de entrada para colocar en la cinta 0.
+ * @param input Símbolos de la cadena de entrada para colocar en la cinta 0.
  * @param tapeCount Número de cintas a crear.
  * @param tapes Vector de cintas (salida, se modificará).
  * @param heads Vector de posiciones de cabezas (salida, se modificará).
  */
-void TuringMachineSimulator::initializeTapes(const String& input, int tapeCount, 
+void TuringMachineSimulator::initializeTapes(const std::vector<Symbol>& input, int tapeCount, 
                                              std::vector<std::vector<Symbol>>& tapes, 
                                              std::vector<int>& heads) const {
-  tapes.assign(tapeCount, std::vector<Symbol>());
+  tapes.resize(tapeCount);
+  for (auto& tape : tapes) tape.clear();
   heads.assign(tapeCount, 0);
-  for (const auto& s : input.getSymbols()) tapes[0].push_back(s);
+  tapes[0].insert(tapes[0].end(), input.begin(), input.end());
   if (tapes[0].empty()) tapes[0].push_back(Symbol('.'));
   for (int i = 1; i < tapeCount; ++i) tapes[i].push_back(Symbol('.'));
 }
@@ -100,71 +338,48 @@ void TuringMachineSimulator::initializeTapes(const String& input, int tapeCount,
  * 
  * @param tapes Vector de cintas.
  * @param heads Vector de posiciones de cabezas.
- * @return Vector de símbolos leídos, uno por cinta.
+ * @param currentRead Símbolos leídos, uno por cinta (salida, se reutiliza su memoria).
  */
-std::vector<Symbol> TuringMachineSimulator::readCurrentSymbols(
-    const std::vector<std::vector<Symbol>>& tapes, 
-    const std::vector<int>& heads) const {
+void TuringMachineSimulator::readCurrentSymbols(const std::vector<std::vector<Symbol>>& tapes, 
+                                                const std::vector<int>& heads,
+                                                std::vector<Symbol>& currentRead) const {
   int tapeCount = tapes.size();
-  std::vector<Symbol> currentRead(tapeCount, Symbol('.'));
+  currentRead.assign(tapeCount, Symbol('.'));
   for (int t = 0; t < tapeCount; ++t) {
     int h = heads[t];
     if (h >= 0 && h < (int)tapes[t].size()){
       currentRead[t] = tapes[t][h];
     }
   }
-  return currentRead;
 }
 
 /**
  * @brief Busca una transición aplicable al estado actual y símbolos leídos.
  * 
- * Usa el map de transiciones del modelo para buscar directamente las transiciones 
- * que parten del estado actual (O(1) en lugar de O(n)). Compara los símbolos
- * leídos de TODAS las cintas con readSymbols de cada transición.
+ * Delega en el árbol de decisión que el modelo compila para cada estado
+ * (TransitionMatcher): baja cinta a cinta por los símbolos leídos, probando
+ * antes el símbolo concreto que el comodín, en lugar de comparar todas las
+ * transiciones del estado una a una.
  * 
  * @param currentState Estado actual de la máquina.
- * @param tapes Vector de cintas.
- * @param heads Vector de posiciones de cabezas.
+ * @param currentRead Símbolos leídos bajo cada cabeza.
  * @param found Referencia bool que se establece a true si se encuentra una transición.
  * @return Referencia a la transición encontrada, o a emptyTransition_ si no se encuentra.
  */
 const Transition& TuringMachineSimulator::findApplicableTransition(
     const State& currentState, 
-    const std::vector<std::vector<Symbol>>& tapes, 
-    const std::vector<int>& heads,
+    const std::vector<Symbol>& currentRead,
     bool& found) const {
-  std::vector<Symbol> currentSymbols = readCurrentSymbols(tapes, heads);
-  const auto& transitions = model_.getTransitionsFrom(currentState.getId());
-  for (const auto& transition : transitions) {
-    const auto& readSyms = transition.getReadSymbols();
-    if (readSyms.size() != currentSymbols.size()) {
-      throw std::runtime_error(
-        "Error: La transición desde el estado '" + currentState.getId() + 
-        "' tiene " + std::to_string(readSyms.size()) + " símbolos de lectura, " +
-        "pero la máquina tiene " + std::to_string(currentSymbols.size()) + " cintas"
-      );
-    }
-    bool match = true;
-    for (size_t i = 0; i < currentSymbols.size(); ++i) {
-      if (readSyms[i].getValue() != currentSymbols[i].getValue()) {
-        match = false;
-        break;
-      }
-    }
-    if (match) {
-      found = true;
-      return transition;
-    }
-  }
-  found = false;
-  return emptyTransition_;
+  const Transition* transition = model_.findTransition(currentState.getId(), currentRead);
+  found = transition != nullptr;
+  return found ? *transition : emptyTransition_;
 }
 
 /**
  * @brief Aplica una transición: escribe símbolos, mueve cabezas y cambia de estado.
  * 
- * Escribe los símbolos especificados en cada cinta bajo las cabezas, mueve cada
+ * Escribe los símbolos especificados en cada cinta bajo las cabezas (salvo el
+ * comodín de escritura, que deja la celda como está), mueve cada
  * cabeza según el vector de movimientos (LEFT, RIGHT o STAY), expandiendo las
  * cintas si es necesario, y actualiza el estado actual usando el map de estados
  * del modelo para búsqueda O(1) (para preservar flags de aceptación).
@@ -178,43 +393,13 @@ void TuringMachineSimulator::applyTransition(const Transition& transition,
                                              std::vector<std::vector<Symbol>>& tapes, 
                                              std::vector<int>& heads, 
                                              State& currentState) const {
-  int tapeCount = tapes.size();
-  const std::map<int, std::pair<Symbol, Moves>>& actions = transition.getTapeActions();
-  if ((int)actions.size() != tapeCount) {
-    throw std::runtime_error(
-      "Error: La transición desde '" + transition.getFrom().getId() + 
-      "' a '" + transition.getTo().getId() + "' tiene " + 
-      std::to_string(actions.size()) + " acciones de escritura/movimiento, " +
-      "pero la máquina tiene " + std::to_string(tapeCount) + " cintas"
-    );
-  }
-  for (const auto& pair : actions) {
+  checkActions(transition, tapes.size());
+  for (const auto& pair : transition.getTapeActions()) {
     int tapeIndex = pair.first;
     const Symbol& writeSymbol = pair.second.first;
     Moves move = pair.second.second;
-    if (tapeIndex < 0 || tapeIndex >= tapeCount) {
-      throw std::runtime_error(
-        "Error: La transición desde '" + transition.getFrom().getId() + 
-        "' a '" + transition.getTo().getId() + "' intenta acceder a la cinta " + 
-        std::to_string(tapeIndex) + ", pero solo hay " + std::to_string(tapeCount) + " cintas"
-      );
-    }
-    
-    tapes[tapeIndex][heads[tapeIndex]] = writeSymbol;
-    if (move == Moves::LEFT) {
-      if (heads[tapeIndex] == 0) {
-        tapes[tapeIndex].insert(tapes[tapeIndex].begin(), Symbol('.'));
-      } else {
-        heads[tapeIndex]--;
-      }
-    } else if (move == Moves::RIGHT) {
-      heads[tapeIndex]++;
-      if (heads[tapeIndex] == (int)tapes[tapeIndex].size()) {
-        tapes[tapeIndex].push_back(Symbol('.'));
-      }
-    } else if (move == Moves::STAY) {
-      // Si es STAY, no hacer nada
-    } else {
+    if (writeSymbol.getValue() != Symbol::WILDCARD) tapes[tapeIndex][heads[tapeIndex]] = writeSymbol;
+    if (!moveHead(tapes[tapeIndex], heads[tapeIndex], move)) {
       throw std::runtime_error(
         "Error: Movimiento inválido en la transición desde '" + transition.getFrom().getId() + 
         "' a '" + transition.getTo().getId() + "' en la cinta " + 
@@ -230,6 +415,127 @@ void TuringMachineSimulator::applyTransition(const Transition& transition,
   }
 }
 
+/**
+ * @brief Comprueba que una transición tiene exactamente una acción por cinta.
+ * 
+ * Las acciones están ordenadas por cinta y no se repiten, así que basta con
+ * comprobar su número y que la primera y la última caen dentro de la máquina.
+ * 
+ * @param transition Transición a comprobar.
+ * @param tapeCount Número de cintas de la máquina.
+ * @throws std::runtime_error si sobran o faltan acciones o alguna es de una cinta que no existe.
+ */
+void TuringMachineSimulator::checkActions(const Transition& transition, int tapeCount) {
+  const std::map<int, std::pair<Symbol, Moves>>& actions = transition.getTapeActions();
+  if ((int)actions.size() != tapeCount) {
+    throw std::runtime_error(
+      "Error: La transición desde '" + transition.getFrom().getId() + 
+      "' a '" + transition.getTo().getId() + "' tiene " + 
+      std::to_string(actions.size()) + " acciones de escritura/movimiento, " +
+      "pero la máquina tiene " + std::to_string(tapeCount) + " cintas"
+    );
+  }
+  if (actions.empty()) return;
+  int tapeIndex = actions.begin()->first < 0 ? actions.begin()->first : actions.rbegin()->first;
+  if (tapeIndex < 0 || tapeIndex >= tapeCount) {
+    throw std::runtime_error(
+      "Error: La transición desde '" + transition.getFrom().getId() + 
+      "' a '" + transition.getTo().getId() + "' intenta acceder a la cinta " + 
+      std::to_string(tapeIndex) + ", pero solo hay " + std::to_string(tapeCount) + " cintas"
+    );
+  }
+}
+
+/**
+ * @brief Mueve un cabezal expandiendo la cinta con blancos si sale de ella.
+ * 
+ * - LEFT: si el cabezal está en la posición 0 se inserta un blanco al inicio
+ * - RIGHT: avanza y, si alcanza el final, se añade un blanco
+ * - STAY: no hace nada
+ * 
+ * @param tape Cinta sobre la que se mueve el cabezal (se modificará si crece).
+ * @param head Posición del cabezal (se modificará).
+ * @param move Movimiento a realizar.
+ * @return false si el movimiento no es válido.
+ */
+bool TuringMachineSimulator::moveHead(std::vector<Symbol>& tape, int& head, Moves move) {
+  if (move == Moves::LEFT) {
+    if (head == 0) {
+      tape.insert(tape.begin(), Symbol('.'));
+    } else {
+      head--;
+    }
+  } else if (move == Moves::RIGHT) {
+    head++;
+    if (head == (int)tape.size()) {
+      tape.push_back(Symbol('.'));
+    }
+  } else if (move != Moves::STAY) {
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Simula la MT usando como cinta 0 un fichero proyectado en memoria.
+ * 
+ * Misma semántica que compute(), pero la cinta 0 es una MappedTape: la entrada
+ * no se copia a memoria ni se convierte en String, solo se cargan las páginas
+ * que tocan los cabezales y el resultado se queda en la propia MappedTape para
+ * volcarlo con MappedTape::writeTo(). El resto de cintas son vectores normales.
+ * No admite traza, instantáneas ni operaciones nativas. Las transiciones se
+ * comprueban igual que en applyTransition() (una acción por cinta).
+ * 
+ * @param tape0 Cinta 0 proyectada (se modifica durante la ejecución).
+ * @param steps Número de pasos ejecutados (salida).
+ * @return Motivo por el que se detuvo la ejecución.
+ * @throws std::runtime_error si la MT tiene operaciones nativas (antes de tocar la cinta) o si una
+ *         transición no tiene exactamente una acción por cinta.
+ */
+RunStatus TuringMachineSimulator::computeOnMappedTape(MappedTape& tape0, long long& steps) const {
+  if (!model_.getBuiltins().empty()) {
+    throw std::runtime_error("Error: --mmap-tape no admite operaciones nativas (estado " +
+                             model_.getBuiltins().begin()->first + ")");
+  }
+  int tapeCount = model_.determineTapeCount();
+  std::vector<std::vector<Symbol>> tapes(tapeCount, std::vector<Symbol>(1, Symbol('.')));
+  std::vector<int> heads(tapeCount, 0);
+  int64_t head0 = 0;
+  std::vector<Symbol> currentRead(tapeCount, Symbol('.'));
+  State currentState = model_.getInitialState();
+  steps = 0;
+  while (true) {
+    if (currentState.isAccept()) return RunStatus::ACCEPTED;
+    if (currentState.isDead()) return RunStatus::REJECTED;
+    currentRead[0] = Symbol(tape0.get(head0));
+    for (int t = 1; t < tapeCount; ++t) currentRead[t] = tapes[t][heads[t]];
+    const Transition* transition = model_.findTransition(currentState.getId(), currentRead);
+    if (transition == nullptr) return RunStatus::REJECTED;
+    checkActions(*transition, tapeCount);
+    for (const auto& pair : transition->getTapeActions()) {
+      int t = pair.first;
+      char write = pair.second.first.getValue();
+      Moves move = pair.second.second;
+      if (t == 0) {
+        if (write != Symbol::WILDCARD) tape0.set(head0, write);
+        if (move == Moves::LEFT) {
+          if (head0 == tape0.begin()) tape0.extendLeft();
+          head0--;
+        } else if (move == Moves::RIGHT) {
+          head0++;
+          if (head0 == tape0.end()) tape0.extendRight();
+        }
+      } else {
+        if (write != Symbol::WILDCARD) tapes[t][heads[t]] = Symbol(write);
+        moveHead(tapes[t], heads[t], move);
+      }
+    }
+    currentState = model_.getStateById(transition->getTo().getId());
+    steps++;
+    if (steps > maxSteps_) return RunStatus::STEP_LIMIT;
+  }
+}
+
 /**
  * @brief Aplana el resultado de la simulación en la cadena de salida.
  * 
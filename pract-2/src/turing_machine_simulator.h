@@ -3,7 +3,14 @@
 
 #include <vector>
 #include <ostream>
+#include "chain_fusion.h"
+#include "configuration.h"
+#include "checkpointer.h"
+#include "mapped_tape.h"
+#include "run_context.h"
+#include "stream_tape.h"
 #include "turing_machine_model.h"
+#include "trace_filter.h"
 #include "trace_printer.h"
 #include "string.h"
 #include "symbol.h"
@@ -15,27 +22,55 @@
  * Se encarga de ejecutar la simulación de una MT sobre cadenas de entrada.
  * Mantiene el estado de las cintas, cabezas y estado actual durante la ejecución.
  * Usa composición con TracePrinter para delegar la responsabilidad de impresión.
+ * La ejecución trabaja sobre una Configuration explícita, de modo que puede
+ * suspenderse, guardarse en disco y reanudarse más tarde con run().
+ * Con una ChainFusion aplica de golpe las cadenas deterministas de transiciones
+ * (salvo con traza o instantáneas, que necesitan ver cada paso), y lo mismo
+ * con las operaciones nativas (Builtin) de los estados.
  */
 class TuringMachineSimulator {
  public:
   explicit TuringMachineSimulator(const TuringMachineModel& model);
   bool compute(String& input, bool trace, std::ostream& os) const;
+  Configuration start(const String& input) const;
+  Configuration start(std::vector<Symbol>&& tape0) const;
+  void start(RunContext& context) const;
+  RunStatus run(Configuration& configuration, bool trace, std::ostream& os) const;
+  RunStatus run(RunContext& context, bool trace, std::ostream& os) const;
+  RunStatus step(Configuration& configuration, long long quantum) const;
+  RunStatus runToTapeEnd(Configuration& configuration, std::vector<Symbol>& currentRead) const;
+  RunStatus runOnStream(Configuration& configuration, StreamTape& tape0, long long quantum, bool block) const;
+  RunStatus computeOnMappedTape(MappedTape& tape0, long long& steps) const;
+  void flattenResult(String& input, const std::vector<std::vector<Symbol>>& tapes) const;
+  static bool moveHead(std::vector<Symbol>& tape, int& head, Moves move);
+  void setMaxSteps(long long maxSteps) { maxSteps_ = maxSteps; }
+  long long getMaxSteps() const { return maxSteps_; }
+  void setCheckpointer(Checkpointer* checkpointer) { checkpointer_ = checkpointer; }
+  void setTraceFilter(const TraceFilter* traceFilter) { traceFilter_ = traceFilter; }
+  void setChainFusion(const ChainFusion* fusion) { fusion_ = fusion; }
+  static const long long DEFAULT_MAX_STEPS = 50;
  private:
-  void initializeTapes(const String& input, int tapeCount, std::vector<std::vector<Symbol>>& tapes, 
+  RunStatus advance(Configuration& configuration, std::vector<Symbol>& currentRead, long long quantum,
+                    bool trace, std::ostream& os, bool* tapeEnd = nullptr) const;
+  long long builtinBudget(const Configuration& configuration, long long quantum) const;
+  void initializeTapes(const std::vector<Symbol>& input, int tapeCount, std::vector<std::vector<Symbol>>& tapes, 
                       std::vector<int>& heads) const;
-  std::vector<Symbol> readCurrentSymbols(const std::vector<std::vector<Symbol>>& tapes, 
-                                         const std::vector<int>& heads) const;
+  void readCurrentSymbols(const std::vector<std::vector<Symbol>>& tapes, const std::vector<int>& heads,
+                          std::vector<Symbol>& currentRead) const;
   const Transition& findApplicableTransition(const State& currentState, 
-                                             const std::vector<std::vector<Symbol>>& tapes, 
-                                             const std::vector<int>& heads,
+                                             const std::vector<Symbol>& currentRead,
                                              bool& found) const;
+  static void checkActions(const Transition& transition, int tapeCount);
   void applyTransition(const Transition& tr, 
                       std::vector<std::vector<Symbol>>& tapes, 
                       std::vector<int>& heads, 
                       State& currentState) const;
-  void flattenResult(String& input, const std::vector<std::vector<Symbol>>& tapes) const;
   const TuringMachineModel& model_;
   TracePrinter tracePrinter_;
+  long long maxSteps_;
+  Checkpointer* checkpointer_;
+  const TraceFilter* traceFilter_;
+  const ChainFusion* fusion_;
   static const Transition emptyTransition_;
 };
 
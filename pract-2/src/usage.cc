@@ -4,8 +4,8 @@
 /**
  * @brief Valida los argumentos de línea de comandos y muestra ayuda si es necesario.
  * 
- * Verifica que se hayan pasado el número correcto de argumentos (2 o más además del nombre
- * del programa). Si se pasa --help como único argumento, muestra el mensaje de ayuda.
+ * Verifica que se hayan pasado al menos los 2 argumentos obligatorios además del nombre
+ * del programa (las opciones se validan después en Args). Si se pasa --help como único argumento, muestra el mensaje de ayuda.
  * Si el número de argumentos es incorrecto, muestra un error y termina el programa.
  * 
  * @param argc Número de argumentos de línea de comandos.
@@ -13,11 +13,56 @@
  */
 void usage(int argc, char* argv[]) {
   const std::string helpMsg =
-    "Uso: " + std::string(argv[0]) + " <fichero_MT> <fichero_cadenas> [--trace] [--info]\n"
+    "Uso: " + std::string(argv[0]) + " <fichero_MT> <fichero_cadenas> [opciones]\n"
+    "       " + std::string(argv[0]) + " <fichero_MT> --census <n> [opciones]\n"
+    "       " + std::string(argv[0]) + " --busy-beaver <n> [--bb-symbols <k>] [--max-steps <s>] [--threads <t>]\n"
+    "       " + std::string(argv[0]) + " --merge <FileOut-0-of-N.txt> ... : junta los resultados de los shards en FileOut.txt\n"
     "  <fichero_MT>       : Archivo con la definición de la Máquina de Turing\n"
     "  <fichero_cadenas>  : Archivo con las cadenas de entrada a procesar\n"
     "  --trace (opcional) : Muestra la traza de ejecución paso a paso\n"
-    "  --info  (opcional) : Muestra la información de la Máquina de Turing creada\n";
+    "  --info  (opcional) : Muestra la información de la Máquina de Turing creada\n"
+    "  --optimize (opcional)      : Poda estados inalcanzables, fusiona equivalentes y rechaza en estados muertos\n"
+    "  --fuse-chains (opcional)   : Aplica de golpe las cadenas deterministas de transiciones (superinstrucciones)\n"
+    "  --prefix-sharing (opcional): Simula una sola vez los prefijos comunes de las cadenas (trie ordenado)\n"
+    "  --compact (opcional)       : Carga la MT en formato compacto (arena) para máquinas enormes\n"
+    "  --lazy-load (opcional)     : Indexa las transiciones por estado y solo parsea las de los estados que se visitan\n"
+    "  --mmap-tape (opcional)     : <fichero_cadenas> es una única entrada proyectada en memoria como cinta 0\n"
+    "  --tape-out <fichero>       : Fichero donde se vuelca la cinta final con --mmap-tape (TapeOut.txt)\n"
+    "  --stream-tape (opcional)   : <fichero_cadenas> (o - para stdin) alimenta la cinta 0 poco a poco; decide sin esperar al final\n"
+    "                               (con --schedule fair, cada línea es un origen y las que esperan entrada ceden el turno)\n"
+    "  --stream-follow (opcional) : Con --stream-tape, sigue los ficheros normales como tail -f (el final no es el fin)\n"
+    "  --trace-steps <rangos>     : Traza solo esos pasos (p. ej. 0-10,500,1000-); activa --trace\n"
+    "  --trace-states <q,...>     : Traza solo los pasos en esos estados; activa --trace\n"
+    "  --trace-writes <s,...>     : Traza solo las transiciones que escriben esos símbolos; activa --trace\n"
+    "  --trace-strings <patrón>   : Traza solo las cadenas que cumplen el patrón (*, ?, [...]); activa --trace\n"
+    "  --trace-sample <n>         : Traza 1 de cada n pasos; activa --trace\n"
+    "  --pipeline <MT2,MT3,...>   : Encadena MT: la cinta 0 final de cada una es la entrada de la siguiente\n"
+    "  --matrix <MT2,MT3,...>     : Evalúa todas las MT (la principal y estas) sobre todas las cadenas; tabla en FileOut.txt\n"
+    "  --matrix-strings <f2,...>  : Ficheros de cadenas adicionales para --matrix\n"
+    "  --block-size <k>           : Simula por bloques de k celdas con recorridos memorizados (MT de 1 cinta)\n"
+    "  --schedule <política>      : Intercala las cadenas en cuantos de pasos: fair (turno rotatorio) o srf (menos pasos primero)\n"
+    "  --quantum <n>              : Pasos por turno con --schedule (por defecto 10000)\n"
+    "  --in-flight <n>            : Cadenas en vuelo a la vez con --schedule (por defecto 64)\n"
+    "  --census <n>               : Clasifica todas las cadenas del alfabeto de entrada de longitud 0..n (sin fichero de cadenas)\n"
+    "  --census-samples <k>       : Muestras por longitud y clase en el censo (por defecto 3)\n"
+    "  --busy-beaver <n>          : Enumera las MT de n estados en forma normal de árbol y busca los campeones\n"
+    "  --bb-symbols <k>           : Símbolos (blanco incluido) de --busy-beaver (por defecto 2)\n"
+    "  --threads <t>              : Hilos del censo, de --matrix y de --busy-beaver (por defecto, todos los del equipo)\n"
+    "  --shard <i/N>              : Procesa solo la parte i (0..N-1) del lote; escribe FileOut-<i>-of-<N>.txt\n"
+    "  --shard-by <modo>          : Reparto de cadenas entre shards: line (por posición, por defecto) o hash\n"
+    "  --model-cache <fichero>    : Modelo compacto compilado en disco, compartido (mmap) entre procesos; implica --compact\n"
+    "  --max-steps <n>            : Límite de pasos por cadena (por defecto 50; 1000 con --busy-beaver)\n"
+    "  --checkpoint <fichero>     : Guarda instantáneas de la ejecución (y al recibir SIGINT/SIGTERM)\n"
+    "  --checkpoint-steps <n>     : Guarda una instantánea cada n pasos\n"
+    "  --checkpoint-seconds <s>   : Guarda una instantánea cada s segundos\n"
+    "  --resume <fichero>         : Reanuda la ejecución desde una instantánea\n"
+    "  --output-tapes <i,j,...>   : Cintas que se escriben como resultado (por defecto 0)\n"
+    "  --output-mode <modo>       : full (cinta completa), trim (sin blancos extremos) o span (tramo del cabezal)\n"
+    "  --verdict-only (opcional)  : Escribe solo ACEPTADA/RECHAZADA, sin extraer ninguna cinta\n"
+    "  --metrics <fichero>        : Fichero de métricas Prometheus del lote (por defecto metrics.prom)\n"
+    "  --progress-seconds <s>     : Línea de progreso en stderr cada s segundos (por defecto 10, 0 para nunca)\n"
+    "  --no-telemetry (opcional)  : Desactiva la telemetría (ni métricas ni progreso)\n"
+    "  --perf-counters (opcional) : Añade a las métricas contadores hardware (perf_event_open) por fase, paso y veredicto\n";
 
   if (argc == 2 && std::string(argv[1]) == "--help") {
     std::cout << helpMsg;
@@ -28,9 +73,4 @@ void usage(int argc, char* argv[]) {
     std::cerr << helpMsg;
     exit(EXIT_FAILURE);
   }
-  if (argc > 5) {
-    std::cerr << "Demasiados argumentos. Máximo 4 argumentos (fichero_MT, fichero_cadenas, --trace, --info).\n";
-    std::cerr << helpMsg;
-    exit(EXIT_FAILURE);
-  }
 }
\ No newline at end of file
@@ -24,10 +24,11 @@ run_test() {
     local strings_file=$2
     local output_file=$3
     local description=$4
+    local flags=$5
     
     echo -e "${BLUE}${description}${NC}"
     echo "-----------------------------------"
-    ./pract-02 "$mt_file" "$strings_file" > "$output_file" 2>&1
+    ./pract-02 "$mt_file" "$strings_file" $flags > "$output_file" 2>&1
     cat FileOut.txt
     mv FileOut.txt "$output_file.results"
     echo ""
@@ -125,6 +126,133 @@ run_test "Test/MT/Ejemplo2_MT.txt" \
 echo -e "${YELLOW}Máquina de prueba${NC}"
 echo ""
 
+# 8. Optimizador (--optimize)
+run_test "Test/MT/Optimizable_1Tape_MT.txt" \
+         "Test/Strings/strings_optimizable.txt" \
+         "Test/Outputs/optimizable.out" \
+         "8. Optimizador: poda, fusión de estados y rechazo anticipado" \
+         "--optimize --info"
+echo -e "${YELLOW}Debería ACEPTAR: a, ab, aba${NC}"
+echo -e "${YELLOW}Debería RECHAZAR: b, bab, bbbbbbbb (rechazo anticipado en estado muerto)${NC}"
+echo ""
+
+# 9. Comodines en lectura/escritura (2 cintas)
+run_test "Test/MT/Copy_Wildcard_2Tapes_MT.txt" \
+         "Test/Strings/strings_copy.txt" \
+         "Test/Outputs/copy_wildcard.out" \
+         "9. Copia con comodines '*' (2 cintas)"
+echo -e "${YELLOW}Mismo resultado que el test 4 (Copy_2Tapes_MT.txt)${NC}"
+echo ""
+
+# 10. Pipeline: la cinta 0 final de una MT es la entrada de la siguiente
+run_test "Test/MT/BinaryReverse_2Tapes_MT.txt" \
+         "Test/Strings/strings_binary.txt" \
+         "Test/Outputs/pipeline_reverse.out" \
+         "10. Pipeline: BinaryReverse -> BinaryReverse" \
+         "--pipeline Test/MT/BinaryReverse_2Tapes_MT.txt --output-mode trim"
+echo -e "${YELLOW}La segunda etapa invierte la salida de la primera (sin sus blancos): cada resultado es la cadena original, con los mismos pasos en las dos etapas${NC}"
+echo ""
+
+# 11. Motor de bloques con recorridos memorizados (--block-size)
+run_test "Test/MT/BinaryCounter_1Tape_MT.txt" \
+         "Test/Strings/strings_counter.txt" \
+         "Test/Outputs/counter_blocks.out" \
+         "11. Contador binario con --block-size 8 (1 cinta)" \
+         "--block-size 8 --max-steps 1000000"
+echo -e "${YELLOW}Todas RECHAZADAS por límite de pasos; misma cinta final que sin --block-size${NC}"
+echo ""
+
+# 12. Ejecución planificada en cuantos de pasos (--schedule)
+run_test "Test/MT/BinaryReverse_2Tapes_MT.txt" \
+         "Test/Strings/strings_binary.txt" \
+         "Test/Outputs/binary_reverse_scheduled.out" \
+         "12. BinaryReverse con --schedule srf --quantum 1" \
+         "--schedule srf --quantum 1 --in-flight 4"
+echo -e "${YELLOW}Mismo resultado que el test 3 (BinaryReverse_2Tapes_MT.txt)${NC}"
+echo ""
+
+# 13. Cadenas deterministas fusionadas en superinstrucciones (--fuse-chains)
+run_test "Test/MT/Shift_Chains_2Tapes_MT.txt" \
+         "Test/Strings/strings_shift.txt" \
+         "Test/Outputs/shift_fused.out" \
+         "13. Desplazamiento de símbolos con --fuse-chains" \
+         "--fuse-chains --output-tapes 0,1"
+echo -e "${YELLOW}Esperado: ACEPTADAS salvo la última (supera el límite de 50 pasos); la cinta 1 copia la entrada${NC}"
+echo ""
+
+# 14. Varias MT sobre varios ficheros de cadenas en una sola ejecución (--matrix)
+run_test "Test/MT/Ejemplo_MT.txt" \
+         "Test/Strings/strings_binary.txt" \
+         "Test/Outputs/matrix.out" \
+         "14. Matriz Ejemplo/BinaryReverse/Copy x cadenas binarias y de copia" \
+         "--matrix Test/MT/BinaryReverse_2Tapes_MT.txt,Test/MT/Copy_2Tapes_MT.txt --matrix-strings Test/Strings/strings_copy.txt --verdict-only"
+echo -e "${YELLOW}Una fila por cadena y una columna por MT, con el mismo veredicto que cada MT por separado${NC}"
+echo ""
+
+# 15. Prefijos comunes del lote simulados una sola vez (--prefix-sharing)
+run_test "Test/MT/BinaryReverse_2Tapes_MT.txt" \
+         "Test/Strings/strings_binary.txt" \
+         "Test/Outputs/binary_reverse_prefix.out" \
+         "15. BinaryReverse con --prefix-sharing" \
+         "--prefix-sharing"
+echo -e "${YELLOW}Mismo resultado que el test 3 (BinaryReverse_2Tapes_MT.txt)${NC}"
+echo ""
+
+# 16. Alfabeto grande: clases de símbolos en la búsqueda de transiciones
+run_test "Test/MT/Caesar_2Tapes_MT.txt" \
+         "Test/Strings/strings_caesar.txt" \
+         "Test/Outputs/caesar.out" \
+         "16. Cifrado César sobre 62 símbolos (2 cintas)" \
+         "--output-tapes 0,1"
+echo -e "${YELLOW}Esperado: todas ACEPTADAS; la cinta 1 es la entrada desplazada tres posiciones (a -> d, Z -> C, 8 -> 1)${NC}"
+echo ""
+
+# 17. Campeón por pasos de los castores afanosos de 3 estados (--busy-beaver 3)
+run_test "Test/MT/BusyBeaver_3x2_MT.txt" \
+         "Test/Strings/strings_blank.txt" \
+         "Test/Outputs/busy_beaver.out" \
+         "17. Castor afanoso de 3 estados sobre la cinta en blanco" \
+         "--max-steps 21"
+echo -e "${YELLOW}Esperado: ACEPTADA en 21 pasos -> Resultado: 11111 (con --max-steps 20, RECHAZADA)${NC}"
+echo ""
+
+# 18. Transiciones cargadas bajo demanda por estado (--lazy-load)
+run_test "Test/MT/Palindrome_3Tapes_MT.txt" \
+         "Test/Strings/strings_palindrome.txt" \
+         "Test/Outputs/palindrome_lazy.out" \
+         "18. Palindrome con --lazy-load" \
+         "--lazy-load"
+echo -e "${YELLOW}Mismo resultado que sin --lazy-load; la salida indica cuántos estados se han cargado${NC}"
+echo ""
+
+# 19. Cinta 0 alimentada poco a poco desde un fichero (--stream-tape)
+run_test "Test/MT/AStarBStar_1Tape_MT.txt" \
+         "Test/Strings/stream_astarb.txt" \
+         "Test/Outputs/astarb_stream.out" \
+         "19. a*b* con la entrada en streaming" \
+         "--stream-tape"
+echo -e "${YELLOW}Esperado: RECHAZADA en 6 pasos, al leer la 'a' que sigue a las b (con una FIFO, sin esperar al resto)${NC}"
+echo ""
+
+# 20. Operaciones nativas invocadas desde los estados (@copy, @rewind, @compare)
+run_test "Test/MT/Palindrome_Builtin_2Tapes_MT.txt" \
+         "Test/Strings/strings_palindrome.txt" \
+         "Test/Outputs/palindrome_builtin.out" \
+         "20. Palindrome con operaciones nativas" \
+         ""
+echo -e "${YELLOW}Mismo veredicto que Palindrome_3Tapes_MT.txt; los pasos son los de la misma MT escrita con transiciones${NC}"
+echo ""
+
+# 21. API C de la biblioteca con todos los motores que se eligen al cargar (make api-test)
+echo -e "${BLUE}21. API C: mismo lote con los motores normal, optimizado, compacto, perezoso y con fusión${NC}"
+echo "-----------------------------------"
+if make -s api-test > Test/Outputs/api.out 2>&1; then
+    ./tm-api-test >> Test/Outputs/api.out 2>&1
+fi
+cat Test/Outputs/api.out
+echo -e "${YELLOW}Esperado: API C: 95 comprobaciones, 0 fallos${NC}"
+echo ""
+
 echo "=========================================="
 echo "PRUEBAS COMPLETADAS"
 echo "=========================================="